@@ -11,5 +11,8 @@ public class GASCyberSoulsTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("GASCyberSouls");
+
+		// Attributes and enemy state replicate through the push model
+		bWithPushModel = true;
 	}
 }
@@ -8,6 +8,11 @@ public class GASCyberSouls : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "GameplayAbilities", "GameplayTags", "GameplayTasks", "UMG", "Slate", "SlateCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "GameplayAbilities", "GameplayTags", "GameplayTasks", "UMG", "Slate", "SlateCore", "NetCore", "ReplicationGraph", "NavigationSystem", "AIModule" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "RenderCore" });
+
+		// Set to 1 to bring back the per-event UE_LOG lines on combat hot paths (see Profiling/GASCombatEventLog.h)
+		PublicDefinitions.Add("CYBERSOULS_VERBOSE_COMBAT_LOG=0");
 	}
 }
@@ -2,6 +2,38 @@
 
 #include "GASCyberSouls.h"
 #include "Modules/ModuleManager.h"
+#include "Profiling/GASCombatEventLog.h"
+#include "Net/GASReplicationGraph.h"
+#include "Combat/GASCombatScratch.h"
+#include "Profiling/GASAllocationCounter.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, GASCyberSouls, "GASCyberSouls" );
- 
\ No newline at end of file
+class FGASCyberSoulsModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// Heap allocation counting for perf runs has to be in place before gameplay starts allocating
+		FGASAllocationCounter::InstallFromCommandLine();
+
+		// Start draining the binary combat log to disk
+		FGASCombatEventLog::Get().StartWriter();
+
+		// Frame-local arena for temporary combat query arrays
+		FGASCombatScratch::Startup();
+
+		// Game net drivers replicate through the project replication graph unless it is disabled
+		UReplicationDriver::CreateReplicationDriverDelegate().BindLambda([](UNetDriver* ForNetDriver, const FURL& URL, UWorld* World) -> UReplicationDriver*
+		{
+			return UGASReplicationGraph::ConditionalCreateReplicationDriver(ForNetDriver, World);
+		});
+	}
+
+	virtual void ShutdownModule() override
+	{
+		UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+		FGASCombatEventLog::Get().StopWriter();
+		FGASCombatScratch::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FGASCyberSoulsModule, GASCyberSouls, "GASCyberSouls" );
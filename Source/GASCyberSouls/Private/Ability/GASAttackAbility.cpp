@@ -3,13 +3,21 @@
 #include "Ability/GASAttackAbility.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
 #include "Attribute/GASAttributeSet.h"
 #include "Character/GASPlayerCharacter.h"
 #include "Game/GASGameplayTagsSetup.h"
 #include "GameplayTags.h"
 #include "Character/GASTargetingComponent.h"
+#include "Character/GASTypes.h"
 #include "Enemy/GASEnemyCharacter.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attack Activate"), STAT_CyberSouls_AttackActivate, STATGROUP_CyberSouls);
 
 UGASAttackAbility::UGASAttackAbility()
 {
@@ -18,6 +26,8 @@ UGASAttackAbility::UGASAttackAbility()
 	AttackRange = 200.0f;
 	AttackRadius = 50.0f;
 	CooldownTime = 1.0f;
+	bAwaitingEnemyOverlap = false;
+	CombatEventAbility = EGASCombatAbility::Attack;
 	
 	// Set the ability tags
 	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack")));
@@ -28,6 +38,8 @@ UGASAttackAbility::UGASAttackAbility()
 
 void UGASAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+	CYBERSOULS_SCOPED_STAT(AttackActivate);
+
 	// Call parent implementation
 	if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
 	{
@@ -36,26 +48,34 @@ void UGASAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	}
 	
 	// Apply damage
+	bAwaitingEnemyOverlap = false;
 	ApplyDamage();
 	
 	// Apply cooldown
 	if (CooldownTime > 0.0f)
 	{
+		LLM_SCOPE_BYTAG(CyberSouls_Effects);
 		UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("AttackCooldown")));
 		CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
 		CooldownEffect->DurationMagnitude = FScalableFloat(CooldownTime);
 		
 		// Add the cooldown tag to the effect
 		FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Ability.Attack.Cooldown")));
-		CooldownEffect->InheritableOwnedTagsContainer.AddTag(CooldownTag);
+		FInheritedTagContainer GrantedTags;
+		GrantedTags.AddTag(CooldownTag);
+		CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
 		
 		// Apply the cooldown effect
 		FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 		GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectToSelf(CooldownEffect, 1.0f, EffectContext);
+		FGASCombatTrace::Cooldown(this, CooldownTime);
 	}
 	
-	// End the ability
-	EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+	// End the ability, enemy attacks end once their overlap result arrives
+	if (!bAwaitingEnemyOverlap)
+	{
+		EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+	}
 }
 
 void UGASAttackAbility::ApplyDamage()
@@ -72,56 +92,12 @@ void UGASAttackAbility::ApplyDamage()
 	AGASEnemyCharacter* EnemyCharacter = Cast<AGASEnemyCharacter>(SourceActor);
 	if (EnemyCharacter)
 	{
-		// Find player in range
-		TArray<AActor*> OverlappingActors;
-		SourceActor->GetOverlappingActors(OverlappingActors, AGASCharacterBase::StaticClass());
-		
-		for (AActor* OverlappingActor : OverlappingActors)
-		{
-			// Skip self
-			if (OverlappingActor == SourceActor)
-			{
-				continue;
-			}
-			
-			// Check if it's the player
-			AGASCharacterBase* TargetCharacter = Cast<AGASCharacterBase>(OverlappingActor);
-			if (TargetCharacter && !Cast<AGASEnemyCharacter>(TargetCharacter))
-			{
-				// Check if in range
-				float Distance = FVector::Distance(SourceActor->GetActorLocation(), TargetCharacter->GetActorLocation());
-				if (Distance <= AttackRange)
-				{
-					// Apply damage to the player's Integrity
-					UE_LOG(LogTemp, Display, TEXT("Enemy attacking player, reducing Integrity by %f"), BaseDamage);
-					
-					// Get the player's ability system component
-					UAbilitySystemComponent* TargetASC = TargetCharacter->GetAbilitySystemComponent();
-					if (TargetASC)
-					{
-						// Create a gameplay effect for damage
-						UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("EnemyAttackDamage")));
-						DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
-						
-						// Add a modifier to reduce Integrity
-						int32 Idx = DamageEffect->Modifiers.Num();
-						DamageEffect->Modifiers.SetNum(Idx + 1);
-						FGameplayModifierInfo& ModifierInfo = DamageEffect->Modifiers[Idx];
-						
-						ModifierInfo.ModifierMagnitude = FScalableFloat(BaseDamage * -1); // Negative value to reduce attribute
-						ModifierInfo.ModifierOp = EGameplayModOp::Additive;
-						ModifierInfo.Attribute = UGASAttributeSet::GetIntegrityAttribute();
-						
-						// Apply the damage effect
-						FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
-						TargetASC->ApplyGameplayEffectToSelf(DamageEffect, 1.0f, EffectContext);
-					}
-					
-					// Only apply to the first valid target
-					break;
-				}
-			}
-		}
+		// Overlap on the combat channel instead of relying on overlap events, the result arrives next frame and ends the ability
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemyAttackOverlap), false, SourceActor);
+		FOverlapDelegate OverlapDelegate = FOverlapDelegate::CreateUObject(this, &UGASAttackAbility::OnEnemyAttackOverlap);
+		SourceActor->GetWorld()->AsyncOverlapByChannel(SourceActor->GetActorLocation(), FQuat::Identity, ECC_Combat,
+			FCollisionShape::MakeSphere(AttackRange), Params, FCollisionResponseParams::DefaultResponseParam, &OverlapDelegate);
+		bAwaitingEnemyOverlap = true;
 	}
 	else
 	{
@@ -161,9 +137,11 @@ void UGASAttackAbility::ApplyDamage()
 									if (AttributeSet && AttributeSet->GetBlockCharge() > 0.0f)
 									{
 										// Enemy blocks the attack
-										UE_LOG(LogTemp, Display, TEXT("Enemy blocked the attack to upper body!"));
+										CYBERSOULS_COMBAT_LOG(TEXT("Enemy blocked the attack to upper body!"));
+										RecordCombatEvent(EGASCombatOutcome::Blocked, TargetCharacter, TargetedBodyPart, 1.0f);
 										bAttackHits = false;
 										
+										LLM_SCOPE_BYTAG(CyberSouls_Effects);
 										// Reduce block charge
 										UGameplayEffect* BlockChargeEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("ReduceBlockCharge")));
 										BlockChargeEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -179,6 +157,7 @@ void UGASAttackAbility::ApplyDamage()
 										// Apply the block charge reduction
 										FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 										TargetASC->ApplyGameplayEffectToSelf(BlockChargeEffect, 1.0f, EffectContext);
+										FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, 1.0f);
 									}
 								}
 							}
@@ -197,9 +176,11 @@ void UGASAttackAbility::ApplyDamage()
 									if (AttributeSet && AttributeSet->GetDodgeCharge() > 0.0f)
 									{
 										// Enemy dodges the attack
-										UE_LOG(LogTemp, Display, TEXT("Enemy dodged the attack to lower body!"));
+										CYBERSOULS_COMBAT_LOG(TEXT("Enemy dodged the attack to lower body!"));
+										RecordCombatEvent(EGASCombatOutcome::Dodged, TargetCharacter, TargetedBodyPart, 1.0f);
 										bAttackHits = false;
 										
+										LLM_SCOPE_BYTAG(CyberSouls_Effects);
 										// Reduce dodge charge
 										UGameplayEffect* DodgeChargeEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("ReduceDodgeCharge")));
 										DodgeChargeEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -215,6 +196,7 @@ void UGASAttackAbility::ApplyDamage()
 										// Apply the dodge charge reduction
 										FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 										TargetASC->ApplyGameplayEffectToSelf(DodgeChargeEffect, 1.0f, EffectContext);
+										FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, 1.0f);
 									}
 								}
 							}
@@ -223,12 +205,14 @@ void UGASAttackAbility::ApplyDamage()
 						// Apply damage if the attack hits
 						if (bAttackHits)
 						{
-							UE_LOG(LogTemp, Display, TEXT("Player attacking enemy, reducing Health by %f"), BaseDamage);
+							CYBERSOULS_COMBAT_LOG(TEXT("Player attacking enemy, reducing Health by %f"), BaseDamage);
+							RecordCombatEvent(EGASCombatOutcome::Hit, TargetCharacter, TargetingComp->GetCurrentBodyPart(), BaseDamage);
 							
 							// Get the enemy's ability system component
 							UAbilitySystemComponent* TargetASC = TargetCharacter->GetAbilitySystemComponent();
 							if (TargetASC)
 							{
+								LLM_SCOPE_BYTAG(CyberSouls_Effects);
 								// Create a gameplay effect for damage
 								UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("PlayerAttackDamage")));
 								DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -245,19 +229,96 @@ void UGASAttackAbility::ApplyDamage()
 								// Apply the damage effect
 								FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 								TargetASC->ApplyGameplayEffectToSelf(DamageEffect, 1.0f, EffectContext);
+								FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, BaseDamage);
 							}
 						}
 					}
 					else
 					{
-						UE_LOG(LogTemp, Display, TEXT("Target out of range for attack"));
+						CYBERSOULS_COMBAT_LOG(TEXT("Target out of range for attack"));
+						RecordCombatEvent(EGASCombatOutcome::OutOfRange, TargetCharacter);
 					}
 				}
 			}
 			else
 			{
-				UE_LOG(LogTemp, Display, TEXT("No target selected for attack"));
+				CYBERSOULS_COMBAT_LOG(TEXT("No target selected for attack"));
+				RecordCombatEvent(EGASCombatOutcome::NoTarget);
 			}
 		}
 	}
 }
+
+void UGASAttackAbility::OnEnemyAttackOverlap(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum)
+{
+	// Cancelled while the query was in flight
+	if (!IsActive())
+	{
+		return;
+	}
+	
+	bAwaitingEnemyOverlap = false;
+	
+	AActor* SourceActor = GetAvatarActorFromActorInfo();
+	if (!SourceActor)
+	{
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+		return;
+	}
+	
+	// Find player in range
+	for (const FOverlapResult& Overlap : OverlapDatum.OutOverlaps)
+	{
+		AActor* OverlappingActor = Overlap.GetActor();
+		
+		// Skip self
+		if (OverlappingActor == SourceActor)
+		{
+			continue;
+		}
+		
+		// Check if it's the player
+		AGASCharacterBase* TargetCharacter = Cast<AGASCharacterBase>(OverlappingActor);
+		if (TargetCharacter && !Cast<AGASEnemyCharacter>(TargetCharacter))
+		{
+			// Check if in range
+			float Distance = FVector::Distance(SourceActor->GetActorLocation(), TargetCharacter->GetActorLocation());
+			if (Distance <= AttackRange)
+			{
+				// Apply damage to the player's Integrity
+				CYBERSOULS_COMBAT_LOG(TEXT("Enemy attacking player, reducing Integrity by %f"), BaseDamage);
+				RecordCombatEvent(EGASCombatOutcome::Hit, TargetCharacter, EBodyPartType::None, BaseDamage);
+				
+				// Get the player's ability system component
+				UAbilitySystemComponent* TargetASC = TargetCharacter->GetAbilitySystemComponent();
+				if (TargetASC)
+				{
+					LLM_SCOPE_BYTAG(CyberSouls_Effects);
+					// Create a gameplay effect for damage
+					UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("EnemyAttackDamage")));
+					DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+					
+					// Add a modifier to reduce Integrity
+					int32 Idx = DamageEffect->Modifiers.Num();
+					DamageEffect->Modifiers.SetNum(Idx + 1);
+					FGameplayModifierInfo& ModifierInfo = DamageEffect->Modifiers[Idx];
+					
+					ModifierInfo.ModifierMagnitude = FScalableFloat(BaseDamage * -1); // Negative value to reduce attribute
+					ModifierInfo.ModifierOp = EGameplayModOp::Additive;
+					ModifierInfo.Attribute = UGASAttributeSet::GetIntegrityAttribute();
+					
+					// Apply the damage effect
+					FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
+					TargetASC->ApplyGameplayEffectToSelf(DamageEffect, 1.0f, EffectContext);
+					FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, BaseDamage);
+				}
+				
+				// Only apply to the first valid target
+				break;
+			}
+		}
+	}
+	
+	// End the ability
+	EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+}
\ No newline at end of file
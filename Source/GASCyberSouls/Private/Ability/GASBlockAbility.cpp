@@ -3,13 +3,21 @@
 #include "Ability/GASBlockAbility.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Block Activate"), STAT_CyberSouls_BlockActivate, STATGROUP_CyberSouls);
+DECLARE_CYCLE_STAT(TEXT("Block End"), STAT_CyberSouls_BlockEnd, STATGROUP_CyberSouls);
 
 UGASBlockAbility::UGASBlockAbility()
 {
 	// Default values
 	BlockDuration = 2.0f;
 	CooldownTime = 3.0f;
+	CombatEventAbility = EGASCombatAbility::Block;
 	
 	// Set the ability tags
 	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Block")));
@@ -20,6 +28,8 @@ UGASBlockAbility::UGASBlockAbility()
 
 void UGASBlockAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+	CYBERSOULS_SCOPED_STAT(BlockActivate);
+
 	// Call parent implementation
 	if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
 	{
@@ -28,9 +38,7 @@ void UGASBlockAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	}
 	
 	// Add a gameplay tag to indicate blocking state
-	FGameplayTag BlockingTag = FGameplayTag::RequestGameplayTag(FName("State.Blocking"));
-	FGameplayTagContainer BlockingTagContainer;
-	BlockingTagContainer.AddTag(BlockingTag);
+	static const FGameplayTagContainer BlockingTagContainer(TAG_State_Blocking);
 	
 	GetAbilitySystemComponentFromActorInfo()->AddLooseGameplayTags(BlockingTagContainer);
 	
@@ -47,15 +55,15 @@ void UGASBlockAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	);
 	
 	// Play a montage or visual effect here
-	UE_LOG(LogTemp, Display, TEXT("Block ability activated"));
+	CYBERSOULS_COMBAT_LOG(TEXT("Block ability activated"));
 }
 
 void UGASBlockAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+	CYBERSOULS_SCOPED_STAT(BlockEnd);
+
 	// Remove the blocking tag
-	FGameplayTag BlockingTag = FGameplayTag::RequestGameplayTag(FName("State.Blocking"));
-	FGameplayTagContainer BlockingTagContainer;
-	BlockingTagContainer.AddTag(BlockingTag);
+	static const FGameplayTagContainer BlockingTagContainer(TAG_State_Blocking);
 	
 	if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
 	{
@@ -65,21 +73,25 @@ void UGASBlockAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
 	// Apply cooldown
 	if (!bWasCancelled && CooldownTime > 0.0f)
 	{
+		LLM_SCOPE_BYTAG(CyberSouls_Effects);
 		UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("BlockCooldown")));
 		CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
 		CooldownEffect->DurationMagnitude = FScalableFloat(CooldownTime);
 		
 		// Add the cooldown tag to the effect
 		FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Ability.Block.Cooldown")));
-		CooldownEffect->InheritableOwnedTagsContainer.AddTag(CooldownTag);
+		FInheritedTagContainer GrantedTags;
+		GrantedTags.AddTag(CooldownTag);
+		CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
 		
 		// Apply the cooldown effect
 		FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 		GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectToSelf(CooldownEffect, 1.0f, EffectContext);
+		FGASCombatTrace::Cooldown(this, CooldownTime);
 	}
 	
 	// Log the end of the ability
-	UE_LOG(LogTemp, Display, TEXT("Block ability ended"));
+	CYBERSOULS_COMBAT_LOG(TEXT("Block ability ended"));
 	
 	// Call parent implementation
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -3,15 +3,22 @@
 #include "Ability/GASDodgeAbility.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
+#include "Character/GASCharacterMovementComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Dodge Activate"), STAT_CyberSouls_DodgeActivate, STATGROUP_CyberSouls);
+DECLARE_CYCLE_STAT(TEXT("Dodge End"), STAT_CyberSouls_DodgeEnd, STATGROUP_CyberSouls);
 
 UGASDodgeAbility::UGASDodgeAbility()
 {
 	// Default values
-	DodgeDuration = 0.5f;
 	CooldownTime = 3.0f;
-	DodgeDistance = 300.0f;
+	DodgeEndGraceTime = 0.25f;
+	CombatEventAbility = EGASCombatAbility::Dodge;
 	
 	// Set the ability tags
 	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Dodge")));
@@ -22,6 +29,8 @@ UGASDodgeAbility::UGASDodgeAbility()
 
 void UGASDodgeAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+	CYBERSOULS_SCOPED_STAT(DodgeActivate);
+
 	// Call parent implementation
 	if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
 	{
@@ -47,7 +56,7 @@ void UGASDodgeAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 			
 			// Find nearest player to determine better dodge direction
 			APlayerController* PC = GetWorld()->GetFirstPlayerController();
-			if (PC && PC->GetPawn())
+			if (PC && PC->GetPawn() && PC->GetPawn() != Character)
 			{
 				FVector PlayerDirection = PC->GetPawn()->GetActorLocation() - Character->GetActorLocation();
 				PlayerDirection.Normalize();
@@ -62,29 +71,66 @@ void UGASDodgeAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 				}
 			}
 			
-			// Apply dodge impulse
-			Character->LaunchCharacter(DodgeDirection * DodgeDistance, true, true);
+			UGASCharacterMovementComponent* MovementComponent = Cast<UGASCharacterMovementComponent>(Character->GetCharacterMovement());
+			if (MovementComponent)
+			{
+				// Predicted root motion dodge. Only the controlling side requests it, the server gets the request with the move;
+				// players dodge along their input so both ends agree on the direction without sending it
+				if (ActorInfo->IsLocallyControlled())
+				{
+					MovementComponent->RequestDodge(Character->IsPlayerControlled() ? FVector::ZeroVector : DodgeDirection);
+				}
+				
+				DodgeFinishedHandle = MovementComponent->OnDodgeFinished().AddUObject(this, &UGASDodgeAbility::OnDodgeFinished);
+				DodgeMovementComponent = MovementComponent;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Dodge ability: %s has no GAS character movement component to dodge with"), *GetNameSafe(Character));
+			}
 			
 			// Play a montage or visual effect here
-			UE_LOG(LogTemp, Display, TEXT("Dodge ability activated"));
+			CYBERSOULS_COMBAT_LOG(TEXT("Dodge ability activated"));
 		}
 	}
 	
-	// Set a timer to end the ability after duration
-	FTimerHandle TimerHandle;
+	// Safety net in case the dodge move never runs here, e.g. the server already ran the client's dodge move before the activation arrived
+	const float EndDelay = DodgeMovementComponent.IsValid() ? DodgeMovementComponent->DodgeDuration + DodgeEndGraceTime : DodgeEndGraceTime;
+	
 	FTimerDelegate TimerDelegate;
 	TimerDelegate.BindUObject(this, &UGASDodgeAbility::EndAbility, Handle, ActorInfo, ActivationInfo, true, false);
 	
 	ActorInfo->AbilitySystemComponent->GetWorld()->GetTimerManager().SetTimer(
-		TimerHandle,
+		EndTimerHandle,
 		TimerDelegate,
-		DodgeDuration,
+		EndDelay,
 		false
 	);
 }
 
+void UGASDodgeAbility::OnDodgeFinished()
+{
+	if (IsActive())
+	{
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+	}
+}
+
 void UGASDodgeAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+	CYBERSOULS_SCOPED_STAT(DodgeEnd);
+
+	// Stop listening for the end of the dodge and drop the fallback timer, whichever ended the ability
+	if (DodgeMovementComponent.IsValid())
+	{
+		DodgeMovementComponent->OnDodgeFinished().Remove(DodgeFinishedHandle);
+		DodgeMovementComponent.Reset();
+	}
+	if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
+	{
+		ActorInfo->AbilitySystemComponent->GetWorld()->GetTimerManager().ClearTimer(EndTimerHandle);
+	}
+
 	// Remove the dodging tag
 	FGameplayTag DodgingTag = FGameplayTag::RequestGameplayTag(FName("State.Dodging"));
 	FGameplayTagContainer DodgingTagContainer;
@@ -98,21 +144,25 @@ void UGASDodgeAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
 	// Apply cooldown
 	if (!bWasCancelled && CooldownTime > 0.0f)
 	{
+		LLM_SCOPE_BYTAG(CyberSouls_Effects);
 		UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("DodgeCooldown")));
 		CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
 		CooldownEffect->DurationMagnitude = FScalableFloat(CooldownTime);
 		
 		// Add the cooldown tag to the effect
 		FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Ability.Dodge.Cooldown")));
-		CooldownEffect->InheritableOwnedTagsContainer.AddTag(CooldownTag);
+		FInheritedTagContainer GrantedTags;
+		GrantedTags.AddTag(CooldownTag);
+		CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
 		
 		// Apply the cooldown effect
 		FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 		GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectToSelf(CooldownEffect, 1.0f, EffectContext);
+		FGASCombatTrace::Cooldown(this, CooldownTime);
 	}
 	
 	// Log the end of the ability
-	UE_LOG(LogTemp, Display, TEXT("Dodge ability ended"));
+	CYBERSOULS_COMBAT_LOG(TEXT("Dodge ability ended"));
 	
 	// Call parent implementation
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
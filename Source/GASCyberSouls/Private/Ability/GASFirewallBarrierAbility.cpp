@@ -2,9 +2,11 @@
 
 #include "Ability/GASFirewallBarrierAbility.h"
 #include "AbilitySystemComponent.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
 #include "GameplayTagContainer.h"
 #include "Attribute/GASAttributeSet.h"
+#include "Profiling/GASMemoryReport.h"
 
 UGASFirewallBarrierAbility::UGASFirewallBarrierAbility()
 {
@@ -12,6 +14,7 @@ UGASFirewallBarrierAbility::UGASFirewallBarrierAbility()
     CastTime = 6.0f;  // As specified in Game.txt
     Cooldown = 12.0f; // As specified in Game.txt
     Duration = 3.0f;  // As specified in Game.txt
+    CombatEventAbility = EGASCombatAbility::FirewallBarrier;
     
     // Set the ability tags
     AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.FirewallBarrier")));
@@ -31,26 +34,32 @@ void UGASFirewallBarrierAbility::ApplyQuickHackEffect()
             UAbilitySystemComponent* SourceASC = SourceCharacter->GetAbilitySystemComponent();
             if (SourceASC)
             {
+                LLM_SCOPE_BYTAG(CyberSouls_Effects);
                 // Create a gameplay effect for the firewall barrier
                 UGameplayEffect* BarrierEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("FirewallBarrier")));
                 BarrierEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
                 BarrierEffect->DurationMagnitude = FScalableFloat(Duration);
                 
+                // Granted tags go through the target tags component, the deprecated inheritable container is only converted on load
+                FInheritedTagContainer GrantedTags;
+                
                 // Add the barrier tag to the effect
                 FGameplayTag BarrierTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.FirewallBarrier")));
-                BarrierEffect->InheritableOwnedTagsContainer.AddTag(BarrierTag);
+                GrantedTags.AddTag(BarrierTag);
                 
                 // Add a gameplay tag to prevent hack progress gain
                 FGameplayTag PreventHackProgressTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.PreventHackProgress")));
-                BarrierEffect->InheritableOwnedTagsContainer.AddTag(PreventHackProgressTag);
+                GrantedTags.AddTag(PreventHackProgressTag);
                 
                 // Add a gameplay tag to prevent being targeted by quickhacks
                 FGameplayTag ImmuneToQuickHacksTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.ImmuneToQuickHacks")));
-                BarrierEffect->InheritableOwnedTagsContainer.AddTag(ImmuneToQuickHacksTag);
+                GrantedTags.AddTag(ImmuneToQuickHacksTag);
+                BarrierEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
                 
                 // Apply the barrier effect to self
                 FGameplayEffectContextHandle EffectContext = SourceASC->MakeEffectContext();
                 SourceASC->ApplyGameplayEffectToSelf(BarrierEffect, 1.0f, EffectContext);
+                FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, Duration);
                 
                 // Prevent the character from initiating new quick hacks during the barrier
                 FGameplayTagContainer QuickHackTags;
@@ -5,6 +5,13 @@
 #include "GameplayEffect.h"
 #include "Character/GASCharacterBase.h"
 #include "Attribute/GASAttributeSet.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "Combat/GASVisibilitySubsystem.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hack Activate"), STAT_CyberSouls_HackActivate, STATGROUP_CyberSouls);
+DECLARE_CYCLE_STAT(TEXT("Hack End"), STAT_CyberSouls_HackEnd, STATGROUP_CyberSouls);
 
 UGASHackAbility::UGASHackAbility()
 {
@@ -12,6 +19,7 @@ UGASHackAbility::UGASHackAbility()
 	HackProgressPerSecond = 2.0f;
 	HackRange = 800.0f;
 	TickInterval = 1.0f;
+	CombatEventAbility = EGASCombatAbility::Hack;
 	
 	// Set the ability tags
 	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Hack")));
@@ -22,6 +30,8 @@ UGASHackAbility::UGASHackAbility()
 
 void UGASHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+	CYBERSOULS_SCOPED_STAT(HackActivate);
+
 	// Call parent implementation
 	if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
 	{
@@ -30,9 +40,7 @@ void UGASHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, c
 	}
 	
 	// Add a gameplay tag to indicate hacking state
-	FGameplayTag HackingTag = FGameplayTag::RequestGameplayTag(FName("State.Hacking"));
-	FGameplayTagContainer HackingTagContainer;
-	HackingTagContainer.AddTag(HackingTag);
+	static const FGameplayTagContainer HackingTagContainer(TAG_State_Hacking);
 	
 	GetAbilitySystemComponentFromActorInfo()->AddLooseGameplayTags(HackingTagContainer);
 	
@@ -53,11 +61,13 @@ void UGASHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, c
 	}
 	
 	// Play a montage or visual effect here
-	UE_LOG(LogTemp, Display, TEXT("Hack ability activated"));
+	CYBERSOULS_COMBAT_LOG(TEXT("Hack ability activated"));
 }
 
 void UGASHackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+	CYBERSOULS_SCOPED_STAT(HackEnd);
+
 	// Clear the timer
 	if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
 	{
@@ -69,9 +79,7 @@ void UGASHackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
 	}
 	
 	// Remove the hacking tag
-	FGameplayTag HackingTag = FGameplayTag::RequestGameplayTag(FName("State.Hacking"));
-	FGameplayTagContainer HackingTagContainer;
-	HackingTagContainer.AddTag(HackingTag);
+	static const FGameplayTagContainer HackingTagContainer(TAG_State_Hacking);
 	
 	if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
 	{
@@ -79,7 +87,7 @@ void UGASHackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
 	}
 	
 	// Log the end of the ability
-	UE_LOG(LogTemp, Display, TEXT("Hack ability ended"));
+	CYBERSOULS_COMBAT_LOG(TEXT("Hack ability ended"));
 	
 	// Call parent implementation
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -102,7 +110,15 @@ void UGASHackAbility::ApplyHackProgress()
 		
 		// Check if player is in range
 		float Distance = FVector::Distance(SourceActor->GetActorLocation(), PlayerPawn->GetActorLocation());
-		if (Distance <= HackRange)
+		
+		// Cover pauses the channel without ending it, line of sight comes from the shared visibility cache
+		UGASVisibilitySubsystem* Visibility = GetWorld()->GetSubsystem<UGASVisibilitySubsystem>();
+		if (Distance <= HackRange && Visibility && !Visibility->HasLineOfSight(SourceActor, PlayerPawn, true))
+		{
+			CYBERSOULS_COMBAT_LOG(TEXT("No line of sight to player, hack progress paused"));
+			RecordCombatEvent(EGASCombatOutcome::HackPrevented, PlayerPawn);
+		}
+		else if (Distance <= HackRange)
 		{
 			// Check if the player has the Gameplay Ability System component
 			AGASCharacterBase* PlayerCharacter = Cast<AGASCharacterBase>(PlayerPawn);
@@ -112,9 +128,9 @@ void UGASHackAbility::ApplyHackProgress()
 				if (PlayerASC)
 				{
 					// Check if player has the PreventHackProgress tag
-					FGameplayTag PreventHackProgressTag = FGameplayTag::RequestGameplayTag(FName("State.PreventHackProgress"));
-					if (!PlayerASC->HasMatchingGameplayTag(PreventHackProgressTag))
+					if (!PlayerASC->HasMatchingGameplayTag(TAG_State_PreventHackProgress))
 					{
+						LLM_SCOPE_BYTAG(CyberSouls_Effects);
 						// Create a gameplay effect to increase HackProgress
 						UGameplayEffect* HackEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("IncreaseHackProgress")));
 						HackEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -131,13 +147,16 @@ void UGASHackAbility::ApplyHackProgress()
 						// Apply the hack effect
 						FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 						PlayerASC->ApplyGameplayEffectToSelf(HackEffect, 1.0f, EffectContext);
+						FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, HackProgressPerSecond * TickInterval);
 						
 						// Log the hack progress
-						UE_LOG(LogTemp, Display, TEXT("Applying hack progress: %f"), HackProgressPerSecond * TickInterval);
+						CYBERSOULS_COMBAT_LOG(TEXT("Applying hack progress: %f"), HackProgressPerSecond * TickInterval);
+						RecordCombatEvent(EGASCombatOutcome::HackTick, PlayerCharacter, EBodyPartType::None, HackProgressPerSecond * TickInterval);
 					}
 					else
 					{
-						UE_LOG(LogTemp, Display, TEXT("Player is protected from hack progress"));
+						CYBERSOULS_COMBAT_LOG(TEXT("Player is protected from hack progress"));
+						RecordCombatEvent(EGASCombatOutcome::HackPrevented, PlayerCharacter);
 					}
 				}
 			}
@@ -145,7 +164,8 @@ void UGASHackAbility::ApplyHackProgress()
 		else
 		{
 			// Player out of range, end the ability
-			UE_LOG(LogTemp, Display, TEXT("Player out of range, ending hack ability"));
+			CYBERSOULS_COMBAT_LOG(TEXT("Player out of range, ending hack ability"));
+			RecordCombatEvent(EGASCombatOutcome::OutOfRange, PlayerPawn);
 			EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
 		}
 	}
@@ -2,8 +2,10 @@
 
 #include "Ability/GASInterruptProtocolAbility.h"
 #include "AbilitySystemComponent.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
 #include "GameplayTagContainer.h"
+#include "Profiling/GASMemoryReport.h"
 
 UGASInterruptProtocolAbility::UGASInterruptProtocolAbility()
 {
@@ -11,6 +13,7 @@ UGASInterruptProtocolAbility::UGASInterruptProtocolAbility()
     CastTime = 5.0f;  // As specified in Game.txt
     Cooldown = 8.0f;  // As specified in Game.txt
     Duration = 1.0f;  // Stun duration after interrupt
+    CombatEventAbility = EGASCombatAbility::InterruptProtocol;
     
     // Set the ability tags
     AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.InterruptProtocol")));
@@ -56,19 +59,23 @@ void UGASInterruptProtocolAbility::ApplyQuickHackEffect()
             QuickHackTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack")));
             TargetASC->CancelAbilities(&QuickHackTags);
             
+            LLM_SCOPE_BYTAG(CyberSouls_Effects);
             // Apply a stun effect to the target
             // Create a gameplay effect for the stun
             UGameplayEffect* StunEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("InterruptProtocolStun")));
             StunEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
             StunEffect->DurationMagnitude = FScalableFloat(Duration);
             
-            // Add the stun tag to the effect
+            // Add the stun tag to the effect, through the target tags component as for System Freeze
             FGameplayTag StunTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.Stunned")));
-            StunEffect->InheritableOwnedTagsContainer.AddTag(StunTag);
+            FInheritedTagContainer GrantedTags;
+            GrantedTags.AddTag(StunTag);
+            StunEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
             
             // Apply the stun effect to the target
             FGameplayEffectContextHandle EffectContext = TargetASC->MakeEffectContext();
             TargetASC->ApplyGameplayEffectToSelf(StunEffect, 1.0f, EffectContext);
+            FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, Duration);
         }
     }
 }
\ No newline at end of file
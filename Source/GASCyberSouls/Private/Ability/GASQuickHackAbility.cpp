@@ -4,7 +4,13 @@
 #include "AbilitySystemComponent.h"
 #include "Attribute/GASAttributeSet.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "GameFramework/Character.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("QuickHack Activate"), STAT_CyberSouls_QuickHackActivate, STATGROUP_CyberSouls);
+DECLARE_CYCLE_STAT(TEXT("QuickHack End"), STAT_CyberSouls_QuickHackEnd, STATGROUP_CyberSouls);
 
 UGASQuickHackAbility::UGASQuickHackAbility()
 {
@@ -24,6 +30,8 @@ UGASQuickHackAbility::UGASQuickHackAbility()
 
 void UGASQuickHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    CYBERSOULS_SCOPED_STAT(QuickHackActivate);
+
     // Call parent implementation
     if (!CommitAbility(Handle, ActorInfo, ActivationInfo))
     {
@@ -41,6 +49,7 @@ void UGASQuickHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Hand
     
     // Set the casting flag
     bIsCasting = true;
+    FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::CastStart, CastTime);
     
     // Start the casting timer
     if (CastTime > 0.0f)
@@ -70,6 +79,8 @@ void UGASQuickHackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Hand
 
 void UGASQuickHackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
+    CYBERSOULS_SCOPED_STAT(QuickHackEnd);
+
     // If we're still casting and were cancelled, call the interrupted function
     if (bIsCasting && bWasCancelled)
     {
@@ -95,6 +106,8 @@ void UGASQuickHackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, c
 
 void UGASQuickHackAbility::OnQuickHackSucceeded()
 {
+    FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::CastComplete);
+    
     // Apply the effect
     ApplyQuickHackEffect();
     
@@ -104,17 +117,21 @@ void UGASQuickHackAbility::OnQuickHackSucceeded()
     // Apply cooldown
     if (Cooldown > 0.0f)
     {
+        LLM_SCOPE_BYTAG(CyberSouls_Effects);
         UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("QuickHackCooldown")));
         CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
         CooldownEffect->DurationMagnitude = FScalableFloat(Cooldown);
         
         // Add the cooldown tag to the effect
         FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Ability.QuickHack.Cooldown")));
-        CooldownEffect->InheritableOwnedTagsContainer.AddTag(CooldownTag);
+        FInheritedTagContainer GrantedTags;
+        GrantedTags.AddTag(CooldownTag);
+        CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
         
         // Apply the cooldown effect
         FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
         GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectToSelf(CooldownEffect, 1.0f, EffectContext);
+        FGASCombatTrace::Cooldown(this, Cooldown);
     }
     
     // End the ability
@@ -128,6 +145,8 @@ void UGASQuickHackAbility::OnQuickHackInterrupted()
 {
     // Handle interruption (no effect applied)
     
+    FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::CastInterrupt);
+    
     // Reset casting flag
     bIsCasting = false;
     
@@ -142,7 +161,9 @@ void UGASQuickHackAbility::ApplyQuickHackEffect()
     if (CurrentActorInfo && CurrentActorInfo->AvatarActor.IsValid())
     {
         // Log the application of the quick hack
-        UE_LOG(LogTemp, Display, TEXT("QuickHack applied: %s"), *GetNameSafe(this));
+        CYBERSOULS_COMBAT_LOG(TEXT("QuickHack applied: %s"), *GetNameSafe(this));
+        RecordCombatEvent(EGASCombatOutcome::QuickHackApplied, nullptr, EBodyPartType::None, Duration);
+        FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, Duration);
     }
 }
 
@@ -3,13 +3,22 @@
 #include "Ability/GASSlashAbility.h"
 #include "AbilitySystemComponent.h"
 #include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
 #include "Character/GASPlayerCharacter.h"
 #include "Enemy/GASEnemyCharacter.h"
 #include "Attribute/GASAttributeSet.h"
 #include "Character/GASTargetingComponent.h"
+#include "Combat/GASHitZoneComponent.h"
 #include "Animation/AnimInstance.h"
+#include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "GameFramework/Character.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Slash Activate"), STAT_CyberSouls_SlashActivate, STATGROUP_CyberSouls);
 
 UGASSlashAbility::UGASSlashAbility()
 {
@@ -18,6 +27,9 @@ UGASSlashAbility::UGASSlashAbility()
 	BodyPartDamageMultiplier = 1.5f;
 	SlashRange = 250.0f;
 	CooldownTime = 0.8f;
+	MaxClientHitError = 50.0f;
+	bHasHitZone = false;
+	CombatEventAbility = EGASCombatAbility::Slash;
 	
 	// Set the ability tags
 	AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Slash")));
@@ -28,6 +40,8 @@ UGASSlashAbility::UGASSlashAbility()
 
 void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+	CYBERSOULS_SCOPED_STAT(SlashActivate);
+
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 	
 	// Call parent implementation
@@ -49,7 +63,8 @@ void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	UGASTargetingComponent* TargetingComp = PlayerCharacter->GetTargetingComponent();
 	if (!TargetingComp || !TargetingComp->HasTarget())
 	{
-		UE_LOG(LogTemp, Display, TEXT("No target for slash"));
+		CYBERSOULS_COMBAT_LOG(TEXT("No target for slash"));
+		RecordCombatEvent(EGASCombatOutcome::NoTarget);
 		EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
 		return;
 	}
@@ -61,7 +76,8 @@ void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 		float Distance = FVector::Distance(PlayerCharacter->GetActorLocation(), TargetCharacter->GetActorLocation());
 		if (Distance > SlashRange)
 		{
-			UE_LOG(LogTemp, Display, TEXT("Target out of range for slash"));
+			CYBERSOULS_COMBAT_LOG(TEXT("Target out of range for slash"));
+			RecordCombatEvent(EGASCombatOutcome::OutOfRange, TargetCharacter);
 			EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
 			return;
 		}
@@ -92,7 +108,7 @@ void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 			break;
 	}
 	
-	// Play the montage if available
+	// Play the montage if available, dedicated servers play it too so the hit windows on it run there
 	if (MontageToPlay)
 	{
 		ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -101,14 +117,29 @@ void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 			UAnimInstance* AnimInstance = Character->GetMesh()->GetAnimInstance();
 			if (AnimInstance)
 			{
-				// Set up a montage ended delegate to apply damage at the right time
-				FOnMontageEnded MontageEndedDelegate;
+				// Damage waits for a hit window on the montage to touch the target, a swing that ends without contact misses
+				UAbilityTask_WaitGameplayEvent* WaitHitTask = UAbilityTask_WaitGameplayEvent::WaitGameplayEvent(this, TAG_Event_Melee_Hit, nullptr, false, true);
+				WaitHitTask->EventReceived.AddDynamic(this, &UGASSlashAbility::OnMeleeHit);
+				WaitHitTask->ReadyForActivation();
 				
+				// The swing plays out after a hit ends the ability
+				UAbilityTask_PlayMontageAndWait* MontageTask = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
+					this, NAME_None, MontageToPlay, 1.0f, NAME_None, false);
+				MontageTask->OnCompleted.AddDynamic(this, &UGASSlashAbility::OnSlashMontageEnded);
+				MontageTask->OnBlendOut.AddDynamic(this, &UGASSlashAbility::OnSlashMontageEnded);
+				MontageTask->OnInterrupted.AddDynamic(this, &UGASSlashAbility::OnSlashMontageEnded);
+				MontageTask->OnCancelled.AddDynamic(this, &UGASSlashAbility::OnSlashMontageEnded);
+				MontageTask->ReadyForActivation();
 				
-				AnimInstance->Montage_Play(MontageToPlay, 1.0f);
-				AnimInstance->Montage_SetEndDelegate(MontageEndedDelegate, MontageToPlay);
+				// A remote player's own machine sweeps the windows and sends the contact, the server checks it against its own positions
+				if (!ActorInfo->IsLocallyControlled())
+				{
+					UAbilitySystemComponent* AbilitySystem = GetAbilitySystemComponentFromActorInfo();
+					AbilitySystem->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey()).AddUObject(this, &UGASSlashAbility::OnClientHitReceived);
+					AbilitySystem->CallReplicatedTargetDataDelegatesIfSet(Handle, ActivationInfo.GetActivationPredictionKey());
+				}
 				
-				UE_LOG(LogTemp, Display, TEXT("Playing slash montage for %s"), *UEnum::GetValueAsString(TargetedBodyPart));
+				CYBERSOULS_COMBAT_LOG(TEXT("Playing slash montage for %s"), *UEnum::GetValueAsString(TargetedBodyPart));
 			}
 			else
 			{
@@ -131,18 +162,107 @@ void UGASSlashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
 	// Apply cooldown
 	if (CooldownTime > 0.0f)
 	{
+		LLM_SCOPE_BYTAG(CyberSouls_Effects);
 		UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("SlashCooldown")));
 		CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
 		CooldownEffect->DurationMagnitude = FScalableFloat(CooldownTime);
 		
 		// Add the cooldown tag to the effect
 		FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName(TEXT("Ability.Slash.Cooldown")));
-		CooldownEffect->InheritableOwnedTagsContainer.AddTag(CooldownTag);
+		FInheritedTagContainer GrantedTags;
+		GrantedTags.AddTag(CooldownTag);
+		CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
 		
 		// Apply the cooldown effect
 		FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 		GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectToSelf(CooldownEffect, 1.0f, EffectContext);
+		FGASCombatTrace::Cooldown(this, CooldownTime);
+	}
+}
+
+void UGASSlashAbility::OnMeleeHit(FGameplayEventData Payload)
+{
+	// Only contact with the locked target counts, the blade passing through anyone else keeps the window open
+	const AGASPlayerCharacter* PlayerCharacter = Cast<AGASPlayerCharacter>(GetAvatarActorFromActorInfo());
+	const UGASTargetingComponent* TargetingComp = PlayerCharacter ? PlayerCharacter->GetTargetingComponent() : nullptr;
+	if (!TargetingComp || Payload.Target != TargetingComp->GetCurrentTarget())
+	{
+		return;
+	}
+	
+	// A predicting client only reports the contact, the server validates it and applies the damage
+	if (!HasAuthority(&CurrentActivationInfo))
+	{
+		UAbilitySystemComponent* AbilitySystem = GetAbilitySystemComponentFromActorInfo();
+		FScopedPredictionWindow ScopedPrediction(AbilitySystem, true);
+		AbilitySystem->ServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), Payload.TargetData, FGameplayTag(), AbilitySystem->ScopedPredictionKey);
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+		return;
+	}
+	
+	ResolveHitZone(Payload.Target, Payload.TargetData);
+	ApplySlashDamage();
+}
+
+void UGASSlashAbility::OnClientHitReceived(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayTag ApplicationTag)
+{
+	GetAbilitySystemComponentFromActorInfo()->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
+	
+	const FGameplayAbilityTargetData* Data = TargetData.Get(0);
+	const FHitResult* Hit = Data ? Data->GetHitResult() : nullptr;
+	if (!Hit || !IsValidClientHit(*Hit))
+	{
+		CYBERSOULS_COMBAT_LOG(TEXT("Rejected a slash hit reported by the client"));
+		RecordCombatEvent(EGASCombatOutcome::Missed, Hit ? Hit->GetActor() : nullptr);
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+		return;
+	}
+	
+	ResolveHitZone(Hit->GetActor(), TargetData);
+	ApplySlashDamage();
+}
+
+bool UGASSlashAbility::IsValidClientHit(const FHitResult& Hit) const
+{
+	// The contact has to be on the locked target and within reach of the blade as the server sees them
+	const AGASPlayerCharacter* PlayerCharacter = Cast<AGASPlayerCharacter>(GetAvatarActorFromActorInfo());
+	const UGASTargetingComponent* TargetingComp = PlayerCharacter ? PlayerCharacter->GetTargetingComponent() : nullptr;
+	const AGASCharacterBase* TargetCharacter = TargetingComp ? TargetingComp->GetCurrentTarget() : nullptr;
+	if (!TargetCharacter || Hit.GetActor() != TargetCharacter)
+	{
+		return false;
+	}
+	
+	if (FVector::Distance(PlayerCharacter->GetActorLocation(), Hit.ImpactPoint) > SlashRange + MaxClientHitError)
+	{
+		return false;
 	}
+	
+	return TargetCharacter->GetComponentsBoundingBox().ExpandBy(MaxClientHitError).IsInside(Hit.ImpactPoint);
+}
+
+void UGASSlashAbility::ResolveHitZone(const AActor* Target, const FGameplayAbilityTargetDataHandle& TargetData)
+{
+	// The zone the blade actually touched picks the body part and its multiplier
+	const FGameplayAbilityTargetData* Data = TargetData.Get(0);
+	const FHitResult* Hit = Data ? Data->GetHitResult() : nullptr;
+	UGASHitZoneComponent* HitZones = Target ? Target->FindComponentByClass<UGASHitZoneComponent>() : nullptr;
+	bHasHitZone = Hit && HitZones && HitZones->ResolveHit(*Hit, HitZone);
+}
+
+void UGASSlashAbility::OnSlashMontageEnded()
+{
+	// A hit already ended the ability, and on the server a remote player's own machine reports the hit or the miss
+	if (!IsActive() || !IsLocallyControlled())
+	{
+		return;
+	}
+	
+	CYBERSOULS_COMBAT_LOG(TEXT("Slash montage ended without touching the target"));
+	const AGASPlayerCharacter* PlayerCharacter = Cast<AGASPlayerCharacter>(GetAvatarActorFromActorInfo());
+	const UGASTargetingComponent* TargetingComp = PlayerCharacter ? PlayerCharacter->GetTargetingComponent() : nullptr;
+	RecordCombatEvent(EGASCombatOutcome::Missed, TargetingComp ? TargetingComp->GetCurrentTarget() : nullptr);
+	EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
 }
 
 void UGASSlashAbility::ApplySlashDamage()
@@ -159,14 +279,15 @@ void UGASSlashAbility::ApplySlashDamage()
 	UGASTargetingComponent* TargetingComp = PlayerCharacter->GetTargetingComponent();
 	if (!TargetingComp || !TargetingComp->HasTarget())
 	{
-		UE_LOG(LogTemp, Display, TEXT("No target for slash damage"));
+		CYBERSOULS_COMBAT_LOG(TEXT("No target for slash damage"));
+		RecordCombatEvent(EGASCombatOutcome::NoTarget);
 		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, true);
 		return;
 	}
 	
-	// Get the target and targeted body part
+	// Get the target and targeted body part, a resolved hit zone overrides the selection
 	AGASCharacterBase* TargetCharacter = TargetingComp->GetCurrentTarget();
-	EBodyPartType TargetedBodyPart = TargetingComp->GetCurrentBodyPart();
+	EBodyPartType TargetedBodyPart = bHasHitZone ? HitZone.BodyPart : TargetingComp->GetCurrentBodyPart();
 	
 	if (TargetCharacter)
 	{
@@ -192,9 +313,11 @@ void UGASSlashAbility::ApplySlashDamage()
 						if (AttributeSet && AttributeSet->GetBlockCharge() > 0.0f)
 						{
 							// Enemy blocks the attack
-							UE_LOG(LogTemp, Display, TEXT("Enemy blocked the slash to upper body!"));
+							CYBERSOULS_COMBAT_LOG(TEXT("Enemy blocked the slash to upper body!"));
+							RecordCombatEvent(EGASCombatOutcome::Blocked, TargetCharacter, TargetedBodyPart, 1.0f);
 							bAttackHits = false;
 							
+							LLM_SCOPE_BYTAG(CyberSouls_Effects);
 							// Reduce block charge
 							UGameplayEffect* BlockChargeEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("ReduceBlockCharge")));
 							BlockChargeEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -210,6 +333,7 @@ void UGASSlashAbility::ApplySlashDamage()
 							// Apply the block charge reduction
 							FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 							TargetASC->ApplyGameplayEffectToSelf(BlockChargeEffect, 1.0f, EffectContext);
+							FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, 1.0f);
 						}
 					}
 				}
@@ -228,9 +352,11 @@ void UGASSlashAbility::ApplySlashDamage()
 						if (AttributeSet && AttributeSet->GetDodgeCharge() > 0.0f)
 						{
 							// Enemy dodges the attack
-							UE_LOG(LogTemp, Display, TEXT("Enemy dodged the slash to lower body!"));
+							CYBERSOULS_COMBAT_LOG(TEXT("Enemy dodged the slash to lower body!"));
+							RecordCombatEvent(EGASCombatOutcome::Dodged, TargetCharacter, TargetedBodyPart, 1.0f);
 							bAttackHits = false;
 							
+							LLM_SCOPE_BYTAG(CyberSouls_Effects);
 							// Reduce dodge charge
 							UGameplayEffect* DodgeChargeEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("ReduceDodgeCharge")));
 							DodgeChargeEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -246,6 +372,7 @@ void UGASSlashAbility::ApplySlashDamage()
 							// Apply the dodge charge reduction
 							FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 							TargetASC->ApplyGameplayEffectToSelf(DodgeChargeEffect, 1.0f, EffectContext);
+							FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, 1.0f);
 						}
 					}
 				}
@@ -257,19 +384,25 @@ void UGASSlashAbility::ApplySlashDamage()
 				// Calculate damage based on body part
 				float FinalDamage = BaseDamage;
 				
-				// Apply bonus damage for specific body parts
-				if (TargetedBodyPart == EBodyPartType::LeftLeg || TargetedBodyPart == EBodyPartType::RightLeg)
+				// Apply bonus damage for specific body parts, per zone when the hit was resolved against hit zones
+				if (bHasHitZone)
+				{
+					FinalDamage *= HitZone.DamageMultiplier;
+				}
+				else if (TargetedBodyPart == EBodyPartType::LeftLeg || TargetedBodyPart == EBodyPartType::RightLeg)
 				{
 					FinalDamage *= BodyPartDamageMultiplier;
-					UE_LOG(LogTemp, Display, TEXT("Critical hit on leg! Damage increased to %f"), FinalDamage);
+					CYBERSOULS_COMBAT_LOG(TEXT("Critical hit on leg! Damage increased to %f"), FinalDamage);
 				}
 				
-				UE_LOG(LogTemp, Display, TEXT("Applying slash damage of %f to enemy"), FinalDamage);
+				CYBERSOULS_COMBAT_LOG(TEXT("Applying slash damage of %f to enemy"), FinalDamage);
+				RecordCombatEvent(EGASCombatOutcome::Hit, TargetCharacter, TargetedBodyPart, FinalDamage);
 				
 				// Get the enemy's ability system component
 				UAbilitySystemComponent* TargetASC = TargetCharacter->GetAbilitySystemComponent();
 				if (TargetASC)
 				{
+					LLM_SCOPE_BYTAG(CyberSouls_Effects);
 					// Create a gameplay effect for damage
 					UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("SlashDamage")));
 					DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
@@ -286,12 +419,14 @@ void UGASSlashAbility::ApplySlashDamage()
 					// Apply the damage effect
 					FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
 					TargetASC->ApplyGameplayEffectToSelf(DamageEffect, 1.0f, EffectContext);
+					FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, FinalDamage);
 				}
 			}
 		}
 		else
 		{
-			UE_LOG(LogTemp, Display, TEXT("Target out of range for slash damage"));
+			CYBERSOULS_COMBAT_LOG(TEXT("Target out of range for slash damage"));
+			RecordCombatEvent(EGASCombatOutcome::OutOfRange, TargetCharacter);
 		}
 	}
 	
@@ -2,9 +2,10 @@
 
 #include "Ability/GASSystemFreezeAbility.h"
 #include "AbilitySystemComponent.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "Character/GASCharacterBase.h"
 #include "GameplayTagContainer.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "Profiling/GASMemoryReport.h"
 
 UGASSystemFreezeAbility::UGASSystemFreezeAbility()
 {
@@ -12,6 +13,7 @@ UGASSystemFreezeAbility::UGASSystemFreezeAbility()
     CastTime = 7.0f;  // As specified in Game.txt
     Cooldown = 14.0f; // As specified in Game.txt
     Duration = 2.0f;  // As specified in Game.txt
+    CombatEventAbility = EGASCombatAbility::SystemFreeze;
     
     // Set the ability tags
     AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.SystemFreeze")));
@@ -51,48 +53,31 @@ void UGASSystemFreezeAbility::ApplyQuickHackEffect()
         UAbilitySystemComponent* TargetASC = TargetCharacter->GetAbilitySystemComponent();
         if (TargetASC)
         {
+            LLM_SCOPE_BYTAG(CyberSouls_Effects);
             // Create a gameplay effect for the freeze
             UGameplayEffect* FreezeEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("SystemFreeze")));
             FreezeEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
             FreezeEffect->DurationMagnitude = FScalableFloat(Duration);
             
+            // Granted tags go through the target tags component, the deprecated inheritable container is only converted on load
+            FInheritedTagContainer GrantedTags;
+            
             // Add the frozen tag to the effect
             FGameplayTag FrozenTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.Frozen")));
-            FreezeEffect->InheritableOwnedTagsContainer.AddTag(FrozenTag);
+            GrantedTags.AddTag(FrozenTag);
             
             // Prevent movement and ability activation during freeze
             FGameplayTag PreventMovementTag = FGameplayTag::RequestGameplayTag(FName(TEXT("State.PreventMovement")));
-            FreezeEffect->InheritableOwnedTagsContainer.AddTag(PreventMovementTag);
+            GrantedTags.AddTag(PreventMovementTag);
+            FreezeEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(GrantedTags);
             
             // Apply the freeze effect to the target
             FGameplayEffectContextHandle EffectContext = TargetASC->MakeEffectContext();
             TargetASC->ApplyGameplayEffectToSelf(FreezeEffect, 1.0f, EffectContext);
+            FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::EffectApplied, Duration);
             
-            // Directly freeze the movement component
-            UCharacterMovementComponent* MovementComp = TargetCharacter->GetCharacterMovement();
-            if (MovementComp)
-            {
-                // Store original max walk speed to restore later
-                float OriginalSpeed = MovementComp->MaxWalkSpeed;
-                
-                // Set speed to 0
-                MovementComp->MaxWalkSpeed = 0.0f;
-                
-                // Schedule restoration of original speed after duration
-                FTimerHandle UnfreezeTimerHandle;
-                FTimerDelegate UnfreezeDelegate;
-                UnfreezeDelegate.BindLambda([MovementComp, OriginalSpeed]()
-                {
-                    MovementComp->MaxWalkSpeed = OriginalSpeed;
-                });
-                
-                GetWorld()->GetTimerManager().SetTimer(
-                    UnfreezeTimerHandle,
-                    UnfreezeDelegate,
-                    Duration,
-                    false
-                );
-            }
+            // The frozen and prevent movement tags zero the target's max speed through its movement component's
+            // speed modifiers, predicted and restored with the effect instead of a timer
         }
     }
 }
\ No newline at end of file
@@ -4,7 +4,21 @@
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
 #include "Game/GASCyberSoulsHUD.h"
-#include "Kismet/GameplayStatics.h"
+#include "Game/GASHUDRegistry.h"
+#include "Profiling/GASStats.h"
+
+namespace GASAttributeSet
+{
+	// Drops in integrity and charges and rises in hack progress are the client-side view of hits, blocks, dodges and hack ticks
+	static void AddCombatText(const UGASAttributeSet* AttributeSet, EGASCombatOutcome Outcome, float Magnitude)
+	{
+		// The first values after relevance or dormancy are compared against stale client defaults, not a previous hit
+		if (Magnitude > 0.0f && !AttributeSet->IsReceivingInitialValues())
+		{
+			AGASCyberSoulsHUD::AddReplicatedCombatText(AttributeSet->GetOwningActor(), Outcome, Magnitude);
+		}
+	}
+}
 
 UGASAttributeSet::UGASAttributeSet()
 {
@@ -26,6 +40,8 @@ UGASAttributeSet::UGASAttributeSet()
 
 void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	CYBERSOULS_SCOPED_STAT(PostGameplayEffectExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
 	// Get the Target actor
@@ -56,15 +72,15 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 		}
 	}
 
-	
 	// Handle Integrity attribute changes
-	else if (Data.EvaluatedData.Attribute == GetIntegrityAttribute())
+	if (Data.EvaluatedData.Attribute == GetIntegrityAttribute())
 	{
 		// Clamp integrity to [0, MaxIntegrity]
 		SetIntegrity(FMath::Clamp(GetIntegrity(), 0.0f, GetMaxIntegrity()));
 		
 		// Update the HUD
-		AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+#if !UE_SERVER
+		AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 		if (HUD)
 		{
 			HUD->UpdateIntegrity(GetIntegrity(), GetMaxIntegrity());
@@ -76,6 +92,7 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 				UE_LOG(LogTemp, Warning, TEXT("INTEGRITY REACHED 0 - Player is dead!"));
 			}
 		}
+#endif
 	}
 	// Handle HackProgress attribute changes
 	else if (Data.EvaluatedData.Attribute == GetHackProgressAttribute())
@@ -84,7 +101,8 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 		SetHackProgress(FMath::Clamp(GetHackProgress(), 0.0f, GetMaxHackProgress()));
 		
 		// Update the HUD
-		AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+#if !UE_SERVER
+		AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 		if (HUD)
 		{
 			HUD->UpdateHackProgress(GetHackProgress(), GetMaxHackProgress());
@@ -106,6 +124,7 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 				HUD->SetHackProgressVisible(false);
 			}
 		}
+#endif
 	}
 	// Handle BlockCharge attribute changes
 	else if (Data.EvaluatedData.Attribute == GetBlockChargeAttribute())
@@ -130,25 +149,43 @@ void UGASAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 	}
 }
 
+void UGASAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	MARK_PROPERTY_DIRTY(this, Attribute.GetUProperty());
+}
+
+void UGASAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+
+	// The base value replicates too, even when active modifiers keep the current value unchanged
+	MARK_PROPERTY_DIRTY(const_cast<UGASAttributeSet*>(this), Attribute.GetUProperty());
+}
+
 void UGASAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	// Replicate health and stamina
+	// Push based: attributes are only compared when PostAttributeChange or an initter marked them dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
 	
 	// Replicate CyberSouls attributes
-	DOREPLIFETIME(UGASAttributeSet, Integrity);
-	DOREPLIFETIME(UGASAttributeSet, MaxIntegrity);
-	DOREPLIFETIME(UGASAttributeSet, HackProgress);
-	DOREPLIFETIME(UGASAttributeSet, MaxHackProgress);
-	DOREPLIFETIME(UGASAttributeSet, BlockCharge);
-	DOREPLIFETIME(UGASAttributeSet, MaxBlockCharge);
-	DOREPLIFETIME(UGASAttributeSet, DodgeCharge);
-	DOREPLIFETIME(UGASAttributeSet, MaxDodgeCharge);
-	DOREPLIFETIME(UGASAttributeSet, QuickHackProgress);
-	DOREPLIFETIME(UGASAttributeSet, AttackSpeed);
-	DOREPLIFETIME(UGASAttributeSet, SlashSpeed);
-	DOREPLIFETIME(UGASAttributeSet, QuickHackSpeed);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, Integrity, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, MaxIntegrity, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, HackProgress, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, MaxHackProgress, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, BlockCharge, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, MaxBlockCharge, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, DodgeCharge, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, MaxDodgeCharge, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, QuickHackProgress, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, AttackSpeed, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, SlashSpeed, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UGASAttributeSet, QuickHackSpeed, Params);
 }
 
 
@@ -157,8 +194,10 @@ void UGASAttributeSet::OnRep_Integrity(const FGameplayAttributeData& OldIntegrit
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, Integrity, OldIntegrity);
 	
+	GASAttributeSet::AddCombatText(this, EGASCombatOutcome::Hit, OldIntegrity.GetCurrentValue() - GetIntegrity());
+	
 	// Update the HUD when integrity changes on clients
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 	if (HUD)
 	{
 		HUD->UpdateIntegrity(GetIntegrity(), GetMaxIntegrity());
@@ -170,7 +209,7 @@ void UGASAttributeSet::OnRep_MaxIntegrity(const FGameplayAttributeData& OldMaxIn
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, MaxIntegrity, OldMaxIntegrity);
 	
 	// Update the HUD when max integrity changes on clients
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 	if (HUD)
 	{
 		HUD->UpdateIntegrity(GetIntegrity(), GetMaxIntegrity());
@@ -181,8 +220,10 @@ void UGASAttributeSet::OnRep_HackProgress(const FGameplayAttributeData& OldHackP
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, HackProgress, OldHackProgress);
 	
+	GASAttributeSet::AddCombatText(this, EGASCombatOutcome::HackTick, GetHackProgress() - OldHackProgress.GetCurrentValue());
+	
 	// Update the HUD when hack progress changes on clients
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 	if (HUD)
 	{
 		HUD->UpdateHackProgress(GetHackProgress(), GetMaxHackProgress());
@@ -204,7 +245,7 @@ void UGASAttributeSet::OnRep_MaxHackProgress(const FGameplayAttributeData& OldMa
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, MaxHackProgress, OldMaxHackProgress);
 	
 	// Update the HUD when max hack progress changes on clients
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwningActor());
 	if (HUD)
 	{
 		HUD->UpdateHackProgress(GetHackProgress(), GetMaxHackProgress());
@@ -214,6 +255,8 @@ void UGASAttributeSet::OnRep_MaxHackProgress(const FGameplayAttributeData& OldMa
 void UGASAttributeSet::OnRep_BlockCharge(const FGameplayAttributeData& OldBlockCharge)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, BlockCharge, OldBlockCharge);
+	
+	GASAttributeSet::AddCombatText(this, EGASCombatOutcome::Blocked, OldBlockCharge.GetCurrentValue() - GetBlockCharge());
 }
 
 void UGASAttributeSet::OnRep_MaxBlockCharge(const FGameplayAttributeData& OldMaxBlockCharge)
@@ -224,6 +267,8 @@ void UGASAttributeSet::OnRep_MaxBlockCharge(const FGameplayAttributeData& OldMax
 void UGASAttributeSet::OnRep_DodgeCharge(const FGameplayAttributeData& OldDodgeCharge)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGASAttributeSet, DodgeCharge, OldDodgeCharge);
+	
+	GASAttributeSet::AddCombatText(this, EGASCombatOutcome::Dodged, OldDodgeCharge.GetCurrentValue() - GetDodgeCharge());
 }
 
 void UGASAttributeSet::OnRep_MaxDodgeCharge(const FGameplayAttributeData& OldMaxDodgeCharge)
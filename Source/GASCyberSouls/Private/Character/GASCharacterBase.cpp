@@ -5,11 +5,16 @@
 
 #include "Character/GASCharacterBase.h"
 #include "AbilitySystemComponent.h"
-#include "AttributeSet.h"
+#include "Attribute/GASAttributeSet.h"
+#include "Character/GASCharacterMovementComponent.h"
 #include "GameplayAbilitySpec.h"
+#include "GameplayEffect.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
 
 // Sets default values
-AGASCharacterBase::AGASCharacterBase()
+AGASCharacterBase::AGASCharacterBase(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UGASCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	// Set this character to call Tick() every frame
 	PrimaryActorTick.bCanEverTick = true;
@@ -17,8 +22,11 @@ AGASCharacterBase::AGASCharacterBase()
 	// Create ability system component
 	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
 	
-	// Create attribute set
-	AttributeSet = CreateDefaultSubobject<UAttributeSet>(TEXT("AttributeSet"));
+	// Create attribute set, abilities look it up as UGASAttributeSet
+	{
+		LLM_SCOPE_BYTAG(CyberSouls_Attributes);
+		AttributeSet = CreateDefaultSubobject<UGASAttributeSet>(TEXT("AttributeSet"));
+	}
 }
 
 // Returns the ability system component
@@ -31,6 +39,29 @@ UAbilitySystemComponent* AGASCharacterBase::GetAbilitySystemComponent() const
 void AGASCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Count gameplay effect applications for stats and CSV captures
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &AGASCharacterBase::OnGameplayEffectAppliedToSelf);
+	}
+}
+
+// Called whenever a gameplay effect is applied to this character
+void AGASCharacterBase::OnGameplayEffectAppliedToSelf(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	CYBERSOULS_INC_COUNTER(GEApplications, 1);
+}
+
+// Called on clients when the actor channel opens, before the opening bunch's properties are applied
+void AGASCharacterBase::OnActorChannelOpen(FInBunch& InBunch, UNetConnection* Connection)
+{
+	Super::OnActorChannelOpen(InBunch, Connection);
+
+	if (UGASAttributeSet* GASAttributes = Cast<UGASAttributeSet>(AttributeSet))
+	{
+		GASAttributes->OnOwnerChannelOpened();
+	}
 }
 
 // Called to bind functionality to input
@@ -83,6 +114,9 @@ void AGASCharacterBase::AddStartingAbilities()
 		return;
 	}
 
+	// Instanced-per-actor abilities are created here
+	LLM_SCOPE_BYTAG(CyberSouls_Abilities);
+
 	// Grant abilities
 	for (TSubclassOf<UGameplayAbility>& StartingAbility : StartingAbilities)
 	{
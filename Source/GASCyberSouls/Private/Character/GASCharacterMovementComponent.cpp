@@ -0,0 +1,364 @@
+// copyright GASCyberSouls
+
+#include "Character/GASCharacterMovementComponent.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/RootMotionSource.h"
+#include "HAL/IConsoleManager.h"
+#include "Profiling/GASStats.h"
+#include "TimerManager.h"
+
+namespace GASCharacterMovement
+{
+	static const FName DodgeRootMotionName(TEXT("GASDodge"));
+
+	// Above montage root motion, a dodge always wins
+	static constexpr uint16 DodgeRootMotionPriority = 500;
+}
+
+// Saved move carrying the dodge request, so the server runs the dodge on the same move and replays repeat it
+class FGASSavedMove : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	FGASSavedMove()
+		: bSavedWantsToDodge(false)
+		, SavedSpeedMultiplier(1.0f)
+	{
+	}
+
+	virtual void Clear() override
+	{
+		Super::Clear();
+		bSavedWantsToDodge = false;
+		SavedSpeedMultiplier = 1.0f;
+	}
+
+	virtual uint8 GetCompressedFlags() const override
+	{
+		uint8 Flags = Super::GetCompressedFlags();
+		if (bSavedWantsToDodge)
+		{
+			Flags |= FLAG_Custom_0;
+		}
+		return Flags;
+	}
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override
+	{
+		// A combined move would drop the frame the dodge started on or the speed change
+		const FGASSavedMove* NewGASMove = static_cast<FGASSavedMove*>(NewMove.Get());
+		if (bSavedWantsToDodge != NewGASMove->bSavedWantsToDodge || SavedSpeedMultiplier != NewGASMove->SavedSpeedMultiplier)
+		{
+			return false;
+		}
+		return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+	}
+
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override
+	{
+		Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+		if (const UGASCharacterMovementComponent* MovementComponent = Cast<UGASCharacterMovementComponent>(C->GetCharacterMovement()))
+		{
+			bSavedWantsToDodge = MovementComponent->bWantsToDodge;
+			SavedSpeedMultiplier = MovementComponent->GetSpeedMultiplier();
+		}
+	}
+
+	virtual void PrepMoveFor(ACharacter* C) override
+	{
+		Super::PrepMoveFor(C);
+
+		if (UGASCharacterMovementComponent* MovementComponent = Cast<UGASCharacterMovementComponent>(C->GetCharacterMovement()))
+		{
+			MovementComponent->bWantsToDodge = bSavedWantsToDodge;
+			MovementComponent->ReplaySpeedMultiplier = SavedSpeedMultiplier;
+		}
+	}
+
+	uint8 bSavedWantsToDodge : 1;
+
+	// Speed the move was predicted with, a replay after a correction must not pick up a tag change from a later move
+	float SavedSpeedMultiplier;
+};
+
+class FGASNetworkPredictionData_Client : public FNetworkPredictionData_Client_Character
+{
+public:
+	explicit FGASNetworkPredictionData_Client(const UCharacterMovementComponent& ClientMovement)
+		: FNetworkPredictionData_Client_Character(ClientMovement)
+	{
+	}
+
+	virtual FSavedMovePtr AllocateNewMove() override
+	{
+		return FSavedMovePtr(new FGASSavedMove());
+	}
+};
+
+UGASCharacterMovementComponent::UGASCharacterMovementComponent()
+{
+	DodgeDistance = 300.0f;
+	DodgeDuration = 0.5f;
+	DodgeStrengthOverTime = nullptr;
+	bWantsToDodge = false;
+	PendingDodgeDirection = FVector::ZeroVector;
+	DodgeRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+	NumClientAdjustments = 0;
+	ReplaySpeedMultiplier = -1.0f;
+	CachedSpeedMultiplier = 1.0f;
+
+	// Frozen, stunned and rooted characters do not move, a slow is another entry with a multiplier below 1
+	SpeedModifiers.Add({ TAG_State_Frozen, 0.0f });
+	SpeedModifiers.Add({ TAG_State_PreventMovement, 0.0f });
+	SpeedModifiers.Add({ TAG_State_Stunned, 0.0f });
+}
+
+void UGASCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner());
+	if (!AbilitySystemComponent.IsValid())
+	{
+		return;
+	}
+
+	// Only tag changes recompute the multiplier, GetMaxSpeed runs several times per move
+	for (const FGASMovementSpeedModifier& Modifier : SpeedModifiers)
+	{
+		if (Modifier.Tag.IsValid())
+		{
+			AbilitySystemComponent->RegisterGameplayTagEvent(Modifier.Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &UGASCharacterMovementComponent::OnSpeedModifierTagChanged);
+		}
+	}
+
+	UpdateSpeedMultiplier();
+}
+
+void UGASCharacterMovementComponent::OnSpeedModifierTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	UpdateSpeedMultiplier();
+}
+
+void UGASCharacterMovementComponent::UpdateSpeedMultiplier()
+{
+	const UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
+
+	float Multiplier = 1.0f;
+	for (const FGASMovementSpeedModifier& Modifier : SpeedModifiers)
+	{
+		if (ASC && Modifier.Tag.IsValid() && ASC->HasMatchingGameplayTag(Modifier.Tag))
+		{
+			Multiplier *= FMath::Max(Modifier.Multiplier, 0.0f);
+		}
+	}
+
+	CachedSpeedMultiplier = Multiplier;
+}
+
+float UGASCharacterMovementComponent::GetSpeedMultiplier() const
+{
+	return ReplaySpeedMultiplier >= 0.0f ? ReplaySpeedMultiplier : CachedSpeedMultiplier;
+}
+
+float UGASCharacterMovementComponent::GetMaxSpeed() const
+{
+	return Super::GetMaxSpeed() * GetSpeedMultiplier();
+}
+
+void UGASCharacterMovementComponent::RequestDodge(const FVector& Direction)
+{
+	bWantsToDodge = true;
+	PendingDodgeDirection = Direction.GetSafeNormal2D();
+}
+
+bool UGASCharacterMovementComponent::IsDodging() const
+{
+	return DodgeRootMotionSourceID != (uint16)ERootMotionSourceID::Invalid;
+}
+
+void UGASCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToDodge = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+}
+
+FNetworkPredictionData_Client* UGASCharacterMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		UGASCharacterMovementComponent* MutableThis = const_cast<UGASCharacterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FGASNetworkPredictionData_Client(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+bool UGASCharacterMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+	// Replays are over, new moves use the current tags again
+	ReplaySpeedMultiplier = -1.0f;
+	return bResult;
+}
+
+void UGASCharacterMovementComponent::ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, TOptional<FRotator> OptionalRotation)
+{
+	// Root motion corrections end up here as well
+	++NumClientAdjustments;
+	CYBERSOULS_INC_COUNTER(MovementCorrections, 1);
+
+	Super::ClientAdjustPosition_Implementation(TimeStamp, NewLoc, NewVel, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode, OptionalRotation);
+}
+
+void UGASCharacterMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	// The dodge overrides the velocity and would ignore the speed multiplier, a frozen or stunned character can't dodge
+	const bool bCanMove = GetSpeedMultiplier() > 0.0f;
+	if (IsDodging() && !bCanMove)
+	{
+		RemoveRootMotionSourceByID(DodgeRootMotionSourceID);
+		DodgeRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+		DodgeFinishedDelegate.Broadcast();
+	}
+
+	if (bWantsToDodge)
+	{
+		if (!IsDodging() && CharacterOwner && DodgeDuration > 0.0f && bCanMove)
+		{
+			StartDodge();
+		}
+		bWantsToDodge = false;
+	}
+}
+
+void UGASCharacterMovementComponent::StartDodge()
+{
+	// The server sees the client's acceleration for this move, so both ends pick the same direction
+	FVector Direction = PendingDodgeDirection;
+	if (Direction.IsNearlyZero())
+	{
+		Direction = Acceleration.GetSafeNormal2D();
+	}
+	if (Direction.IsNearlyZero())
+	{
+		Direction = -CharacterOwner->GetActorForwardVector().GetSafeNormal2D();
+	}
+	PendingDodgeDirection = FVector::ZeroVector;
+
+	TSharedPtr<FRootMotionSource_ConstantForce> DodgeForce = MakeShared<FRootMotionSource_ConstantForce>();
+	DodgeForce->InstanceName = GASCharacterMovement::DodgeRootMotionName;
+	DodgeForce->AccumulateMode = ERootMotionAccumulateMode::Override;
+	DodgeForce->Priority = GASCharacterMovement::DodgeRootMotionPriority;
+	DodgeForce->Force = Direction * (DodgeDistance / DodgeDuration);
+	DodgeForce->Duration = DodgeDuration;
+	DodgeForce->StrengthOverTime = DodgeStrengthOverTime;
+	DodgeForce->FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::ClampVelocity;
+	DodgeForce->FinishVelocityParams.ClampVelocity = MaxWalkSpeed;
+
+	DodgeRootMotionSourceID = ApplyRootMotionSource(DodgeForce);
+}
+
+void UGASCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+
+	// Finished sources are removed while preparing root motion, the dodge is over once its source is gone
+	if (IsDodging() && !GetRootMotionSourceByID(DodgeRootMotionSourceID).IsValid())
+	{
+		DodgeRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+		DodgeFinishedDelegate.Broadcast();
+	}
+}
+
+#if !UE_SERVER
+namespace GASCharacterMovement
+{
+	struct FDodgeCorrectionTest
+	{
+		TWeakObjectPtr<UGASCharacterMovementComponent> MovementComponent;
+		FTimerHandle TimerHandle;
+		int32 NumDodges = 0;
+		int32 NumDone = 0;
+		int32 AdjustmentsAtDodgeStart = 0;
+		int32 TotalAdjustments = 0;
+		int32 MaxAdjustments = 0;
+	};
+
+	// Dodges the local pawn on a fixed interval and counts the server corrections of each dodge. Corrections are counted
+	// until the next dodge starts, so ones arriving a round trip late still belong to their dodge
+	static void RunDodgeCorrectionTest(const TArray<FString>& Args, UWorld* World)
+	{
+		const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		const ACharacter* Character = PC ? Cast<ACharacter>(PC->GetPawn()) : nullptr;
+		UGASCharacterMovementComponent* MovementComponent = Character ? Cast<UGASCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+		if (!MovementComponent)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Dodge correction test: the local pawn has no GAS character movement component"));
+			return;
+		}
+
+		if (Character->GetLocalRole() != ROLE_AutonomousProxy)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Dodge correction test: not a network client, no corrections will be received"));
+		}
+
+		TSharedRef<FDodgeCorrectionTest> Test = MakeShared<FDodgeCorrectionTest>();
+		Test->MovementComponent = MovementComponent;
+		Test->NumDodges = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 20;
+
+		const float Interval = MovementComponent->DodgeDuration + 0.5f;
+		UE_LOG(LogTemp, Display, TEXT("Dodge correction test: %d dodge(s), one every %.2fs"), Test->NumDodges, Interval);
+
+		FTimerManager& TimerManager = World->GetTimerManager();
+		TimerManager.SetTimer(Test->TimerHandle, FTimerDelegate::CreateLambda([Test, &TimerManager]()
+		{
+			UGASCharacterMovementComponent* Movement = Test->MovementComponent.Get();
+			if (!Movement)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Dodge correction test: pawn lost after %d dodge(s)"), Test->NumDone);
+				TimerManager.ClearTimer(Test->TimerHandle);
+				return;
+			}
+
+			if (Test->NumDone > 0)
+			{
+				const int32 Adjustments = Movement->GetNumClientAdjustments() - Test->AdjustmentsAtDodgeStart;
+				Test->TotalAdjustments += Adjustments;
+				Test->MaxAdjustments = FMath::Max(Test->MaxAdjustments, Adjustments);
+				UE_LOG(LogTemp, Display, TEXT("Dodge correction test: dodge %d, %d ClientAdjustPosition call(s)"), Test->NumDone, Adjustments);
+			}
+
+			if (Test->NumDone == Test->NumDodges)
+			{
+				UE_LOG(LogTemp, Display, TEXT("Dodge correction test: %d dodge(s), %d correction(s), %.2f per dodge, worst %d"),
+					Test->NumDone, Test->TotalAdjustments, static_cast<float>(Test->TotalAdjustments) / Test->NumDone, Test->MaxAdjustments);
+				TimerManager.ClearTimer(Test->TimerHandle);
+				return;
+			}
+
+			Test->AdjustmentsAtDodgeStart = Movement->GetNumClientAdjustments();
+			Movement->RequestDodge();
+			++Test->NumDone;
+		}), Interval, true);
+	}
+
+	// Run on a client, combine with NetEmulation.PktLag / PktLoss to see how the dodge holds up on a bad connection
+	static FAutoConsoleCommandWithWorldAndArgs DodgeCorrectionTestCommand(
+		TEXT("CyberSouls.Net.DodgeCorrectionTest"),
+		TEXT("Dodge the local pawn [Count] times and log the server movement corrections (ClientAdjustPosition) per dodge"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunDodgeCorrectionTest));
+}
+#endif
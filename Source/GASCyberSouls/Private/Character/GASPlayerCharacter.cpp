@@ -4,6 +4,7 @@
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -14,6 +15,8 @@
 #include "GAS/GASAbilitySystemComponent.h"
 #include "Character/GASTargetingComponent.h"
 #include "Character/GASTypes.h"
+#include "Profiling/GASCombatEventLog.h"
+#include "Profiling/GASMemoryReport.h"
 
 AGASPlayerCharacter::AGASPlayerCharacter()
 {
@@ -48,7 +51,10 @@ AGASPlayerCharacter::AGASPlayerCharacter()
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 	
 	// Create targeting component
-	TargetingComponent = CreateDefaultSubobject<UGASTargetingComponent>(TEXT("TargetingComponent"));
+	{
+		LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+		TargetingComponent = CreateDefaultSubobject<UGASTargetingComponent>(TEXT("TargetingComponent"));
+	}
 
 
 }
@@ -57,6 +63,12 @@ void AGASPlayerCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	// Dedicated servers advance montages and their notifies without refreshing bones, only the cosmetic pose is skipped
+	if (IsRunningDedicatedServer())
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	}
+	
 	// Add Input Mapping Context
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
@@ -181,7 +193,7 @@ void AGASPlayerCharacter::Attack(const FInputActionValue& Value)
 	// Here we can activate attack abilities through GAS
 	if (AbilitySystemComponent)
 	{
-		UE_LOG(LogTemp, Display, TEXT("Attack action triggered!"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Attack action triggered!"));
 		
 		// Try to activate the Slash ability
 		FGameplayTagContainer SlashTag;
@@ -201,7 +213,7 @@ void AGASPlayerCharacter::Dodge(const FInputActionValue& Value)
 	// Here we can activate dodge abilities through GAS
 	if (AbilitySystemComponent)
 	{
-		UE_LOG(LogTemp, Display, TEXT("Dodge action triggered!"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Dodge action triggered!"));
 		
 		// Try to activate the Dodge ability
 		FGameplayTagContainer DodgeTag;
@@ -223,18 +235,18 @@ void AGASPlayerCharacter::TargetLock(const FInputActionValue& Value)
 		if (TargetingComponent->HasTarget())
 		{
 			TargetingComponent->ReleaseTarget();
-			UE_LOG(LogTemp, Display, TEXT("Target released"));
+			CYBERSOULS_COMBAT_LOG(TEXT("Target released"));
 		}
 		else
 		{
 			bool bSuccess = TargetingComponent->LockOnTarget();
 			if (bSuccess)
 			{
-				UE_LOG(LogTemp, Display, TEXT("Target locked"));
+				CYBERSOULS_COMBAT_LOG(TEXT("Target locked"));
 			}
 			else
 			{
-				UE_LOG(LogTemp, Display, TEXT("No valid target found"));
+				CYBERSOULS_COMBAT_LOG(TEXT("No valid target found"));
 			}
 		}
 	}
@@ -245,7 +257,7 @@ void AGASPlayerCharacter::TargetLeft(const FInputActionValue& Value)
 	if (TargetingComponent && TargetingComponent->HasTarget())
 	{
 		TargetingComponent->CycleTargetLeft();
-		UE_LOG(LogTemp, Display, TEXT("Target cycled left"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Target cycled left"));
 	}
 }
 
@@ -254,7 +266,7 @@ void AGASPlayerCharacter::TargetRight(const FInputActionValue& Value)
 	if (TargetingComponent && TargetingComponent->HasTarget())
 	{
 		TargetingComponent->CycleTargetRight();
-		UE_LOG(LogTemp, Display, TEXT("Target cycled right"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Target cycled right"));
 	}
 }
 
@@ -267,7 +279,7 @@ void AGASPlayerCharacter::TargetPart(const FInputActionValue& Value)
 void AGASPlayerCharacter::QuickHack(const FInputActionValue& Value)
 {
 	// General QuickHack action, could open a UI menu or select a default hack
-	UE_LOG(LogTemp, Display, TEXT("QuickHack action triggered!"));
+	CYBERSOULS_COMBAT_LOG(TEXT("QuickHack action triggered!"));
 }
 
 void AGASPlayerCharacter::QuickHack1(const FInputActionValue& Value)
@@ -275,7 +287,7 @@ void AGASPlayerCharacter::QuickHack1(const FInputActionValue& Value)
 	// Interrupt Protocol
 	if (AbilitySystemComponent)
 	{
-		UE_LOG(LogTemp, Display, TEXT("Interrupt Protocol QuickHack triggered!"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Interrupt Protocol QuickHack triggered!"));
 		
 		// Try to activate the Interrupt Protocol ability
 		FGameplayTagContainer QuickHackTag;
@@ -295,7 +307,7 @@ void AGASPlayerCharacter::QuickHack2(const FInputActionValue& Value)
 	// System Freeze
 	if (AbilitySystemComponent)
 	{
-		UE_LOG(LogTemp, Display, TEXT("System Freeze QuickHack triggered!"));
+		CYBERSOULS_COMBAT_LOG(TEXT("System Freeze QuickHack triggered!"));
 		
 		// Try to activate the System Freeze ability
 		FGameplayTagContainer QuickHackTag;
@@ -315,7 +327,7 @@ void AGASPlayerCharacter::QuickHack3(const FInputActionValue& Value)
 	// Firewall Barrier
 	if (AbilitySystemComponent)
 	{
-		UE_LOG(LogTemp, Display, TEXT("Firewall Barrier QuickHack triggered!"));
+		CYBERSOULS_COMBAT_LOG(TEXT("Firewall Barrier QuickHack triggered!"));
 		
 		// Try to activate the Firewall Barrier ability
 		FGameplayTagContainer QuickHackTag;
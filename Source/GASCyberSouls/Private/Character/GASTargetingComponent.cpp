@@ -2,15 +2,25 @@
 
 #include "Character/GASTargetingComponent.h"
 #include "Character/GASCharacterBase.h"
+#include "Combat/GASCombatScratch.h"
+#include "Combat/GASVisibilitySubsystem.h"
 #include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASEnemyRegistry.h"
 #include "Game/GASCyberSoulsHUD.h"
-#include "Kismet/GameplayStatics.h"
+#include "Game/GASHUDRegistry.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "DrawDebugHelpers.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
 
 UGASTargetingComponent::UGASTargetingComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+	
+	// No replicated properties, but the lock-on RPC needs a replicated component
+	SetIsReplicatedByDefault(true);
+	
 	CurrentTarget = nullptr;
 	CurrentBodyPart = EBodyPartType::None;
 	MaxTargetingDistance = 1000.0f;
@@ -23,6 +33,17 @@ void UGASTargetingComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
+void UGASTargetingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AGASEnemyCharacter* Enemy = LockedEnemy.Get())
+	{
+		Enemy->SetTargetedBodyPart(EBodyPartType::None);
+	}
+	LockedEnemy.Reset();
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void UGASTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -33,7 +54,8 @@ void UGASTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 		FindTargetsInRange();
 	}
 	
-	// Debug drawing
+	// Debug drawing, compiled out of dedicated server builds
+#if !UE_SERVER
 	if (bDrawDebug && CurrentTarget)
 	{
 		// Draw a line to the current target
@@ -86,6 +108,7 @@ void UGASTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 			);
 		}
 	}
+#endif
 }
 
 bool UGASTargetingComponent::LockOnTarget()
@@ -105,13 +128,14 @@ bool UGASTargetingComponent::LockOnTarget()
 		CurrentBodyPart = EBodyPartType::UpperBody;
 		
 		// Update the HUD
-		AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+		AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 		if (HUD)
 		{
 			HUD->SetTargetingReticleVisible(true);
 			HUD->UpdateTargetingReticle(CurrentTarget, CurrentBodyPart);
 		}
 		
+		OnLockOnChanged();
 		return true;
 	}
 	
@@ -121,7 +145,7 @@ bool UGASTargetingComponent::LockOnTarget()
 void UGASTargetingComponent::ReleaseTarget()
 {
 	// Update the HUD
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 	if (HUD)
 	{
 		HUD->SetTargetingReticleVisible(false);
@@ -129,6 +153,61 @@ void UGASTargetingComponent::ReleaseTarget()
 	
 	CurrentTarget = nullptr;
 	CurrentBodyPart = EBodyPartType::None;
+	
+	OnLockOnChanged();
+}
+
+void UGASTargetingComponent::ServerSetLockOnTarget_Implementation(AGASCharacterBase* NewTarget, EBodyPartType NewBodyPart)
+{
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+	
+	// Targets the client could not have locked on to are ignored, with some slack for movement in flight
+	if (NewTarget && (NewTarget == Owner || FVector::Dist(NewTarget->GetActorLocation(), Owner->GetActorLocation()) > MaxTargetingDistance * 1.5f))
+	{
+		return;
+	}
+	
+	CurrentTarget = NewTarget;
+	CurrentBodyPart = NewTarget ? NewBodyPart : EBodyPartType::None;
+	
+	OnLockOnChanged();
+}
+
+void UGASTargetingComponent::OnLockOnChanged()
+{
+	const AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+	
+	if (Owner->GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		ServerSetLockOnTarget(CurrentTarget, CurrentBodyPart);
+		return;
+	}
+	
+	if (Owner->GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+	
+	// The targeted body part is what makes an enemy engaged, so it is set and cleared only here, where the lock is known
+	AGASEnemyCharacter* NewEnemy = Cast<AGASEnemyCharacter>(CurrentTarget);
+	AGASEnemyCharacter* PreviousEnemy = LockedEnemy.Get();
+	if (PreviousEnemy && PreviousEnemy != NewEnemy)
+	{
+		PreviousEnemy->SetTargetedBodyPart(EBodyPartType::None);
+	}
+	if (NewEnemy)
+	{
+		NewEnemy->SetTargetedBodyPart(CurrentBodyPart);
+	}
+	LockedEnemy = NewEnemy;
 }
 
 bool UGASTargetingComponent::CycleTargetLeft()
@@ -158,12 +237,13 @@ bool UGASTargetingComponent::CycleTargetLeft()
 	CurrentBodyPart = EBodyPartType::UpperBody; // Reset to upper body when changing targets
 	
 	// Update the HUD
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 	if (HUD)
 	{
 		HUD->UpdateTargetingReticle(CurrentTarget, CurrentBodyPart);
 	}
 	
+	OnLockOnChanged();
 	return true;
 }
 
@@ -194,12 +274,13 @@ bool UGASTargetingComponent::CycleTargetRight()
 	CurrentBodyPart = EBodyPartType::UpperBody; // Reset to upper body when changing targets
 	
 	// Update the HUD
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 	if (HUD)
 	{
 		HUD->UpdateTargetingReticle(CurrentTarget, CurrentBodyPart);
 	}
 	
+	OnLockOnChanged();
 	return true;
 }
 
@@ -213,12 +294,13 @@ bool UGASTargetingComponent::SetTargetBodyPart(EBodyPartType BodyPart)
 	CurrentBodyPart = BodyPart;
 	
 	// Update the HUD
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 	if (HUD)
 	{
 		HUD->UpdateTargetingReticle(CurrentTarget, CurrentBodyPart);
 	}
 	
+	OnLockOnChanged();
 	return true;
 }
 
@@ -255,18 +337,23 @@ bool UGASTargetingComponent::CycleBodyPart(float MouseY)
 	}
 	
 	// Update the HUD
-	AGASCyberSoulsHUD* HUD = AGASCyberSoulsHUD::GetInstance(GetWorld());
+	AGASCyberSoulsHUD* HUD = UGASHUDRegistry::FindHUDForActor(GetOwner());
 	if (HUD)
 	{
 		HUD->UpdateTargetingReticle(CurrentTarget, CurrentBodyPart);
 	}
 	
+	OnLockOnChanged();
 	return true;
 }
 
 void UGASTargetingComponent::FindTargetsInRange()
 {
-	PotentialTargets.Empty();
+	CYBERSOULS_SCOPED_STAT(FindTargetsInRange);
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	// Keep the capacity, the list is rebuilt every tick
+	PotentialTargets.Reset();
 	
 	AActor* Owner = GetOwner();
 	if (!Owner)
@@ -274,14 +361,34 @@ void UGASTargetingComponent::FindTargetsInRange()
 		return;
 	}
 	
-	// Get all characters in the world
-	TArray<AActor*> Characters;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGASCharacterBase::StaticClass(), Characters);
+	// Candidates are the registered enemies and the player pawns, gathered in frame scratch memory instead of an actor iterator
+	TGASScratchArray<AActor*> Characters;
+	if (UGASEnemyRegistry* Registry = UGASEnemyRegistry::Get(this))
+	{
+		const TArray<TObjectPtr<AGASEnemyCharacter>>& Enemies = Registry->GetEnemies();
+		Characters.Reserve(Enemies.Num() + GetWorld()->GetNumPlayerControllers());
+		for (AGASEnemyCharacter* Enemy : Enemies)
+		{
+			Characters.Add(Enemy);
+		}
+	}
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->GetPawn() && PC->GetPawn()->IsA<AGASCharacterBase>())
+		{
+			Characters.Add(PC->GetPawn());
+		}
+	}
+	CYBERSOULS_INC_COUNTER(TargetsScanned, Characters.Num());
 	
 	// Get owner location and forward vector
 	FVector OwnerLocation = Owner->GetActorLocation();
 	FVector OwnerForward = Owner->GetActorForwardVector();
 	
+	// Line of sight is only asked for characters that pass the cheap range and angle tests
+	UGASVisibilitySubsystem* Visibility = GetWorld()->GetSubsystem<UGASVisibilitySubsystem>();
+	
 	// Filter for valid targets within range and angle
 	for (AActor* Character : Characters)
 	{
@@ -302,7 +409,7 @@ void UGASTargetingComponent::FindTargetsInRange()
 			float DotProduct = FVector::DotProduct(OwnerForward, DirectionToTarget);
 			float AngleToTarget = FMath::Acos(DotProduct) * 180.0f / PI;
 			
-			if (AngleToTarget <= MaxTargetingAngle)
+			if (AngleToTarget <= MaxTargetingAngle && (!Visibility || Visibility->HasLineOfSight(Owner, Character)))
 			{
 				// Add to potential targets
 				AGASCharacterBase* TargetCharacter = Cast<AGASCharacterBase>(Character);
@@ -323,6 +430,8 @@ void UGASTargetingComponent::FindTargetsInRange()
 
 AGASCharacterBase* UGASTargetingComponent::FindBestTarget()
 {
+	CYBERSOULS_SCOPED_STAT(FindBestTarget);
+
 	if (PotentialTargets.Num() == 0)
 	{
 		return nullptr;
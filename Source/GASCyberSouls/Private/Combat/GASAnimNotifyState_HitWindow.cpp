@@ -0,0 +1,143 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASAnimNotifyState_HitWindow.h"
+#include "Combat/GASMeleeHitSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Profiling/GASStats.h"
+
+UGASAnimNotifyState_HitWindow::UGASAnimNotifyState_HitWindow()
+{
+	WeaponSocket = TEXT("weapon_r");
+	BladeStart = FVector::ZeroVector;
+	BladeEnd = FVector(100.0f, 0.0f, 0.0f);
+	BladeRadius = 10.0f;
+	MaxSubstepDistance = 25.0f;
+	MaxSubsteps = 8;
+	TraceChannel = ECC_Combat;
+}
+
+bool UGASAnimNotifyState_HitWindow::ShouldSweep(const USkeletalMeshComponent* MeshComp)
+{
+	const UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
+	if (!World || !World->IsGameWorld())
+	{
+		return false;
+	}
+
+	// A remote player's swing is swept on their own machine and sent to the server as target data
+	const AActor* Owner = MeshComp->GetOwner();
+	const APawn* Pawn = Cast<APawn>(Owner);
+	if (Pawn && Pawn->IsPlayerControlled())
+	{
+		return Pawn->IsLocallyControlled();
+	}
+	return Owner && Owner->HasAuthority();
+}
+
+UGASMeleeHitSubsystem* UGASAnimNotifyState_HitWindow::GetMeleeHits(const USkeletalMeshComponent* MeshComp)
+{
+	const UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASMeleeHitSubsystem>() : nullptr;
+}
+
+void UGASAnimNotifyState_HitWindow::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	UGASMeleeHitSubsystem* MeleeHits = ShouldSweep(MeshComp) ? GetMeleeHits(MeshComp) : nullptr;
+	if (!MeleeHits)
+	{
+		return;
+	}
+
+	// The first tick sweeps from the pose the window opened with
+	FGASMeleeHitWindow& Window = MeleeHits->OpenWindow(MeshComp, this);
+	Window.LastSocketTransform = MeshComp->GetSocketTransform(WeaponSocket);
+}
+
+void UGASAnimNotifyState_HitWindow::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
+
+	UGASMeleeHitSubsystem* MeleeHits = GetMeleeHits(MeshComp);
+	FGASMeleeHitWindow* Window = MeleeHits ? MeleeHits->FindWindow(MeshComp, this) : nullptr;
+	if (!Window)
+	{
+		return;
+	}
+
+	CYBERSOULS_SCOPED_STAT(MeleeHitWindow);
+
+	const FTransform SocketTransform = MeshComp->GetSocketTransform(WeaponSocket);
+	SweepBlade(MeshComp, *MeleeHits, *Window, SocketTransform);
+	Window->LastSocketTransform = SocketTransform;
+}
+
+void UGASAnimNotifyState_HitWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	// A window cut short by a blend out still covers the last partial frame
+	UGASMeleeHitSubsystem* MeleeHits = GetMeleeHits(MeshComp);
+	if (FGASMeleeHitWindow* Window = MeleeHits ? MeleeHits->FindWindow(MeshComp, this) : nullptr)
+	{
+		CYBERSOULS_SCOPED_STAT(MeleeHitWindow);
+
+		SweepBlade(MeshComp, *MeleeHits, *Window, MeshComp->GetSocketTransform(WeaponSocket));
+		MeleeHits->CloseWindow(MeshComp, this);
+	}
+
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+}
+
+void UGASAnimNotifyState_HitWindow::SweepBlade(USkeletalMeshComponent* MeshComp, UGASMeleeHitSubsystem& MeleeHits, FGASMeleeHitWindow& Window, const FTransform& SocketTransform) const
+{
+	UWorld* World = MeshComp->GetWorld();
+	AActor* Owner = MeshComp->GetOwner();
+	if (!Owner)
+	{
+		return;
+	}
+
+	// The tip moves furthest, its travel decides how finely the frame is split
+	const float TipTravel = FVector::Dist(Window.LastSocketTransform.TransformPosition(BladeEnd), SocketTransform.TransformPosition(BladeEnd));
+	const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(TipTravel / FMath::Max(MaxSubstepDistance, 1.0f)), 1, FMath::Max(MaxSubsteps, 1));
+
+	const float BladeHalfLength = 0.5f * FVector::Dist(BladeStart, BladeEnd);
+	const FCollisionShape BladeShape = FCollisionShape::MakeCapsule(BladeRadius, BladeHalfLength + BladeRadius);
+	const FVector BladeCenter = 0.5f * (BladeStart + BladeEnd);
+	const FVector BladeAxis = (BladeEnd - BladeStart).GetSafeNormal();
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(MeleeHitWindow), false, Owner);
+	TArray<FHitResult> Hits;
+
+	FVector StepStart = Window.LastSocketTransform.TransformPosition(BladeCenter);
+	for (int32 Step = 1; Step <= NumSubsteps; ++Step)
+	{
+		// Sub-frame pose of the weapon, the capsule keeps the orientation of the end of each sub-step
+		FTransform StepTransform;
+		StepTransform.Blend(Window.LastSocketTransform, SocketTransform, static_cast<float>(Step) / NumSubsteps);
+
+		const FVector StepEnd = StepTransform.TransformPosition(BladeCenter);
+		const FQuat CapsuleRotation = FRotationMatrix::MakeFromZ(StepTransform.TransformVectorNoScale(BladeAxis)).ToQuat();
+
+		Hits.Reset();
+		World->SweepMultiByChannel(Hits, StepStart, StepEnd, CapsuleRotation, TraceChannel, BladeShape, Params);
+
+		for (const FHitResult& Hit : Hits)
+		{
+			AActor* Victim = Hit.GetActor();
+			if (!Victim || Window.HitActors.Contains(Victim))
+			{
+				continue;
+			}
+
+			Window.HitActors.Add(Victim);
+			MeleeHits.QueueHit({ Owner, Victim, Hit });
+		}
+
+		StepStart = StepEnd;
+	}
+
+	CYBERSOULS_INC_COUNTER(MeleeSweeps, NumSubsteps);
+}
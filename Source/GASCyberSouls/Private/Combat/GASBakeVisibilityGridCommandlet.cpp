@@ -0,0 +1,255 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASBakeVisibilityGridCommandlet.h"
+#include "Combat/GASVisibilityGrid.h"
+#include "Combat/GASVisibilityGridSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include <atomic>
+
+#if WITH_EDITOR
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+#include "WorldPartition/WorldPartition.h"
+#endif
+
+UGASBakeVisibilityGridCommandlet::UGASBakeVisibilityGridCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UGASBakeVisibilityGridCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Map;
+	if (!FParse::Value(*Params, TEXT("Map="), Map))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: -Map=<map package> is required"));
+		return 2;
+	}
+
+	float CellSize = 400.0f;
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	CellSize = FMath::Max(CellSize, 50.0f);
+
+	float Range = 3000.0f;
+	FParse::Value(*Params, TEXT("Range="), Range);
+
+	float RangeZ = 800.0f;
+	FParse::Value(*Params, TEXT("RangeZ="), RangeZ);
+
+	int32 MaxCells = 262144;
+	FParse::Value(*Params, TEXT("MaxCells="), MaxCells);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *Map, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: %s is not a map"), *Map);
+		return 2;
+	}
+
+	// Collision only, no rendering, navigation or gameplay
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+	World->InitWorld(UWorld::InitializationValues()
+		.InitializeScenes(false)
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreatePhysicsScene(true)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(true)
+		.SetTransactional(false)
+		.CreateFXSystem(false));
+	World->UpdateWorldComponents(true, false);
+
+	// Partitioned maps keep their actors in external packages that loading the map does not load, bring in all of them
+	TUniquePtr<FLoaderAdapterShape> LoadedRegion;
+	if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+	{
+		if (!WorldPartition->IsInitialized())
+		{
+			WorldPartition->Initialize(World, FTransform::Identity);
+		}
+
+		const FBox PartitionBounds = WorldPartition->GetEditorWorldBounds();
+		if (!PartitionBounds.IsValid)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: %s is partitioned but has no actor bounds to load"), *Map);
+			World->DestroyWorld(false);
+			World->RemoveFromRoot();
+			return 2;
+		}
+
+		LoadedRegion = MakeUnique<FLoaderAdapterShape>(World, PartitionBounds, TEXT("Visibility grid bake"));
+		LoadedRegion->Load();
+		World->UpdateWorldComponents(true, false);
+
+		UE_LOG(LogTemp, Display, TEXT("Visibility grid bake: %s is partitioned, loaded every actor within %s"), *Map, *PartitionBounds.ToString());
+	}
+
+	int32 ReturnCode = 2;
+	const FBox Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+	const FVector Size = Bounds.GetSize();
+	const FIntVector CellCounts(
+		FMath::Max(FMath::CeilToInt(Size.X / CellSize), 1),
+		FMath::Max(FMath::CeilToInt(Size.Y / CellSize), 1),
+		FMath::Max(FMath::CeilToInt(Size.Z / CellSize), 1));
+	const int64 NumCells = int64(CellCounts.X) * CellCounts.Y * CellCounts.Z;
+
+	if (!Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: %s has no level bounds"), *Map);
+	}
+	else if (NumCells > MaxCells)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: %lld cells is over -MaxCells=%d, raise -CellSize"), NumCells, MaxCells);
+	}
+	else
+	{
+		const FString PackageName = UGASVisibilityGrid::GetPackageNameForMap(GetDefault<UGASVisibilityGridSubsystem>()->GridDirectory, MapPackage->GetName());
+		UPackage* GridPackage = CreatePackage(*PackageName);
+		UGASVisibilityGrid* Grid = NewObject<UGASVisibilityGrid>(GridPackage, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone);
+		Grid->Reset(Bounds.Min, CellSize, CellCounts, FMath::CeilToInt(Range / CellSize), FMath::CeilToInt(RangeZ / CellSize));
+
+		UE_LOG(LogTemp, Display, TEXT("Visibility grid bake: %s, %d x %d x %d cells of %.0f, %d neighbours each"),
+			*Map, CellCounts.X, CellCounts.Y, CellCounts.Z, CellSize, Grid->GetNumNeighbours());
+
+		const double StartTime = FPlatformTime::Seconds();
+		const int64 NumTraces = BakeGrid(World, Grid);
+		Grid->Dilate();
+		const double BakeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		GridPackage->MarkPackageDirty();
+		const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GError;
+		if (UPackage::SavePackage(GridPackage, Grid, *Filename, SaveArgs))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Visibility grid bake: %lld traces in %.1fs, %lld KB saved to %s"),
+				NumTraces, BakeSeconds, static_cast<int64>(NumCells * Grid->WordsPerCell * sizeof(uint64) / 1024), *Filename);
+			ReturnCode = 0;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: failed to save %s"), *Filename);
+		}
+	}
+
+	if (LoadedRegion)
+	{
+		LoadedRegion->Unload();
+		LoadedRegion.Reset();
+	}
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	return ReturnCode;
+#else
+	UE_LOG(LogTemp, Error, TEXT("Visibility grid bake: needs an editor build to save the grid"));
+	return 2;
+#endif
+}
+
+#if WITH_EDITOR
+int64 UGASBakeVisibilityGridCommandlet::BakeGrid(UWorld* World, UGASVisibilityGrid* Grid)
+{
+	const FIntVector CellCounts = Grid->CellCounts;
+	const float CellSize = Grid->CellSize;
+
+	// Centre, corners and face centres in cell units, pulled in a little so rays do not start inside a wall on the cell boundary
+	const float Near = 0.02f;
+	const float Far = 0.98f;
+	TArray<FVector> Points = { FVector(0.5f) };
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		Points.Add(FVector(Corner & 1 ? Far : Near, Corner & 2 ? Far : Near, Corner & 4 ? Far : Near));
+	}
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		FVector Face(0.5f);
+		Face[Axis] = Near;
+		Points.Add(Face);
+		Face[Axis] = Far;
+		Points.Add(Face);
+	}
+
+	// Matching points of both cells first, parallel rays through an opening, then every point against the other centre
+	TArray<TPair<FVector, FVector>> Rays;
+	for (const FVector& Point : Points)
+	{
+		Rays.Emplace(Point, Point);
+	}
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		Rays.Emplace(Points[Index], Points[0]);
+		Rays.Emplace(Points[0], Points[Index]);
+	}
+
+	TArray<FIntVector> Offsets;
+	for (int32 Z = -Grid->RangeCellsZ; Z <= Grid->RangeCellsZ; ++Z)
+	{
+		for (int32 Y = -Grid->RangeCells; Y <= Grid->RangeCells; ++Y)
+		{
+			for (int32 X = -Grid->RangeCells; X <= Grid->RangeCells; ++X)
+			{
+				Offsets.Add(FIntVector(X, Y, Z));
+			}
+		}
+	}
+
+	// Only static geometry occludes, anything that moves is left to the runtime traces
+	const FCollisionObjectQueryParams StaticObjects(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BakeVisibilityGrid), false);
+	std::atomic<int64> NumTraces(0);
+
+	// Each cell only writes its own row, so cells bake in parallel without locks
+	ParallelFor(Grid->GetNumCells(), [&](int32 CellIndex)
+	{
+		const FIntVector Cell(CellIndex % CellCounts.X, (CellIndex / CellCounts.X) % CellCounts.Y, CellIndex / (CellCounts.X * CellCounts.Y));
+		const FVector CellMin = Grid->Origin + FVector(Cell) * CellSize;
+		int64 CellTraces = 0;
+
+		for (const FIntVector& Offset : Offsets)
+		{
+			const FIntVector Other = Cell + Offset;
+			if (Other.X < 0 || Other.Y < 0 || Other.Z < 0 || Other.X >= CellCounts.X || Other.Y >= CellCounts.Y || Other.Z >= CellCounts.Z)
+			{
+				continue;
+			}
+
+			const FVector OtherMin = Grid->Origin + FVector(Other) * CellSize;
+			bool bVisible = Offset == FIntVector::ZeroValue;
+
+			// Stops at the first ray that gets through, only blocked pairs pay for every ray
+			for (int32 Ray = 0; Ray < Rays.Num() && !bVisible; ++Ray)
+			{
+				const FVector Start = CellMin + CellSize * Rays[Ray].Key;
+				const FVector End = OtherMin + CellSize * Rays[Ray].Value;
+				bVisible = !World->LineTraceTestByObjectType(Start, End, StaticObjects, QueryParams);
+				++CellTraces;
+			}
+
+			if (bVisible)
+			{
+				Grid->SetVisible(CellIndex, Grid->GetNeighbourBit(Offset));
+			}
+		}
+
+		NumTraces += CellTraces;
+	});
+
+	return NumTraces;
+}
+#endif
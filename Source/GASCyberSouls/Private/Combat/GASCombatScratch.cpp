@@ -0,0 +1,150 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASCombatScratch.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/MemStack.h"
+#include "Profiling/GASAllocationCounter.h"
+#include "Profiling/GASStats.h"
+
+static TAutoConsoleVariable<bool> CVarCombatScratchAllocator(
+	TEXT("CyberSouls.Combat.ScratchAllocator"),
+	true,
+	TEXT("Serve temporary combat query arrays from the per-frame scratch arena instead of the heap"));
+
+namespace GASCombatScratch
+{
+	static FMemStackBase* Arena = nullptr;
+	static FDelegateHandle EndFrameHandle;
+
+	// Allocation report state, the arena is used during the first half of the frames and bypassed during the second
+	static int32 ReportFrames = 0;
+	static int32 ReportFrame = 0;
+	static uint64 LastAllocations = 0;
+	static uint64 TotalAllocations[2] = { 0, 0 };
+	static uint64 PeakAllocations[2] = { 0, 0 };
+	static bool bBypassArena = false;
+
+	static void LogAllocationReport()
+	{
+		const double Frames = ReportFrames;
+		UE_LOG(LogTemp, Display, TEXT("Combat scratch: heap allocations per frame over %d frames, arena avg %.1f peak %llu, heap avg %.1f peak %llu"),
+			ReportFrames,
+			TotalAllocations[0] / Frames, PeakAllocations[0],
+			TotalAllocations[1] / Frames, PeakAllocations[1]);
+	}
+
+	static void SampleAllocationReport()
+	{
+		const uint64 Allocations = FGASAllocationCounter::GetNumAllocations();
+		const uint64 FrameAllocations = Allocations - LastAllocations;
+		LastAllocations = Allocations;
+
+		// The first end of frame only sets the baseline
+		if (ReportFrame > 0)
+		{
+			const int32 Half = ReportFrame <= ReportFrames ? 0 : 1;
+			TotalAllocations[Half] += FrameAllocations;
+			PeakAllocations[Half] = FMath::Max(PeakAllocations[Half], FrameAllocations);
+		}
+
+		bBypassArena = ReportFrame >= ReportFrames;
+		if (ReportFrame++ == 2 * ReportFrames)
+		{
+			LogAllocationReport();
+			ReportFrames = 0;
+			bBypassArena = false;
+		}
+	}
+
+	static void OnEndFrame()
+	{
+		check(Arena);
+
+		if (ReportFrames > 0)
+		{
+			SampleAllocationReport();
+		}
+
+		// Pages go back to the engine's page pool, not the heap, so a steady frame costs no allocations at all
+		Arena->Flush();
+	}
+}
+
+void FGASCombatScratch::Startup()
+{
+	using namespace GASCombatScratch;
+
+	if (!Arena)
+	{
+		Arena = new FMemStackBase();
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&GASCombatScratch::OnEndFrame);
+	}
+}
+
+void FGASCombatScratch::Shutdown()
+{
+	using namespace GASCombatScratch;
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	delete Arena;
+	Arena = nullptr;
+}
+
+bool FGASCombatScratch::IsActive()
+{
+	return GASCombatScratch::Arena && !GASCombatScratch::bBypassArena && IsInGameThread() && CVarCombatScratchAllocator.GetValueOnGameThread();
+}
+
+void* FGASCombatScratch::Alloc(SIZE_T Size, uint32 Alignment)
+{
+	check(IsActive());
+
+	CYBERSOULS_INC_COUNTER(CombatScratchBytes, Size);
+
+	// PushBytes rounds a default alignment of 0 up to the arena's own minimum
+	return GASCombatScratch::Arena->PushBytes(Size, Alignment);
+}
+
+int64 FGASCombatScratch::GetBytesUsed()
+{
+	return GASCombatScratch::Arena ? GASCombatScratch::Arena->GetByteCount() : 0;
+}
+
+void FGASCombatScratch::StartAllocationReport(int32 NumFrames)
+{
+	using namespace GASCombatScratch;
+
+	check(IsInGameThread());
+
+	if (!Arena || ReportFrames > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Combat scratch: allocation report already running or arena not set up"));
+		return;
+	}
+
+	if (!FGASAllocationCounter::IsInstalled())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Combat scratch: heap allocations are not counted, start with -CyberSoulsCountAllocs"));
+		return;
+	}
+
+	ReportFrames = FMath::Max(NumFrames, 1);
+	ReportFrame = 0;
+	TotalAllocations[0] = TotalAllocations[1] = 0;
+	PeakAllocations[0] = PeakAllocations[1] = 0;
+	bBypassArena = false;
+
+	UE_LOG(LogTemp, Display, TEXT("Combat scratch: counting heap allocations for %d frames with the arena, then %d without"), ReportFrames, ReportFrames);
+}
+
+static FAutoConsoleCommand CombatScratchAllocsPerFrameCommand(
+	TEXT("CyberSouls.Memory.AllocsPerFrame"),
+	TEXT("Log average and peak heap allocations per frame with and without the combat scratch arena. Usage: CyberSouls.Memory.AllocsPerFrame [Frames]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 300;
+		FGASCombatScratch::StartAllocationReport(NumFrames);
+	}));
@@ -0,0 +1,196 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASHitZoneComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/HitResult.h"
+#include "GameFramework/Character.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+namespace GASHitZone
+{
+	// How far a hit probes into the character from its impact point on the capsule
+	static constexpr float ProbeDepth = 50.0f;
+}
+
+UGASHitZoneComponent::UGASHitZoneComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Mannequin bones, the rest of the skeleton inherits from these through its parents
+	BoneBodyParts.Add(TEXT("pelvis"), EBodyPartType::LowerBody);
+	BoneBodyParts.Add(TEXT("spine_01"), EBodyPartType::UpperBody);
+	BoneBodyParts.Add(TEXT("thigh_l"), EBodyPartType::LeftLeg);
+	BoneBodyParts.Add(TEXT("thigh_r"), EBodyPartType::RightLeg);
+
+	DamageMultipliers.Add(EBodyPartType::UpperBody, 1.0f);
+	DamageMultipliers.Add(EBodyPartType::LowerBody, 1.0f);
+	DamageMultipliers.Add(EBodyPartType::LeftLeg, 1.5f);
+	DamageMultipliers.Add(EBodyPartType::RightLeg, 1.5f);
+
+	WorldScale = 1.0f;
+	LastUpdateFrame = MAX_uint64;
+}
+
+void UGASHitZoneComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuildZones();
+}
+
+void UGASHitZoneComponent::BuildZones()
+{
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	Shapes.Reset();
+	WorldStarts.Reset();
+	WorldEnds.Reset();
+	LastUpdateFrame = MAX_uint64;
+
+	const ACharacter* Character = Cast<ACharacter>(GetOwner());
+	USkeletalMeshComponent* Mesh = Character ? Character->GetMesh() : nullptr;
+	const UPhysicsAsset* PhysicsAsset = Mesh ? Mesh->GetPhysicsAsset() : nullptr;
+	ZoneMesh = Mesh;
+	if (!PhysicsAsset)
+	{
+		return;
+	}
+
+	for (const USkeletalBodySetup* Body : PhysicsAsset->SkeletalBodySetups)
+	{
+		const int32 BoneIndex = Body ? Mesh->GetBoneIndex(Body->BoneName) : INDEX_NONE;
+		const EBodyPartType BodyPart = BoneIndex != INDEX_NONE ? FindBodyPart(Mesh, Body->BoneName) : EBodyPartType::None;
+		if (BodyPart == EBodyPartType::None)
+		{
+			continue;
+		}
+
+		for (const FKSphylElem& Sphyl : Body->AggGeom.SphylElems)
+		{
+			const FVector HalfAxis = Sphyl.Rotation.RotateVector(FVector(0.0f, 0.0f, 0.5f * Sphyl.Length));
+			Shapes.Add({ BoneIndex, Sphyl.Center - HalfAxis, Sphyl.Center + HalfAxis, Sphyl.Radius, BodyPart });
+		}
+
+		for (const FKSphereElem& Sphere : Body->AggGeom.SphereElems)
+		{
+			Shapes.Add({ BoneIndex, Sphere.Center, Sphere.Center, Sphere.Radius, BodyPart });
+		}
+
+		// Boxes become a capsule along their longest axis, as wide as the larger of the other two
+		for (const FKBoxElem& Box : Body->AggGeom.BoxElems)
+		{
+			const FVector HalfExtents = 0.5f * FVector(Box.X, Box.Y, Box.Z);
+			const int32 LongAxis = HalfExtents.X >= HalfExtents.Y && HalfExtents.X >= HalfExtents.Z ? 0 : HalfExtents.Y >= HalfExtents.Z ? 1 : 2;
+			const float Radius = FMath::Max(HalfExtents[(LongAxis + 1) % 3], HalfExtents[(LongAxis + 2) % 3]);
+
+			FVector Direction = FVector::ZeroVector;
+			Direction[LongAxis] = FMath::Max(HalfExtents[LongAxis] - Radius, 0.0);
+			const FVector HalfAxis = Box.Rotation.RotateVector(Direction);
+			Shapes.Add({ BoneIndex, Box.Center - HalfAxis, Box.Center + HalfAxis, Radius, BodyPart });
+		}
+	}
+
+	// Walk the bone transforms in order when updating
+	Shapes.Sort([](const FZoneShape& A, const FZoneShape& B) { return A.BoneIndex < B.BoneIndex; });
+	WorldStarts.SetNumUninitialized(Shapes.Num());
+	WorldEnds.SetNumUninitialized(Shapes.Num());
+}
+
+EBodyPartType UGASHitZoneComponent::FindBodyPart(const USkeletalMeshComponent* Mesh, FName BoneName) const
+{
+	while (BoneName != NAME_None)
+	{
+		if (const EBodyPartType* BodyPart = BoneBodyParts.Find(BoneName))
+		{
+			return *BodyPart;
+		}
+
+		BoneName = Mesh->GetParentBone(BoneName);
+	}
+
+	return EBodyPartType::None;
+}
+
+void UGASHitZoneComponent::UpdateZones()
+{
+	if (LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	CYBERSOULS_SCOPED_STAT(HitZoneUpdate);
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	USkeletalMeshComponent* Mesh = ZoneMesh.Get();
+	LastUpdateFrame = GFrameCounter;
+
+	// Meshes nobody renders, e.g. every mesh on a dedicated server, tick at most their pose and keep stale bones
+	if (!Mesh->bRecentlyRendered && Mesh->VisibilityBasedAnimTickOption != EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones)
+	{
+		Mesh->RefreshBoneTransforms();
+	}
+
+	const TArray<FTransform>& BoneTransforms = Mesh->GetComponentSpaceTransforms();
+	const FTransform& ComponentTransform = Mesh->GetComponentTransform();
+	WorldScale = ComponentTransform.GetMaximumAxisScale();
+
+	int32 CachedBoneIndex = INDEX_NONE;
+	FTransform BoneToWorld = ComponentTransform;
+	for (int32 Index = 0; Index < Shapes.Num(); ++Index)
+	{
+		const FZoneShape& Shape = Shapes[Index];
+		if (Shape.BoneIndex != CachedBoneIndex && BoneTransforms.IsValidIndex(Shape.BoneIndex))
+		{
+			CachedBoneIndex = Shape.BoneIndex;
+			BoneToWorld = BoneTransforms[Shape.BoneIndex] * ComponentTransform;
+		}
+
+		WorldStarts[Index] = BoneToWorld.TransformPosition(Shape.LocalStart);
+		WorldEnds[Index] = BoneToWorld.TransformPosition(Shape.LocalEnd);
+	}
+}
+
+bool UGASHitZoneComponent::ResolveHit(const FVector& Start, const FVector& End, FGASHitZoneResult& OutResult)
+{
+	if (Shapes.Num() == 0 || !ZoneMesh.IsValid())
+	{
+		return false;
+	}
+
+	UpdateZones();
+
+	// Closest capsule surface to the segment wins, zones the segment passes through score below zero
+	int32 BestIndex = INDEX_NONE;
+	float BestDistance = MAX_flt;
+	for (int32 Index = 0; Index < Shapes.Num(); ++Index)
+	{
+		FVector OnSegment;
+		FVector OnZone;
+		FMath::SegmentDistToSegmentSafe(Start, End, WorldStarts[Index], WorldEnds[Index], OnSegment, OnZone);
+
+		const float Distance = FVector::Dist(OnSegment, OnZone) - Shapes[Index].Radius * WorldScale;
+		if (Distance < BestDistance)
+		{
+			BestDistance = Distance;
+			BestIndex = Index;
+		}
+	}
+
+	OutResult.BodyPart = Shapes[BestIndex].BodyPart;
+	OutResult.DamageMultiplier = GetDamageMultiplier(OutResult.BodyPart);
+	return true;
+}
+
+bool UGASHitZoneComponent::ResolveHit(const FHitResult& Hit, FGASHitZoneResult& OutResult)
+{
+	return ResolveHit(Hit.ImpactPoint, Hit.ImpactPoint - Hit.ImpactNormal * GASHitZone::ProbeDepth, OutResult);
+}
+
+float UGASHitZoneComponent::GetDamageMultiplier(EBodyPartType BodyPart) const
+{
+	const float* Multiplier = DamageMultipliers.Find(BodyPart);
+	return Multiplier ? *Multiplier : 1.0f;
+}
@@ -0,0 +1,82 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASMeleeHitSubsystem.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "Profiling/GASStats.h"
+
+bool UGASMeleeHitSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGASMeleeHitSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASMeleeHitSubsystem, STATGROUP_Tickables);
+}
+
+void UGASMeleeHitSubsystem::QueueHit(FGASMeleeHit&& Hit)
+{
+	PendingHits.Enqueue(MoveTemp(Hit));
+}
+
+FGASMeleeHitWindow& UGASMeleeHitSubsystem::OpenWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify)
+{
+	FGASMeleeHitWindow& Window = OpenWindows.FindOrAdd(FWindowKey(Mesh, Notify));
+	Window.HitActors.Reset();
+	return Window;
+}
+
+FGASMeleeHitWindow* UGASMeleeHitSubsystem::FindWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify)
+{
+	return OpenWindows.Find(FWindowKey(Mesh, Notify));
+}
+
+void UGASMeleeHitSubsystem::CloseWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify)
+{
+	OpenWindows.Remove(FWindowKey(Mesh, Notify));
+}
+
+void UGASMeleeHitSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Meshes destroyed mid-window never reach NotifyEnd
+	for (auto It = OpenWindows.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (PendingHits.IsEmpty())
+	{
+		return;
+	}
+
+	CYBERSOULS_SCOPED_STAT(MeleeHitResolve);
+
+	FGASMeleeHit Hit;
+	while (PendingHits.Dequeue(Hit))
+	{
+		AActor* Instigator = Hit.Instigator.Get();
+		AActor* Victim = Hit.Victim.Get();
+
+		// Either side may have been destroyed since the sweep
+		if (!Instigator || !Victim)
+		{
+			continue;
+		}
+
+		FGameplayEventData Payload;
+		Payload.EventTag = TAG_Event_Melee_Hit;
+		Payload.Instigator = Instigator;
+		Payload.Target = Victim;
+		Payload.TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromHitResult(Hit.Hit);
+
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Instigator, TAG_Event_Melee_Hit, Payload);
+	}
+}
@@ -0,0 +1,166 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASVisibilityGrid.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "Serialization/Archive.h"
+
+namespace GASVisibilityGrid
+{
+	static void ForEachSetBit(const uint64* Row, int32 NumWords, TFunctionRef<void(int32)> Visit)
+	{
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			for (uint64 Remaining = Row[Word]; Remaining != 0; Remaining &= Remaining - 1)
+			{
+				Visit(Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Remaining)));
+			}
+		}
+	}
+
+	static void SetBit(uint64* Row, int32 Bit)
+	{
+		Row[Bit / 64] |= uint64(1) << (Bit % 64);
+	}
+}
+
+void UGASVisibilityGrid::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Bits.BulkSerialize(Ar);
+}
+
+FString UGASVisibilityGrid::GetPackageNameForMap(const FString& GridDirectory, const FString& MapPackageName)
+{
+	return FString::Printf(TEXT("%s/VG_%s"), *GridDirectory, *FPackageName::GetShortName(MapPackageName));
+}
+
+void UGASVisibilityGrid::Reset(const FVector& InOrigin, float InCellSize, const FIntVector& InCellCounts, int32 InRangeCells, int32 InRangeCellsZ)
+{
+	Origin = InOrigin;
+	CellSize = InCellSize;
+	CellCounts = InCellCounts;
+	RangeCells = InRangeCells;
+	RangeCellsZ = InRangeCellsZ;
+	WordsPerCell = FMath::DivideAndRoundUp(GetNumNeighbours(), 64);
+	BakeVersion = CurrentBakeVersion;
+
+	Bits.Reset();
+	Bits.SetNumZeroed(GetNumCells() * WordsPerCell);
+}
+
+bool UGASVisibilityGrid::IsValidGrid() const
+{
+	return CellSize > 0.0f && GetNumCells() > 0 && WordsPerCell > 0 && Bits.Num() == GetNumCells() * WordsPerCell && BakeVersion == CurrentBakeVersion;
+}
+
+bool UGASVisibilityGrid::GetCell(const FVector& Location, FIntVector& OutCell) const
+{
+	const FVector Local = (Location - Origin) / CellSize;
+	OutCell = FIntVector(FMath::FloorToInt(Local.X), FMath::FloorToInt(Local.Y), FMath::FloorToInt(Local.Z));
+
+	return OutCell.X >= 0 && OutCell.Y >= 0 && OutCell.Z >= 0
+		&& OutCell.X < CellCounts.X && OutCell.Y < CellCounts.Y && OutCell.Z < CellCounts.Z;
+}
+
+int32 UGASVisibilityGrid::GetNeighbourBit(const FIntVector& Offset) const
+{
+	const int32 Span = 2 * RangeCells + 1;
+	return ((Offset.Z + RangeCellsZ) * Span + (Offset.Y + RangeCells)) * Span + (Offset.X + RangeCells);
+}
+
+FIntVector UGASVisibilityGrid::GetNeighbourOffset(int32 NeighbourBit) const
+{
+	const int32 Span = 2 * RangeCells + 1;
+	return FIntVector(NeighbourBit % Span - RangeCells, (NeighbourBit / Span) % Span - RangeCells, NeighbourBit / (Span * Span) - RangeCellsZ);
+}
+
+bool UGASVisibilityGrid::IsInRange(const FIntVector& Offset) const
+{
+	return FMath::Abs(Offset.X) <= RangeCells && FMath::Abs(Offset.Y) <= RangeCells && FMath::Abs(Offset.Z) <= RangeCellsZ;
+}
+
+void UGASVisibilityGrid::SetVisible(int32 CellIndex, int32 NeighbourBit)
+{
+	GASVisibilityGrid::SetBit(&Bits[CellIndex * WordsPerCell], NeighbourBit);
+}
+
+void UGASVisibilityGrid::Dilate()
+{
+	using namespace GASVisibilityGrid;
+
+	TArray<FIntVector> Steps;
+	for (int32 Z = -1; Z <= 1; ++Z)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			for (int32 X = -1; X <= 1; ++X)
+			{
+				Steps.Add(FIntVector(X, Y, Z));
+			}
+		}
+	}
+
+	// Source side: a cell sees what the cells around it see, offset by the step between them. Each cell writes only its own row
+	TArray<uint64> SourceDilated;
+	SourceDilated.SetNumZeroed(Bits.Num());
+	ParallelFor(GetNumCells(), [this, &Steps, &SourceDilated](int32 CellIndex)
+	{
+		const FIntVector Cell(CellIndex % CellCounts.X, (CellIndex / CellCounts.X) % CellCounts.Y, CellIndex / (CellCounts.X * CellCounts.Y));
+		uint64* Row = &SourceDilated[CellIndex * WordsPerCell];
+		for (const FIntVector& Step : Steps)
+		{
+			const FIntVector From = Cell + Step;
+			if (From.X < 0 || From.Y < 0 || From.Z < 0 || From.X >= CellCounts.X || From.Y >= CellCounts.Y || From.Z >= CellCounts.Z)
+			{
+				continue;
+			}
+
+			ForEachSetBit(&Bits[GetCellIndex(From) * WordsPerCell], WordsPerCell, [this, Row, &Step](int32 Bit)
+			{
+				const FIntVector Offset = GetNeighbourOffset(Bit) + Step;
+				if (IsInRange(Offset))
+				{
+					SetBit(Row, GetNeighbourBit(Offset));
+				}
+			});
+		}
+	});
+
+	// Target side: every cell around a visible target
+	ParallelFor(GetNumCells(), [this, &Steps, &SourceDilated](int32 CellIndex)
+	{
+		uint64* Row = &Bits[CellIndex * WordsPerCell];
+		ForEachSetBit(&SourceDilated[CellIndex * WordsPerCell], WordsPerCell, [this, Row, &Steps](int32 Bit)
+		{
+			const FIntVector Offset = GetNeighbourOffset(Bit);
+			for (const FIntVector& Step : Steps)
+			{
+				if (IsInRange(Offset + Step))
+				{
+					SetBit(Row, GetNeighbourBit(Offset + Step));
+				}
+			}
+		});
+	});
+}
+
+bool UGASVisibilityGrid::IsPotentiallyVisible(const FVector& From, const FVector& To) const
+{
+	FIntVector FromCell;
+	FIntVector ToCell;
+	if (!GetCell(From, FromCell) || !GetCell(To, ToCell))
+	{
+		return true;
+	}
+
+	const FIntVector Offset = ToCell - FromCell;
+	if (!IsInRange(Offset))
+	{
+		return true;
+	}
+
+	const int32 NeighbourBit = GetNeighbourBit(Offset);
+	return (Bits[GetCellIndex(FromCell) * WordsPerCell + NeighbourBit / 64] >> (NeighbourBit % 64)) & 1;
+}
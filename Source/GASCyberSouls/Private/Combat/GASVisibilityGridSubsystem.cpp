@@ -0,0 +1,50 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASVisibilityGridSubsystem.h"
+#include "Combat/GASVisibilityGrid.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "Profiling/GASMemoryReport.h"
+
+UGASVisibilityGridSubsystem::UGASVisibilityGridSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASVisibilityGridSubsystem]
+	GridDirectory = TEXT("/Game/VisibilityGrids");
+}
+
+bool UGASVisibilityGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGASVisibilityGridSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	const FString MapPackageName = UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+	const FString PackageName = UGASVisibilityGrid::GetPackageNameForMap(GridDirectory, MapPackageName);
+
+	// Most maps have no grid, only look for one when the package exists
+	if (!FPackageName::DoesPackageExist(PackageName))
+	{
+		return;
+	}
+
+	const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+	UGASVisibilityGrid* LoadedGrid = LoadObject<UGASVisibilityGrid>(nullptr, *ObjectPath);
+	if (!LoadedGrid || !LoadedGrid->IsValidGrid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Visibility grid: %s is missing or does not match its layout, bake it again"), *ObjectPath);
+		return;
+	}
+
+	Grid = LoadedGrid;
+	UE_LOG(LogTemp, Display, TEXT("Visibility grid: %s loaded, %d cells of %.0f"), *ObjectPath, Grid->GetNumCells(), Grid->CellSize);
+}
+
+bool UGASVisibilityGridSubsystem::IsPotentiallyVisible(const FVector& From, const FVector& To) const
+{
+	return !Grid || Grid->IsPotentiallyVisible(From, To);
+}
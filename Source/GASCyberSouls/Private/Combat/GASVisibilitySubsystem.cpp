@@ -0,0 +1,183 @@
+// copyright GASCyberSouls
+
+#include "Combat/GASVisibilitySubsystem.h"
+#include "Combat/GASVisibilityGridSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+
+namespace GASVisibility
+{
+	// Seconds between two sweeps over the cache for unused pairs
+	static constexpr float EvictionInterval = 1.0f;
+}
+
+UGASVisibilitySubsystem::UGASVisibilitySubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASVisibilitySubsystem]
+	CacheLifetime = 0.25f;
+	InvalidateDistance = 50.0f;
+	MaxTracesPerFrame = 32;
+	EvictAfter = 2.0f;
+
+	NextTraceId = 0;
+	TimeUntilEviction = GASVisibility::EvictionInterval;
+}
+
+void UGASVisibilitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GridSubsystem = Collection.InitializeDependency<UGASVisibilityGridSubsystem>();
+	TraceDelegate.BindUObject(this, &UGASVisibilitySubsystem::OnTraceDone);
+}
+
+bool UGASVisibilitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGASVisibilitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASVisibilitySubsystem, STATGROUP_Tickables);
+}
+
+bool UGASVisibilitySubsystem::HasLineOfSight(const AActor* Source, const AActor* Target, bool bVisibleWhenUnknown)
+{
+	if (!Source || !Target)
+	{
+		return false;
+	}
+
+	// New cache entries and pending traces
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FVisibilityKey Key(Source, Target);
+
+	FVisibilityEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.LastQueryTime = Now;
+
+	const bool bStale = !Entry.bKnown
+		|| Now - Entry.TraceTime > CacheLifetime
+		|| FVector::DistSquared(Source->GetActorLocation(), Entry.SourceLocation) > FMath::Square(InvalidateDistance)
+		|| FVector::DistSquared(Target->GetActorLocation(), Entry.TargetLocation) > FMath::Square(InvalidateDistance);
+
+	// The baked grid settles pairs walled off by static geometry right away, without a trace
+	if (bStale && !Entry.bQueued && GridSubsystem && !GridSubsystem->IsPotentiallyVisible(Source->GetActorLocation(), Target->GetActorLocation()))
+	{
+		Entry.SourceLocation = Source->GetActorLocation();
+		Entry.TargetLocation = Target->GetActorLocation();
+		Entry.TraceTime = Now;
+		Entry.bVisible = false;
+		Entry.bKnown = true;
+		CYBERSOULS_INC_COUNTER(VisibilityGridRejects, 1);
+	}
+	else if (bStale && !Entry.bQueued)
+	{
+		Entry.Source = Source;
+		Entry.Target = Target;
+		Entry.bQueued = true;
+		PendingKeys.Add(Key);
+	}
+
+	return Entry.bKnown ? Entry.bVisible : bVisibleWhenUnknown;
+}
+
+void UGASVisibilitySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	LLM_SCOPE_BYTAG(CyberSouls_Targeting);
+
+	if (PendingKeys.Num() > 0)
+	{
+		IssueTraces();
+	}
+
+	TimeUntilEviction -= DeltaTime;
+	if (TimeUntilEviction <= 0.0f)
+	{
+		TimeUntilEviction = GASVisibility::EvictionInterval;
+		EvictUnusedEntries(GetWorld()->GetTimeSeconds());
+	}
+}
+
+void UGASVisibilitySubsystem::IssueTraces()
+{
+	CYBERSOULS_SCOPED_STAT(VisibilityTraces);
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+
+	// Oldest requests first, whatever is over the limit stays queued for the next frame
+	const int32 NumToIssue = FMath::Min(PendingKeys.Num(), MaxTracesPerFrame);
+	int32 NumIssued = 0;
+	for (int32 Index = 0; Index < NumToIssue; ++Index)
+	{
+		const FVisibilityKey& Key = PendingKeys[Index];
+		FVisibilityEntry* Entry = Entries.Find(Key);
+		if (!Entry)
+		{
+			continue;
+		}
+
+		const AActor* Source = Entry->Source.Get();
+		const AActor* Target = Entry->Target.Get();
+		if (!Source || !Target)
+		{
+			Entry->bQueued = false;
+			continue;
+		}
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		Source->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(VisibilityTrace), false, Source);
+		Params.AddIgnoredActor(Target);
+
+		Entry->SourceLocation = Source->GetActorLocation();
+		Entry->TargetLocation = Target->GetActorLocation();
+		Entry->TraceTime = Now;
+
+		const uint32 TraceId = NextTraceId++;
+		InFlightTraces.Add(TraceId, Key);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, EyeLocation, Entry->TargetLocation, ECC_Visibility, Params,
+			FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, TraceId);
+		++NumIssued;
+	}
+
+	PendingKeys.RemoveAt(0, NumToIssue, EAllowShrinking::No);
+	CYBERSOULS_INC_COUNTER(VisibilityTracesIssued, NumIssued);
+}
+
+void UGASVisibilitySubsystem::OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FVisibilityKey Key;
+	if (!InFlightTraces.RemoveAndCopyValue(TraceDatum.UserData, Key))
+	{
+		return;
+	}
+
+	// The pair may have been evicted while the trace was in flight
+	if (FVisibilityEntry* Entry = Entries.Find(Key))
+	{
+		Entry->bVisible = !(TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit);
+		Entry->bKnown = true;
+		Entry->bQueued = false;
+	}
+}
+
+void UGASVisibilitySubsystem::EvictUnusedEntries(double Now)
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const FVisibilityEntry& Entry = It.Value();
+		if (!Entry.bQueued && (Now - Entry.LastQueryTime > EvictAfter || !Entry.Source.IsValid() || !Entry.Target.IsValid()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
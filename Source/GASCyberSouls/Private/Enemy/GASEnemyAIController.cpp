@@ -0,0 +1,147 @@
+// copyright GASCyberSouls
+
+#include "Enemy/GASEnemyAIController.h"
+#include "Enemy/GASEnemyNavigationSubsystem.h"
+#include "Enemy/GASFlowFieldSubsystem.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "Navigation/PathFollowingComponent.h"
+
+AGASEnemyAIController::AGASEnemyAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCrowdFollowingComponent>(TEXT("PathFollowingComponent")))
+{
+	bPathRequestQueued = false;
+	ChaseAcceptanceRadius = 100.0f;
+	LastGoalLocation = FVector::ZeroVector;
+	LastPathRequestTime = -MAX_dbl;
+	Significance = EGASEnemySignificance::Off;
+	bSignificanceApplied = false;
+	bOnFlowField = false;
+}
+
+void AGASEnemyAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	if (UGASEnemyNavigationSubsystem* Navigation = GetWorld()->GetSubsystem<UGASEnemyNavigationSubsystem>())
+	{
+		Navigation->RegisterController(this);
+	}
+}
+
+void AGASEnemyAIController::OnUnPossess()
+{
+	if (UGASEnemyNavigationSubsystem* Navigation = GetWorld()->GetSubsystem<UGASEnemyNavigationSubsystem>())
+	{
+		Navigation->UnregisterController(this);
+	}
+
+	Super::OnUnPossess();
+}
+
+void AGASEnemyAIController::SetChaseTarget(AActor* NewTarget)
+{
+	if (ChaseTarget.Get() == NewTarget)
+	{
+		return;
+	}
+
+	ChaseTarget = NewTarget;
+
+	// A new target always gets a fresh path, no target means standing still
+	LastPathRequestTime = -MAX_dbl;
+	if (!NewTarget)
+	{
+		StopMovement();
+	}
+}
+
+void AGASEnemyAIController::ApplySignificance(EGASEnemySignificance NewSignificance, float AvoidanceQueryRange)
+{
+	if (bSignificanceApplied && Significance == NewSignificance)
+	{
+		return;
+	}
+
+	Significance = NewSignificance;
+	bSignificanceApplied = true;
+
+	UCrowdFollowingComponent* CrowdFollowing = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent());
+	if (!CrowdFollowing)
+	{
+		return;
+	}
+
+	if (NewSignificance == EGASEnemySignificance::Off)
+	{
+		CrowdFollowing->SetCrowdSimulationState(ECrowdSimulationState::ObstacleOnly);
+		return;
+	}
+
+	// Fewer neighbours and cheaper velocity sampling the further the enemy is from any player
+	const ECrowdAvoidanceQuality::Type Quality = NewSignificance == EGASEnemySignificance::High ? ECrowdAvoidanceQuality::High
+		: NewSignificance == EGASEnemySignificance::Medium ? ECrowdAvoidanceQuality::Medium
+		: ECrowdAvoidanceQuality::Low;
+
+	CrowdFollowing->SetCrowdSimulationState(ECrowdSimulationState::Enabled);
+	CrowdFollowing->SetCrowdAvoidanceQuality(Quality, false);
+	CrowdFollowing->SetCrowdCollisionQueryRange(AvoidanceQueryRange, true);
+}
+
+bool AGASEnemyAIController::WantsRepath(double Now, float RepathInterval, float RepathDistance) const
+{
+	const AActor* Target = ChaseTarget.Get();
+	if (!Target || bOnFlowField || bPathRequestQueued || Now - LastPathRequestTime < RepathInterval)
+	{
+		return false;
+	}
+
+	return GetMoveStatus() == EPathFollowingStatus::Idle
+		|| FVector::DistSquared(Target->GetActorLocation(), LastGoalLocation) > FMath::Square(RepathDistance);
+}
+
+void AGASEnemyAIController::ExecuteChaseMove(double Now)
+{
+	// The pawn may have reached a flow field while the request waited in the queue
+	AActor* Target = ChaseTarget.Get();
+	if (!Target || !GetPawn() || bOnFlowField)
+	{
+		return;
+	}
+
+	LastPathRequestTime = Now;
+	LastGoalLocation = Target->GetActorLocation();
+
+	// A fixed goal, not the target actor, so path following never re-paths on its own. Every new query goes through the
+	// navigation subsystem's budget once the target moved RepathDistance from this goal
+	MoveToLocation(LastGoalLocation, ChaseAcceptanceRadius, true, true, true, true, nullptr, true);
+}
+
+bool AGASEnemyAIController::SteerAlongFlowField(UGASFlowFieldSubsystem* FlowFields)
+{
+	const AActor* Target = ChaseTarget.Get();
+	APawn* ControlledPawn = GetPawn();
+	FVector Direction;
+	if (!FlowFields || !Target || !ControlledPawn || !FlowFields->GetChaseDirection(Target, ControlledPawn->GetActorLocation(), Direction))
+	{
+		// Back to path queries, the first one is due straight away
+		if (bOnFlowField)
+		{
+			bOnFlowField = false;
+			LastPathRequestTime = -MAX_dbl;
+		}
+		return false;
+	}
+
+	// The field replaces the path being followed
+	if (!bOnFlowField)
+	{
+		bOnFlowField = true;
+		StopMovement();
+	}
+
+	if (FVector::DistSquared2D(Target->GetActorLocation(), ControlledPawn->GetActorLocation()) > FMath::Square(ChaseAcceptanceRadius))
+	{
+		ControlledPawn->AddMovementInput(Direction);
+	}
+	return true;
+}
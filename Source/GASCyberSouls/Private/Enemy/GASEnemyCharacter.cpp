@@ -1,15 +1,33 @@
 // copyright GASCyberSouls
 
 #include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASEnemyRegistry.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "AbilitySystemComponent.h"
 #include "Ability/GASQuickHackAbility.h"
 #include "GAS/GASAbilitySystemComponent.h"
 #include "Attribute/GASAttributeSet.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/GASEnemyNetActivitySubsystem.h"
+#include "Enemy/GASEnemyAIController.h"
+#include "Combat/GASHitZoneComponent.h"
+#include "Combat/GASVisibilitySubsystem.h"
+#include "Profiling/GASMemoryReport.h"
+
+static TAutoConsoleVariable<bool> CVarEnemySharedMovement(
+	TEXT("CyberSouls.Net.EnemySharedMovement"),
+	true,
+	TEXT("Send quantized, yaw-only movement of distant, non-engaged enemies through the replication graph's fast shared path"));
 
 AGASEnemyCharacter::AGASEnemyCharacter()
 {
+	LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+	
 	// Set default values
 	EnemyType = EEnemyType::Basic;
 	bCanHack = false;
@@ -18,10 +36,22 @@ AGASEnemyCharacter::AGASEnemyCharacter()
 	AttackRange = 200.0f;
 	HackRange = 800.0f;
 	TargetedBodyPart = EBodyPartType::None;
+	LastNetWakeTime = -MAX_flt;
+	
+	// Spawned enemies get an AI controller too, the enemy navigation subsystem drives their chase
+	AIControllerClass = AGASEnemyAIController::StaticClass();
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 	
 	// Set this character to call Tick() every frame
 	PrimaryActorTick.bCanEverTick = true;
 	
+	HitZoneComponent = CreateDefaultSubobject<UGASHitZoneComponent>(TEXT("HitZoneComponent"));
+	
+	// Melee finds enemies with queries on the combat channel, crowds of them would only pay for overlap events nobody uses.
+	// Players keep theirs for trigger volumes and blueprint overlaps
+	GetCapsuleComponent()->SetGenerateOverlapEvents(false);
+	GetMesh()->SetGenerateOverlapEvents(false);
+	
 	// Configure character movement
 	UCharacterMovementComponent* CharMoveComp = GetCharacterMovement();
 	if (CharMoveComp)
@@ -29,6 +59,10 @@ AGASEnemyCharacter::AGASEnemyCharacter()
 		CharMoveComp->bOrientRotationToMovement = true;
 		CharMoveComp->RotationRate = FRotator(0.0f, 540.0f, 0.0f);
 		CharMoveComp->MaxWalkSpeed = 300.0f;
+		
+		// Simulated proxies interpolate between server time stamps, so sparse updates from distant enemies stay smooth
+		CharMoveComp->NetworkSmoothingMode = ENetworkSmoothingMode::Linear;
+		CharMoveComp->bNetworkAlwaysReplicateTransformUpdateTimestamp = true;
 	}
 }
 
@@ -36,11 +70,37 @@ void AGASEnemyCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+	
+	// Make this enemy visible to per-frame systems such as the HUD overlay
+	if (UGASEnemyRegistry* Registry = UGASEnemyRegistry::Get(this))
+	{
+		Registry->RegisterEnemy(this);
+	}
+	
 	// Setup AI behavior if we're the server
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		SetupAIBehavior();
+		
+		// Combat wakes the enemy from net dormancy
+		if (AbilitySystemComponent)
+		{
+			AbilitySystemComponent->AbilityActivatedCallbacks.AddUObject(this, &AGASEnemyCharacter::OnAbilityActivated);
+			AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &AGASEnemyCharacter::OnEffectApplied);
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UGASAttributeSet::GetIntegrityAttribute()).AddUObject(this, &AGASEnemyCharacter::OnIntegrityChanged);
+		}
+	}
+}
+
+void AGASEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGASEnemyRegistry* Registry = UGASEnemyRegistry::Get(this))
+	{
+		Registry->UnregisterEnemy(this);
 	}
+	
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGASEnemyCharacter::Tick(float DeltaTime)
@@ -54,8 +114,10 @@ void AGASEnemyCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	// Replicate targeted body part
-	DOREPLIFETIME(AGASEnemyCharacter, TargetedBodyPart);
+	// Replicate targeted body part, push based so it is only compared after SetTargetedBodyPart changed it
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AGASEnemyCharacter, TargetedBodyPart, Params);
 }
 
 EBodyPartType AGASEnemyCharacter::GetTargetedBodyPart() const
@@ -65,12 +127,116 @@ EBodyPartType AGASEnemyCharacter::GetTargetedBodyPart() const
 
 void AGASEnemyCharacter::SetTargetedBodyPart(EBodyPartType NewBodyPart)
 {
-	if (GetLocalRole() == ROLE_Authority)
+	if (GetLocalRole() == ROLE_Authority && TargetedBodyPart != NewBodyPart)
 	{
 		TargetedBodyPart = NewBodyPart;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AGASEnemyCharacter, TargetedBodyPart, this);
+		
+		// Waking re-classifies the enemy right away, so it has to see the new body part to pick the engaged tier
+		WakeNetDormancy();
+	}
+}
+
+void AGASEnemyCharacter::WakeNetDormancy()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+	
+	LastNetWakeTime = GetWorld()->GetTimeSeconds();
+	
+	// Re-classify right away so the enemy also gets its combat update frequency without waiting for the next evaluation
+	if (NetDormancy > DORM_Awake)
+	{
+		SetNetDormancy(DORM_Awake);
+		
+		if (UGASEnemyNetActivitySubsystem* NetActivity = GetWorld()->GetSubsystem<UGASEnemyNetActivitySubsystem>())
+		{
+			NetActivity->UpdateEnemy(this);
+		}
 	}
 }
 
+void AGASEnemyCharacter::OnAbilityActivated(UGameplayAbility* Ability)
+{
+	WakeNetDormancy();
+}
+
+void AGASEnemyCharacter::OnEffectApplied(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	WakeNetDormancy();
+}
+
+void AGASEnemyCharacter::OnIntegrityChanged(const FOnAttributeChangeData& ChangeData)
+{
+	WakeNetDormancy();
+}
+
+bool AGASEnemyCharacter::IsEngaged() const
+{
+	if (TargetedBodyPart != EBodyPartType::None)
+	{
+		return true;
+	}
+	
+	static const FGameplayTagContainer EngagedTags = FGameplayTagContainer::CreateFromArray(TArray<FGameplayTag>{ TAG_State_Hacking, TAG_State_Blocking, TAG_State_Dodging });
+	return AbilitySystemComponent && AbilitySystemComponent->HasAnyMatchingGameplayTags(EngagedTags);
+}
+
+bool AGASEnemyCharacter::UpdateSharedReplication()
+{
+	if (GetLocalRole() != ROLE_Authority || !CVarEnemySharedMovement.GetValueOnGameThread() || IsEngaged())
+	{
+		return false;
+	}
+	
+	FGASSharedRepMovement SharedMovement;
+	if (!SharedMovement.FillForCharacter(this))
+	{
+		return false;
+	}
+	
+	// Skipping the call reuses the last bunch, connections that already received it are not sent it again
+	if (!SharedMovement.Equals(LastSharedMovement))
+	{
+		LastSharedMovement = SharedMovement;
+		FastSharedReplication(SharedMovement);
+	}
+	return true;
+}
+
+void AGASEnemyCharacter::FastSharedReplication_Implementation(const FGASSharedRepMovement& SharedMovement)
+{
+	if (GetLocalRole() != ROLE_SimulatedProxy || GetWorld()->IsPlayingReplay())
+	{
+		return;
+	}
+	
+	// Unreliable and unordered against the default path, drop anything older than what was applied last
+	if (SharedMovement.TimeStamp < ReplicatedServerLastTransformUpdateTimeStamp)
+	{
+		return;
+	}
+	ReplicatedServerLastTransformUpdateTimeStamp = SharedMovement.TimeStamp;
+	
+	if (ReplicatedMovementMode != SharedMovement.MovementMode)
+	{
+		ReplicatedMovementMode = SharedMovement.MovementMode;
+		GetCharacterMovement()->bNetworkMovementModeChanged = true;
+		GetCharacterMovement()->bNetworkUpdateReceived = true;
+	}
+	
+	FRepMovement& RepMovement = GetReplicatedMovement_Mutable();
+	RepMovement.Location = SharedMovement.Location;
+	RepMovement.Rotation = FRotator(0.0f, SharedMovement.Yaw, 0.0f);
+	RepMovement.LinearVelocity = SharedMovement.Velocity;
+	RepMovement.bRepPhysics = false;
+	
+	// Hands the move to the movement component's simulated proxy smoothing
+	OnRep_ReplicatedMovement();
+}
+
 void AGASEnemyCharacter::OnRep_TargetedBodyPart()
 {
 	// Handle visuals for targeted body part here
@@ -79,11 +245,19 @@ void AGASEnemyCharacter::OnRep_TargetedBodyPart()
 
 void AGASEnemyCharacter::TryAttack()
 {
+	// No swing at a chase target behind cover, line of sight comes from the shared visibility cache
+	const AGASEnemyAIController* EnemyController = Cast<AGASEnemyAIController>(GetController());
+	const AActor* ChaseTarget = EnemyController ? EnemyController->GetChaseTarget() : nullptr;
+	UGASVisibilitySubsystem* Visibility = GetWorld()->GetSubsystem<UGASVisibilitySubsystem>();
+	if (ChaseTarget && Visibility && !Visibility->HasLineOfSight(this, ChaseTarget, true))
+	{
+		return;
+	}
+	
 	if (AbilitySystemComponent)
 	{
 		// Try to activate attack ability
-		FGameplayTagContainer AttackTag;
-		AttackTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack")));
+		static const FGameplayTagContainer AttackTag(TAG_Ability_Attack);
 		
 		// Cast to our custom ASC
 		UGASAbilitySystemComponent* GasASC = Cast<UGASAbilitySystemComponent>(AbilitySystemComponent);
@@ -104,8 +278,7 @@ void AGASEnemyCharacter::TryBlock()
 	if (AbilitySystemComponent)
 	{
 		// Try to activate block ability
-		FGameplayTagContainer BlockTag;
-		BlockTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Block")));
+		static const FGameplayTagContainer BlockTag(TAG_Ability_Block);
 		
 		// Cast to our custom ASC
 		UGASAbilitySystemComponent* GasASC = Cast<UGASAbilitySystemComponent>(AbilitySystemComponent);
@@ -126,8 +299,7 @@ void AGASEnemyCharacter::TryDodge()
 	if (AbilitySystemComponent)
 	{
 		// Try to activate dodge ability
-		FGameplayTagContainer DodgeTag;
-		DodgeTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Dodge")));
+		static const FGameplayTagContainer DodgeTag(TAG_Ability_Dodge);
 		
 		// Cast to our custom ASC
 		UGASAbilitySystemComponent* GasASC = Cast<UGASAbilitySystemComponent>(AbilitySystemComponent);
@@ -148,8 +320,7 @@ void AGASEnemyCharacter::TryHack()
 	if (AbilitySystemComponent)
 	{
 		// Try to activate hack ability
-		FGameplayTagContainer HackTag;
-		HackTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Hack")));
+		static const FGameplayTagContainer HackTag(TAG_Ability_Hack);
 		
 		// Cast to our custom ASC
 		UGASAbilitySystemComponent* GasASC = Cast<UGASAbilitySystemComponent>(AbilitySystemComponent);
@@ -171,18 +342,21 @@ void AGASEnemyCharacter::TryQuickHack(EQuickHackType QuickHackType)
 	if (AbilitySystemComponent)
 	{
 		// Try to activate the specific QuickHack ability
-		FGameplayTagContainer QuickHackTag;
+		static const FGameplayTagContainer InterruptProtocolTag(TAG_Ability_QuickHack_InterruptProtocol);
+		static const FGameplayTagContainer SystemFreezeTag(TAG_Ability_QuickHack_SystemFreeze);
+		static const FGameplayTagContainer FirewallBarrierTag(TAG_Ability_QuickHack_FirewallBarrier);
 		
+		const FGameplayTagContainer* QuickHackTag = nullptr;
 		switch (QuickHackType)
 		{
 			case EQuickHackType::InterruptProtocol:
-				QuickHackTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.InterruptProtocol")));
+				QuickHackTag = &InterruptProtocolTag;
 				break;
 			case EQuickHackType::SystemFreeze:
-				QuickHackTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.SystemFreeze")));
+				QuickHackTag = &SystemFreezeTag;
 				break;
 			case EQuickHackType::FirewallBarrier:
-				QuickHackTag.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.QuickHack.FirewallBarrier")));
+				QuickHackTag = &FirewallBarrierTag;
 				break;
 			default:
 				return;
@@ -192,7 +366,7 @@ void AGASEnemyCharacter::TryQuickHack(EQuickHackType QuickHackType)
 		UGASAbilitySystemComponent* GasASC = Cast<UGASAbilitySystemComponent>(AbilitySystemComponent);
 		if (GasASC)
 		{
-			GasASC->TryActivateAbilityByTag(QuickHackTag);
+			GasASC->TryActivateAbilityByTag(*QuickHackTag);
 		}
 	}
 }
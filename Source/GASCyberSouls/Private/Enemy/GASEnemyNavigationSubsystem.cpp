@@ -0,0 +1,335 @@
+// copyright GASCyberSouls
+
+#include "Enemy/GASEnemyNavigationSubsystem.h"
+#include "Combat/GASVisibilitySubsystem.h"
+#include "Enemy/GASEnemyAIController.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASFlowFieldSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<bool> CVarEnemyChase(
+	TEXT("CyberSouls.AI.EnemyChase"),
+	true,
+	TEXT("Let enemy AI controllers chase the nearest player within the chase radius"));
+
+static TAutoConsoleVariable<bool> CVarFlowFieldChase(
+	TEXT("CyberSouls.AI.FlowFieldChase"),
+	true,
+	TEXT("Steer chasing enemies along their target's flow field, with path queries only where the field does not reach"));
+
+namespace GASEnemyNavigation
+{
+	// Frames kept for the path query report, half a minute at 60 fps
+	static constexpr int32 MaxRecordedFrames = 1800;
+
+	static constexpr int32 EngagedPriority = 2;
+	static constexpr int32 ClosePriority = 1;
+}
+
+UGASEnemyNavigationSubsystem::UGASEnemyNavigationSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASEnemyNavigationSubsystem]
+	MaxPathRequestsPerFrame = 8;
+	MaxPathRequestMsPerFrame = 1.0f;
+	RepathInterval = 0.5f;
+	RepathDistance = 150.0f;
+	SignificanceInterval = 0.25f;
+	ChaseRadius = 3000.0f;
+	HighSignificanceRadius = 1000.0f;
+	MediumSignificanceRadius = 2000.0f;
+	HighAvoidanceQueryRange = 600.0f;
+	MediumAvoidanceQueryRange = 400.0f;
+	LowAvoidanceQueryRange = 250.0f;
+
+	NextPathQuerySample = 0;
+	MaxPendingRequests = 0;
+	TimeUntilSignificanceUpdate = 0.0f;
+}
+
+bool UGASEnemyNavigationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UGASEnemyNavigationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASEnemyNavigationSubsystem, STATGROUP_Tickables);
+}
+
+void UGASEnemyNavigationSubsystem::RegisterController(AGASEnemyAIController* Controller)
+{
+	Controllers.AddUnique(Controller);
+}
+
+void UGASEnemyNavigationSubsystem::UnregisterController(AGASEnemyAIController* Controller)
+{
+	Controllers.RemoveSingleSwap(Controller);
+
+	if (Controller)
+	{
+		Controller->bPathRequestQueued = false;
+	}
+}
+
+void UGASEnemyNavigationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+
+	// AI controllers only exist where enemies are simulated
+	if (Controllers.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	TimeUntilSignificanceUpdate -= DeltaTime;
+	if (TimeUntilSignificanceUpdate <= 0.0f)
+	{
+		TimeUntilSignificanceUpdate = FMath::Max(SignificanceInterval, 0.02f);
+		UpdateSignificance();
+	}
+
+	SteerAlongFlowFields();
+	QueuePathRequests(Now);
+	RunPathRequests(Now);
+}
+
+void UGASEnemyNavigationSubsystem::SteerAlongFlowFields()
+{
+	UGASFlowFieldSubsystem* FlowFields = CVarFlowFieldChase.GetValueOnGameThread() ? GetWorld()->GetSubsystem<UGASFlowFieldSubsystem>() : nullptr;
+
+	for (const TWeakObjectPtr<AGASEnemyAIController>& ControllerPtr : Controllers)
+	{
+		if (AGASEnemyAIController* Controller = ControllerPtr.Get())
+		{
+			Controller->SteerAlongFlowField(Controller->GetChaseTarget() ? FlowFields : nullptr);
+		}
+	}
+}
+
+void UGASEnemyNavigationSubsystem::UpdateSignificance()
+{
+	TArray<APawn*, TInlineAllocator<8>> Players;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->GetPawn())
+		{
+			Players.Add(PC->GetPawn());
+		}
+	}
+
+	const bool bChase = CVarEnemyChase.GetValueOnGameThread();
+	UGASVisibilitySubsystem* Visibility = GetWorld()->GetSubsystem<UGASVisibilitySubsystem>();
+
+	for (int32 Index = Controllers.Num() - 1; Index >= 0; --Index)
+	{
+		AGASEnemyAIController* Controller = Controllers[Index].Get();
+		const APawn* Enemy = Controller ? Controller->GetPawn() : nullptr;
+		if (!Enemy)
+		{
+			if (!Controller)
+			{
+				Controllers.RemoveAtSwap(Index);
+			}
+			continue;
+		}
+
+		APawn* NearestPlayer = nullptr;
+		float NearestDistanceSquared = MAX_flt;
+		for (APawn* Player : Players)
+		{
+			const float DistanceSquared = FVector::DistSquared(Player->GetActorLocation(), Enemy->GetActorLocation());
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				NearestPlayer = Player;
+			}
+		}
+
+		if (NearestDistanceSquared <= FMath::Square(HighSignificanceRadius))
+		{
+			Controller->ApplySignificance(EGASEnemySignificance::High, HighAvoidanceQueryRange);
+		}
+		else if (NearestDistanceSquared <= FMath::Square(MediumSignificanceRadius))
+		{
+			Controller->ApplySignificance(EGASEnemySignificance::Medium, MediumAvoidanceQueryRange);
+		}
+		else if (NearestDistanceSquared <= FMath::Square(ChaseRadius))
+		{
+			Controller->ApplySignificance(EGASEnemySignificance::Low, LowAvoidanceQueryRange);
+		}
+		else
+		{
+			Controller->ApplySignificance(EGASEnemySignificance::Off, 0.0f);
+			NearestPlayer = nullptr;
+		}
+
+		// A player is only picked up in sight, an enemy already chasing keeps its target when it goes behind cover
+		if (NearestPlayer && NearestPlayer != Controller->GetChaseTarget() && Visibility && !Visibility->HasLineOfSight(Enemy, NearestPlayer))
+		{
+			NearestPlayer = Cast<APawn>(Controller->GetChaseTarget());
+		}
+
+		Controller->SetChaseTarget(bChase ? NearestPlayer : nullptr);
+	}
+}
+
+void UGASEnemyNavigationSubsystem::QueuePathRequests(double Now)
+{
+	for (const TWeakObjectPtr<AGASEnemyAIController>& ControllerPtr : Controllers)
+	{
+		AGASEnemyAIController* Controller = ControllerPtr.Get();
+		if (!Controller || !Controller->WantsRepath(Now, RepathInterval, RepathDistance))
+		{
+			continue;
+		}
+
+		const AGASEnemyCharacter* Enemy = Cast<AGASEnemyCharacter>(Controller->GetPawn());
+
+		FPathRequest& Request = PendingRequests.AddDefaulted_GetRef();
+		Request.Controller = Controller;
+		Request.Priority = Enemy && Enemy->IsEngaged() ? GASEnemyNavigation::EngagedPriority
+			: Controller->GetSignificance() == EGASEnemySignificance::High ? GASEnemyNavigation::ClosePriority
+			: 0;
+		Controller->bPathRequestQueued = true;
+	}
+
+	MaxPendingRequests = FMath::Max(MaxPendingRequests, PendingRequests.Num());
+}
+
+void UGASEnemyNavigationSubsystem::RunPathRequests(double Now)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumRun = 0;
+
+	if (PendingRequests.Num() > 0)
+	{
+		CYBERSOULS_SCOPED_STAT(EnemyPathRequests);
+
+		// Stable so requests of the same priority keep their queue order
+		PendingRequests.StableSort([](const FPathRequest& A, const FPathRequest& B)
+		{
+			return A.Priority > B.Priority;
+		});
+
+		const double Deadline = StartTime + MaxPathRequestMsPerFrame / 1000.0;
+		while (NumRun < PendingRequests.Num() && NumRun < MaxPathRequestsPerFrame && FPlatformTime::Seconds() < Deadline)
+		{
+			if (AGASEnemyAIController* Controller = PendingRequests[NumRun].Controller.Get())
+			{
+				Controller->bPathRequestQueued = false;
+				Controller->ExecuteChaseMove(Now);
+			}
+			++NumRun;
+		}
+
+		// The rest waits for the next frame, ahead of anything queued later with the same priority
+		PendingRequests.RemoveAt(0, NumRun, EAllowShrinking::No);
+	}
+
+	CYBERSOULS_INC_COUNTER(PathRequestsRun, NumRun);
+
+	const float FrameMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	if (PathQueryMs.Num() < GASEnemyNavigation::MaxRecordedFrames)
+	{
+		PathQueryMs.Add(FrameMs);
+	}
+	else
+	{
+		PathQueryMs[NextPathQuerySample] = FrameMs;
+		NextPathQuerySample = (NextPathQuerySample + 1) % GASEnemyNavigation::MaxRecordedFrames;
+	}
+}
+
+void UGASEnemyNavigationSubsystem::StartPathQueryTest(int32 Count, float Seconds)
+{
+	UWorld* World = GetWorld();
+	const APlayerController* PC = World->GetFirstPlayerController();
+	const APawn* Player = PC ? PC->GetPawn() : nullptr;
+	if (!Player)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Path query test: no player pawn to chase"));
+		return;
+	}
+
+	// Fixed seed, so a map gives the same crowd every run
+	FRandomStream Random(0x50415448);
+	int32 NumSpawned = 0;
+	LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+		const float Distance = Random.FRandRange(0.2f, 0.9f) * ChaseRadius;
+		const FVector Location = Player->GetActorLocation() + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		NumSpawned += World->SpawnActor<AGASEnemyCharacter>(AGASEnemyCharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams) ? 1 : 0;
+	}
+
+	PathQueryMs.Reset();
+	NextPathQuerySample = 0;
+	MaxPendingRequests = 0;
+
+	UE_LOG(LogTemp, Display, TEXT("Path query test: spawned %d enemies, reporting in %.1fs"), NumSpawned, Seconds);
+
+	World->GetTimerManager().SetTimer(TestTimerHandle, FTimerDelegate::CreateUObject(this, &UGASEnemyNavigationSubsystem::LogPathQueryReport), FMath::Max(Seconds, 0.1f), false);
+}
+
+void UGASEnemyNavigationSubsystem::LogPathQueryReport() const
+{
+	const int32 NumFrames = PathQueryMs.Num();
+	if (NumFrames == 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Path query report: no frames recorded, %d enemy controllers"), Controllers.Num());
+		return;
+	}
+
+	TArray<float> Sorted = PathQueryMs;
+	Sorted.Sort();
+
+	float TotalMs = 0.0f;
+	for (float Ms : Sorted)
+	{
+		TotalMs += Ms;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Path query report: %d enemy controllers, %d frames, path queries avg %.3fms p95 %.3fms peak %.3fms per frame (budget %d requests, %.2fms), %d pending, at most %d"),
+		Controllers.Num(), NumFrames, TotalMs / NumFrames, Sorted[FMath::Min(FMath::FloorToInt(NumFrames * 0.95f), NumFrames - 1)], Sorted.Last(),
+		MaxPathRequestsPerFrame, MaxPathRequestMsPerFrame, PendingRequests.Num(), MaxPendingRequests);
+}
+
+namespace GASEnemyNavigation
+{
+	static FAutoConsoleCommandWithWorldAndArgs PathQueryTestCommand(
+		TEXT("CyberSouls.AI.PathQueryTest"),
+		TEXT("Spawn [Count] chasing enemies around the player (default 200) and report the path query time per frame after [Seconds] (default 20)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UGASEnemyNavigationSubsystem* Navigation = World ? World->GetSubsystem<UGASEnemyNavigationSubsystem>() : nullptr)
+			{
+				Navigation->StartPathQueryTest(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200, Args.Num() > 1 ? FCString::Atof(*Args[1]) : 20.0f);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorld PathQueryReportCommand(
+		TEXT("CyberSouls.AI.PathQueryReport"),
+		TEXT("Report the enemy path query time per frame over the recorded frames"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const UGASEnemyNavigationSubsystem* Navigation = World ? World->GetSubsystem<UGASEnemyNavigationSubsystem>() : nullptr)
+			{
+				Navigation->LogPathQueryReport();
+			}
+		}));
+}
@@ -0,0 +1,31 @@
+// copyright GASCyberSouls
+
+#include "Enemy/GASEnemyRegistry.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Engine/World.h"
+#include "Profiling/GASMemoryReport.h"
+
+UGASEnemyRegistry* UGASEnemyRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASEnemyRegistry>() : nullptr;
+}
+
+void UGASEnemyRegistry::RegisterEnemy(AGASEnemyCharacter* Enemy)
+{
+	if (Enemy)
+	{
+		LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+void UGASEnemyRegistry::UnregisterEnemy(AGASEnemyCharacter* Enemy)
+{
+	Enemies.RemoveSingleSwap(Enemy, EAllowShrinking::No);
+}
+
+bool UGASEnemyRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
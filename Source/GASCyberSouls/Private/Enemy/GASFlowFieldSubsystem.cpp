@@ -0,0 +1,337 @@
+// copyright GASCyberSouls
+
+#include "Enemy/GASFlowFieldSubsystem.h"
+#include "Engine/World.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Profiling/GASStats.h"
+#include "TimerManager.h"
+
+namespace GASFlowField
+{
+	// Straight neighbours first, a diagonal step costs about sqrt(2) straight steps
+	static const FIntPoint NeighbourOffsets[8] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+	static constexpr uint32 StraightCost = 10;
+	static constexpr uint32 DiagonalCost = 14;
+
+	static FIntPoint ToCell(const FVector& Location, float CellSize)
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	// Height bands are VerticalExtent tall, a sample searches a full band above and below the band's centre
+	static int32 ToHeightBand(float Z, float VerticalExtent)
+	{
+		return FMath::FloorToInt(Z / VerticalExtent);
+	}
+
+	struct FOpenCell
+	{
+		uint32 Cost;
+		int32 Index;
+
+		bool operator<(const FOpenCell& Other) const { return Cost < Other.Cost; }
+	};
+
+	// Walkability of every cell of the grid around the target, sampling at most SampleBudget cells not seen before. Runs on the game
+	// thread, the navmesh is not safe to read from a worker while tiles are added or removed. False until every cell is sampled
+	static bool GatherWalkableCells(const ANavigationData& NavData, TMap<FIntVector, bool>& WalkableCells, const FVector& TargetLocation, float CellSize, int32 HalfExtent, float VerticalExtent, int32& SampleBudget, TArray<bool>& OutWalkable)
+	{
+		const int32 Size = 2 * HalfExtent + 1;
+		const int32 NumCells = Size * Size;
+		const FIntPoint MinCell = ToCell(TargetLocation, CellSize) - FIntPoint(HalfExtent, HalfExtent);
+		const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, VerticalExtent);
+
+		// Samples are taken at the centre of the target's band, so a cached answer does not depend on where in the band the target stood
+		const int32 HeightBand = ToHeightBand(TargetLocation.Z, VerticalExtent);
+		const float SampleZ = (HeightBand + 0.5f) * VerticalExtent;
+
+		OutWalkable.SetNumUninitialized(NumCells);
+		bool bComplete = true;
+		for (int32 Index = 0; Index < NumCells; ++Index)
+		{
+			const FIntPoint Cell = MinCell + FIntPoint(Index % Size, Index / Size);
+			const FIntVector CellKey(Cell.X, Cell.Y, HeightBand);
+			if (const bool* Cached = WalkableCells.Find(CellKey))
+			{
+				OutWalkable[Index] = *Cached;
+				continue;
+			}
+
+			// Keep going through the cache, the cells sampled so far are kept for the next update
+			if (SampleBudget <= 0)
+			{
+				bComplete = false;
+				continue;
+			}
+
+			FNavLocation Projected;
+			const FVector Center((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, SampleZ);
+			OutWalkable[Index] = NavData.ProjectPoint(Center, Projected, Extent);
+			WalkableCells.Add(CellKey, OutWalkable[Index]);
+			--SampleBudget;
+		}
+
+		if (!bComplete)
+		{
+			return false;
+		}
+
+		// Forget cells far outside the grid so a player roaming the level does not grow the cache without bound
+		if (WalkableCells.Num() > 4 * NumCells)
+		{
+			const FIntPoint KeepMin = MinCell - FIntPoint(Size, Size);
+			const FIntPoint KeepMax = MinCell + FIntPoint(2 * Size, 2 * Size);
+			for (auto It = WalkableCells.CreateIterator(); It; ++It)
+			{
+				const FIntVector& Cell = It.Key();
+				if (Cell.X < KeepMin.X || Cell.Y < KeepMin.Y || Cell.X >= KeepMax.X || Cell.Y >= KeepMax.Y || FMath::Abs(Cell.Z - HeightBand) > 1)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Runs Dijkstra out from the target cell over the sampled walkability, touches no nav or world data so it can run on a worker
+	static TSharedPtr<const FGASFlowField> BuildField(TArray<bool> Walkable, const FVector& TargetLocation, float CellSize, int32 HalfExtent, float VerticalExtent)
+	{
+		CYBERSOULS_SCOPED_STAT(FlowFieldBuild);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		TSharedPtr<FGASFlowField> Field = MakeShared<FGASFlowField>();
+		Field->CellSize = CellSize;
+		Field->Size = 2 * HalfExtent + 1;
+		Field->TargetLocation = TargetLocation;
+		Field->TargetCell = ToCell(TargetLocation, CellSize);
+		Field->MinCell = Field->TargetCell - FIntPoint(HalfExtent, HalfExtent);
+		Field->VerticalExtent = VerticalExtent;
+
+		const int32 Size = Field->Size;
+		const int32 NumCells = Size * Size;
+
+		// The target may stand on the edge of the navmesh
+		const int32 TargetIndex = HalfExtent * Size + HalfExtent;
+		Walkable[TargetIndex] = true;
+
+		TArray<uint32> Costs;
+		Costs.Init(MAX_uint32, NumCells);
+		Costs[TargetIndex] = 0;
+
+		TArray<FOpenCell> Open;
+		Open.Reserve(NumCells / 4);
+		Open.HeapPush({ 0, TargetIndex });
+
+		// A diagonal step needs both straight neighbours walkable, no cutting corners past walls
+		auto CanStep = [&Walkable, Size](int32 X, int32 Y, const FIntPoint& Offset)
+		{
+			const int32 NextX = X + Offset.X;
+			const int32 NextY = Y + Offset.Y;
+			if (NextX < 0 || NextY < 0 || NextX >= Size || NextY >= Size || !Walkable[NextY * Size + NextX])
+			{
+				return false;
+			}
+			return Offset.X == 0 || Offset.Y == 0 || (Walkable[Y * Size + NextX] && Walkable[NextY * Size + X]);
+		};
+
+		while (Open.Num() > 0)
+		{
+			FOpenCell Current;
+			Open.HeapPop(Current, EAllowShrinking::No);
+			if (Current.Cost > Costs[Current.Index])
+			{
+				continue;
+			}
+
+			const int32 X = Current.Index % Size;
+			const int32 Y = Current.Index / Size;
+			for (int32 Neighbour = 0; Neighbour < 8; ++Neighbour)
+			{
+				const FIntPoint& Offset = NeighbourOffsets[Neighbour];
+				if (!CanStep(X, Y, Offset))
+				{
+					continue;
+				}
+
+				const int32 NextIndex = (Y + Offset.Y) * Size + X + Offset.X;
+				const uint32 NextCost = Current.Cost + (Neighbour < 4 ? StraightCost : DiagonalCost);
+				if (NextCost < Costs[NextIndex])
+				{
+					Costs[NextIndex] = NextCost;
+					Open.HeapPush({ NextCost, NextIndex });
+				}
+			}
+		}
+
+		// Each reachable cell points at its cheapest neighbour
+		Field->Directions.Init(FGASFlowField::InvalidDirection, NumCells);
+		for (int32 Index = 0; Index < NumCells; ++Index)
+		{
+			if (Costs[Index] == MAX_uint32 || Index == TargetIndex)
+			{
+				continue;
+			}
+
+			const int32 X = Index % Size;
+			const int32 Y = Index / Size;
+			uint32 BestCost = Costs[Index];
+			for (int32 Neighbour = 0; Neighbour < 8; ++Neighbour)
+			{
+				const FIntPoint& Offset = NeighbourOffsets[Neighbour];
+				if (CanStep(X, Y, Offset) && Costs[(Y + Offset.Y) * Size + X + Offset.X] < BestCost)
+				{
+					BestCost = Costs[(Y + Offset.Y) * Size + X + Offset.X];
+					Field->Directions[Index] = static_cast<uint8>(Neighbour);
+				}
+			}
+		}
+
+		Field->BuildSeconds = FPlatformTime::Seconds() - StartTime;
+		return Field;
+	}
+}
+
+bool FGASFlowField::GetDirection(const FVector& Location, FVector& OutDirection) const
+{
+	const FIntPoint Local = GASFlowField::ToCell(Location, CellSize) - MinCell;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Size || Local.Y >= Size || FMath::Abs(Location.Z - TargetLocation.Z) > VerticalExtent)
+	{
+		return false;
+	}
+
+	if (Local + MinCell == TargetCell)
+	{
+		OutDirection = (TargetLocation - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	const uint8 Direction = Directions[Local.Y * Size + Local.X];
+	if (Direction == InvalidDirection)
+	{
+		return false;
+	}
+
+	const FIntPoint& Offset = GASFlowField::NeighbourOffsets[Direction];
+	OutDirection = FVector(Offset.X, Offset.Y, 0.0f).GetSafeNormal();
+	return true;
+}
+
+UGASFlowFieldSubsystem::UGASFlowFieldSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASFlowFieldSubsystem]
+	CellSize = 100.0f;
+	HalfExtentCells = 48;
+	VerticalExtent = 250.0f;
+	UpdateInterval = 0.1f;
+	RequestTimeout = 2.0f;
+	MaxNavSamplesPerUpdate = 1000;
+
+	NumBuilds = 0;
+	TotalBuildSeconds = 0.0;
+}
+
+bool UGASFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGASFlowFieldSubsystem::Deinitialize()
+{
+	// Running builds only hold their own copy of the walkable cells and finish on their own
+	TargetFields.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UGASFlowFieldSubsystem::GetChaseDirection(const AActor* Target, const FVector& Location, FVector& OutDirection)
+{
+	// Enemies only move on the server
+	UWorld* World = GetWorld();
+	if (!Target || !World || World->GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	FTargetField& TargetField = TargetFields.FindOrAdd(Target);
+	TargetField.LastRequestTime = World->GetTimeSeconds();
+
+	// Nothing is built until the first request
+	if (!UpdateTimerHandle.IsValid())
+	{
+		World->GetTimerManager().SetTimer(UpdateTimerHandle, FTimerDelegate::CreateUObject(this, &UGASFlowFieldSubsystem::UpdateFields), FMath::Max(UpdateInterval, 0.02f), true, 0.0f);
+	}
+
+	return TargetField.Field.IsValid() && TargetField.Field->GetDirection(Location, OutDirection);
+}
+
+void UGASFlowFieldSubsystem::UpdateFields()
+{
+	CYBERSOULS_SCOPED_STAT(FlowFieldUpdate);
+
+	UWorld* World = GetWorld();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys && !NavSys->IsNavigationBuildInProgress() ? NavSys->GetDefaultNavDataInstance() : nullptr;
+
+	const double StaleTime = World->GetTimeSeconds() - RequestTimeout;
+	int32 SampleBudget = FMath::Max(MaxNavSamplesPerUpdate, 1);
+
+	for (auto It = TargetFields.CreateIterator(); It; ++It)
+	{
+		// Drop the fields of targets that are gone or no longer chased
+		if (!It.Key().IsValid() || It.Value().LastRequestTime < StaleTime)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		UpdateTarget(It.Key().Get(), It.Value(), NavData, SampleBudget);
+	}
+
+	// The timer starts again with the next request
+	if (TargetFields.Num() == 0)
+	{
+		World->GetTimerManager().ClearTimer(UpdateTimerHandle);
+	}
+}
+
+void UGASFlowFieldSubsystem::UpdateTarget(const AActor* Target, FTargetField& TargetField, const ANavigationData* NavData, int32& SampleBudget)
+{
+	if (TargetField.bBuilding)
+	{
+		if (!TargetField.BuildTask.IsCompleted())
+		{
+			return;
+		}
+
+		// Swap in the new field, lookups keep the old one alive until they let go of it
+		TargetField.Field = TargetField.BuildTask.GetResult();
+		TargetField.bBuilding = false;
+		++NumBuilds;
+		TotalBuildSeconds += TargetField.Field->BuildSeconds;
+	}
+
+	const FVector TargetLocation = Target->GetActorLocation();
+	const FIntPoint TargetCell = GASFlowField::ToCell(TargetLocation, CellSize);
+	if (!NavData || (TargetField.Field.IsValid() && TargetField.Field->TargetCell == TargetCell))
+	{
+		return;
+	}
+
+	// Newly covered cells are sampled here within the update's budget, a large move may take a few updates before the build starts
+	const int32 HalfExtent = FMath::Max(HalfExtentCells, 1);
+	TArray<bool> Walkable;
+	if (!GASFlowField::GatherWalkableCells(*NavData, TargetField.WalkableCells, TargetLocation, CellSize, HalfExtent, VerticalExtent, SampleBudget, Walkable))
+	{
+		return;
+	}
+
+	TargetField.bBuilding = true;
+	TargetField.BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Walkable = MoveTemp(Walkable), TargetLocation, Size = CellSize, HalfExtent, Vertical = VerticalExtent]() mutable
+		{
+			return GASFlowField::BuildField(MoveTemp(Walkable), TargetLocation, Size, HalfExtent, Vertical);
+		});
+}
@@ -1,6 +1,7 @@
 #include "GAS/GASAbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "GameplayAbilitySpec.h"
+#include "Profiling/GASMemoryReport.h"
 
 UGASAbilitySystemComponent::UGASAbilitySystemComponent()
 {
@@ -41,6 +42,8 @@ FGameplayAbilitySpecHandle UGASAbilitySystemComponent::GiveAbilityToComponent(TS
 		return FGameplayAbilitySpecHandle();
 	}
 
+	LLM_SCOPE_BYTAG(CyberSouls_Abilities);
+
 	// Create a new ability spec and give it to the component
 	FGameplayAbilitySpec AbilitySpec(AbilityClass, Level, InputID, this);
 	return GiveAbility(AbilitySpec);
@@ -3,11 +3,13 @@
 
 #include "GAS/GASGameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "Profiling/GASStats.h"
 
 UGASGameplayAbility::UGASGameplayAbility()
 {
 	// Default values
 	bActivateAbilityOnGranted = false;
+	CombatEventAbility = EGASCombatAbility::None;
 	
 	// Set instancing policy - abilities should generally be instanced per actor
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -23,4 +25,43 @@ void UGASGameplayAbility::OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo
 		// Try to activate the ability
 		ActorInfo->AbilitySystemComponent->TryActivateAbility(Spec.Handle, false);
 	}
-}
\ No newline at end of file
+}
+
+void UGASGameplayAbility::PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate, const FGameplayEventData* TriggerEventData)
+{
+	Super::PreActivate(Handle, ActorInfo, ActivationInfo, OnGameplayAbilityEndedDelegate, TriggerEventData);
+
+	CYBERSOULS_INC_COUNTER(AbilitiesActivated, 1);
+	RecordCombatEvent(EGASCombatOutcome::Activated);
+	FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::Activate);
+}
+
+bool UGASGameplayAbility::CommitAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, OUT FGameplayTagContainer* OptionalRelevantTags)
+{
+	const bool bCommitted = Super::CommitAbility(Handle, ActorInfo, ActivationInfo, OptionalRelevantTags);
+	if (bCommitted)
+	{
+		FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::Commit);
+	}
+	return bCommitted;
+}
+
+void UGASGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+	CYBERSOULS_SCOPED_STAT(AbilityEnd);
+
+	// Only record the first end, EndAbility can be reached again from timers and cancellation
+	if (IsEndAbilityValid(Handle, ActorInfo))
+	{
+		RecordCombatEvent(bWasCancelled ? EGASCombatOutcome::Cancelled : EGASCombatOutcome::Ended);
+		FGASCombatTrace::AbilityPhase(this, EGASAbilityTracePhase::End);
+	}
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+void UGASGameplayAbility::RecordCombatEvent(EGASCombatOutcome Outcome, const AActor* Target, EBodyPartType BodyPart, float Magnitude) const
+{
+	const AActor* Source = CurrentActorInfo ? CurrentActorInfo->AvatarActor.Get() : nullptr;
+	FGASCombatEventLog::Record(CombatEventAbility, Outcome, Source, Target, BodyPart, Magnitude);
+}
@@ -1,24 +1,100 @@
 // copyright GASCyberSouls
 
 #include "Game/GASCyberSoulsHUD.h"
+#include "Game/GASHUDWidget.h"
+#include "Game/GASHUDRegistry.h"
 #include "Character/GASCharacterBase.h"
 #include "Enemy/GASEnemyCharacter.h"
 #include "Engine/Canvas.h"
 #include "Engine/Texture2D.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/LocalPlayer.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Async/Async.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
 
-// Initialize static instance
-AGASCyberSoulsHUD* AGASCyberSoulsHUD::Instance = nullptr;
+#if !UE_SERVER
+namespace GASHUD
+{
+	static constexpr int32 ReticleSize = 64;
+	static constexpr int32 BodyPartSize = 32;
+
+	// Simple white crosshair, BGRA
+	static TArray<uint8> BuildReticlePixels()
+	{
+		TArray<uint8> Pixels;
+		Pixels.SetNumUninitialized(ReticleSize * ReticleSize * 4);
+		for (int32 i = 0; i < ReticleSize * ReticleSize; i++)
+		{
+			int32 X = i % ReticleSize;
+			int32 Y = i / ReticleSize;
+			
+			bool bInCrosshair = (X == 32 || Y == 32) || 
+				(X >= 30 && X <= 34 && Y >= 30 && Y <= 34);
+			
+			const uint8 Value = bInCrosshair ? 255 : 0;
+			Pixels[i * 4] = Value;
+			Pixels[i * 4 + 1] = Value;
+			Pixels[i * 4 + 2] = Value;
+			Pixels[i * 4 + 3] = Value;
+		}
+		return Pixels;
+	}
+
+	// Simple white circle, BGRA
+	static TArray<uint8> BuildBodyPartPixels()
+	{
+		TArray<uint8> Pixels;
+		Pixels.SetNumUninitialized(BodyPartSize * BodyPartSize * 4);
+		for (int32 i = 0; i < BodyPartSize * BodyPartSize; i++)
+		{
+			int32 X = i % BodyPartSize;
+			int32 Y = i / BodyPartSize;
+			
+			float Distance = FMath::Sqrt(FMath::Square(X - 16.0f) + FMath::Square(Y - 16.0f));
+			const uint8 Value = Distance <= 12.0f ? 255 : 0;
+			Pixels[i * 4] = Value;
+			Pixels[i * 4 + 1] = Value;
+			Pixels[i * 4 + 2] = Value;
+			Pixels[i * 4 + 3] = Value;
+		}
+		return Pixels;
+	}
+
+	// Must run on the game thread
+	static UTexture2D* CreateTexture(int32 Size, const TArray<uint8>& Pixels)
+	{
+		UTexture2D* Texture = UTexture2D::CreateTransient(Size, Size, PF_B8G8R8A8);
+		if (!Texture)
+		{
+			return nullptr;
+		}
+		
+		FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+		void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(Data, Pixels.GetData(), Pixels.Num());
+		Mip.BulkData.Unlock();
+		Texture->UpdateResource();
+		return Texture;
+	}
+}
+#endif
 
 AGASCyberSoulsHUD::AGASCyberSoulsHUD()
 {
+	// Ticking is only enabled while a target is locked
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	
+	HUDWidgetClass = UGASHUDWidget::StaticClass();
+	HUDWidget = nullptr;
+	
 	// Initialize state
 	bTargetingReticleVisible = false;
 	bHackProgressVisible = false;
-	bQuickHackNotificationVisible = false;
 	
-	CurrentTarget = nullptr;
 	CurrentTargetedBodyPart = EBodyPartType::None;
 	
 	HackProgressValue = 0.0f;
@@ -27,132 +103,188 @@ AGASCyberSoulsHUD::AGASCyberSoulsHUD()
 	IntegrityValue = 100.0f;
 	MaxIntegrityValue = 100.0f;
 	
-	QuickHackNotificationText = "";
 	QuickHackNotificationColor = FLinearColor(0.0f, 1.0f, 1.0f, 1.0f); // Cyan
 	
-	// Create default textures on first use
+	// Default textures are built in the background on BeginPlay
 	DefaultReticleTexture = nullptr;
 	DefaultBodyPartTexture = nullptr;
 }
 
-void AGASCyberSoulsHUD::DrawHUD()
+void AGASCyberSoulsHUD::BeginPlay()
 {
-	Super::DrawHUD();
+	Super::BeginPlay();
 	
-	// Store this as the active instance
-	Instance = this;
+	LLM_SCOPE_BYTAG(CyberSouls_HUD);
 	
-	// Ensure we have textures (even fallbacks)
-	EnsureDefaultTextures();
+	// Dedicated servers build the HUD class but never show it
+#if !UE_SERVER
+	// Lookups from gameplay code go through the owning local player's registry
+	if (UGASHUDRegistry* Registry = PlayerOwner && PlayerOwner->GetLocalPlayer() ? PlayerOwner->GetLocalPlayer()->GetSubsystem<UGASHUDRegistry>() : nullptr)
+	{
+		Registry->RegisterHUD(this);
+	}
 	
-	// Draw HUD elements
-	if (bTargetingReticleVisible && CurrentTarget)
+	if (PlayerOwner && PlayerOwner->IsLocalController() && HUDWidgetClass)
 	{
-		DrawTargetingReticle();
-		DrawBodyPartIndicators();
+		HUDWidget = CreateWidget<UGASHUDWidget>(PlayerOwner, HUDWidgetClass);
+		if (HUDWidget)
+		{
+			HUDWidget->AddToPlayerScreen();
+			HUDWidget->SetIntegrity(IntegrityValue, MaxIntegrityValue);
+			HUDWidget->SetHackProgress(HackProgressValue, MaxHackProgressValue);
+			HUDWidget->SetHackProgressVisible(bHackProgressVisible);
+			ApplyTextures();
+		}
+		
+		// Clients never see the server's combat events, they get their numbers from AddReplicatedCombatText instead
+		if (GetNetMode() != NM_Client)
+		{
+			CombatEventHandle = FGASCombatEventLog::Get().OnEventRecorded().AddUObject(this, &AGASCyberSoulsHUD::OnCombatEventRecorded);
+		}
 	}
 	
-	if (bHackProgressVisible)
+	BuildDefaultTexturesAsync();
+#endif
+}
+
+void AGASCyberSoulsHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGASCombatEventLog::Get().OnEventRecorded().Remove(CombatEventHandle);
+	CombatEventHandle.Reset();
+	FloatingCombatText.Clear();
+	
+	if (HUDWidget)
 	{
-		DrawHackProgressBar();
+		HUDWidget->RemoveFromParent();
+		HUDWidget = nullptr;
 	}
 	
-	// Always draw integrity
-	DrawIntegrityBar();
+	if (UGASHUDRegistry* Registry = PlayerOwner && PlayerOwner->GetLocalPlayer() ? PlayerOwner->GetLocalPlayer()->GetSubsystem<UGASHUDRegistry>() : nullptr)
+	{
+		Registry->UnregisterHUD(this);
+	}
 	
-	if (bQuickHackNotificationVisible)
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGASCyberSoulsHUD::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	
+	UpdateReticlePosition();
+}
+
+void AGASCyberSoulsHUD::DrawHUD()
+{
+	CYBERSOULS_SCOPED_STAT(DrawHUD);
+	LLM_SCOPE_BYTAG(CyberSouls_HUD);
+
+	Super::DrawHUD();
+	
+#if !UE_SERVER
+	EnemyOverlay.Draw(Canvas, GetWorld(), CurrentTarget.Get());
+	FloatingCombatText.Draw(Canvas, GetWorld()->GetTimeSeconds());
+#endif
+}
+
+void AGASCyberSoulsHUD::OnCombatEventRecorded(const FGASCombatEvent& Event, const AActor* Source, const AActor* Target)
+{
+	// Only show numbers for fights this player is part of
+	const APawn* Pawn = PlayerOwner ? PlayerOwner->GetPawn() : nullptr;
+	if (!Pawn || (Source != Pawn && Target != Pawn))
 	{
-		DrawQuickHackNotification();
+		return;
 	}
+	
+	LLM_SCOPE_BYTAG(CyberSouls_HUD);
+	FloatingCombatText.AddEvent(Event, Target, GetWorld()->GetTimeSeconds());
 }
 
-void AGASCyberSoulsHUD::EnsureDefaultTextures()
+void AGASCyberSoulsHUD::AddReplicatedCombatText(const AActor* Target, EGASCombatOutcome Outcome, float Magnitude)
 {
-	// Create default reticle texture if needed
-	if (!DefaultReticleTexture)
+#if !UE_SERVER
+	UWorld* World = Target ? Target->GetWorld() : nullptr;
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (!GameInstance || World->GetNetMode() != NM_Client)
 	{
-		DefaultReticleTexture = UTexture2D::CreateTransient(64, 64);
-		
-		// Fill with white pixels
-		uint8* Pixels = new uint8[64 * 64 * 4];
-		for (int32 i = 0; i < 64 * 64; i++)
-		{
-			int32 X = i % 64;
-			int32 Y = i / 64;
-			
-			// Create a simple crosshair
-			bool bInCrosshair = (X == 32 || Y == 32) || 
-				(X >= 30 && X <= 34 && Y >= 30 && Y <= 34);
-			
-			Pixels[i * 4] = bInCrosshair ? 255 : 0;     // R
-			Pixels[i * 4 + 1] = bInCrosshair ? 255 : 0; // G
-			Pixels[i * 4 + 2] = bInCrosshair ? 255 : 0; // B
-			Pixels[i * 4 + 3] = bInCrosshair ? 255 : 0; // A
-		}
-		
-		// Update the texture
-		FTexture2DMipMap& Mip = DefaultReticleTexture->PlatformData->Mips[0];
-		void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
-		FMemory::Memcpy(Data, Pixels, 64 * 64 * 4);
-		Mip.BulkData.Unlock();
-		DefaultReticleTexture->UpdateResource();
-		
-		delete[] Pixels;
+		return;
 	}
 	
-	// Create default body part texture if needed
-	if (!DefaultBodyPartTexture)
+	FGASCombatEvent Event;
+	Event.Timestamp = FPlatformTime::Seconds() - GStartTime;
+	Event.TargetId = Target->GetUniqueID();
+	Event.Magnitude = Magnitude;
+	Event.Outcome = Outcome;
+	
+	// The instigator does not replicate, so every local player sees numbers on its own pawn and on every enemy
+	const bool bIsEnemy = Target->IsA<AGASEnemyCharacter>();
+	for (ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
 	{
-		DefaultBodyPartTexture = UTexture2D::CreateTransient(32, 32);
-		
-		// Fill with white pixels
-		uint8* Pixels = new uint8[32 * 32 * 4];
-		for (int32 i = 0; i < 32 * 32; i++)
+		const UGASHUDRegistry* Registry = LocalPlayer ? LocalPlayer->GetSubsystem<UGASHUDRegistry>() : nullptr;
+		AGASCyberSoulsHUD* HUD = Registry ? Registry->GetHUD() : nullptr;
+		const APawn* Pawn = HUD && HUD->PlayerOwner ? HUD->PlayerOwner->GetPawn() : nullptr;
+		if (HUD && (bIsEnemy || Target == Pawn))
 		{
-			int32 X = i % 32;
-			int32 Y = i / 32;
-			
-			// Create a simple circle
-			float CenterX = 16.0f;
-			float CenterY = 16.0f;
-			float Radius = 12.0f;
-			
-			float Distance = FMath::Sqrt(FMath::Square(X - CenterX) + FMath::Square(Y - CenterY));
-			bool bInCircle = Distance <= Radius;
-			
-			Pixels[i * 4] = bInCircle ? 255 : 0;     // R
-			Pixels[i * 4 + 1] = bInCircle ? 255 : 0; // G
-			Pixels[i * 4 + 2] = bInCircle ? 255 : 0; // B
-			Pixels[i * 4 + 3] = bInCircle ? 255 : 0; // A
+			LLM_SCOPE_BYTAG(CyberSouls_HUD);
+			HUD->FloatingCombatText.AddEvent(Event, Target, World->GetTimeSeconds());
 		}
-		
-		// Update the texture
-		FTexture2DMipMap& Mip = DefaultBodyPartTexture->PlatformData->Mips[0];
-		void* Data = Mip.BulkData.Lock(LOCK_READ_WRITE);
-		FMemory::Memcpy(Data, Pixels, 32 * 32 * 4);
-		Mip.BulkData.Unlock();
-		DefaultBodyPartTexture->UpdateResource();
-		
-		delete[] Pixels;
 	}
+#endif
 }
 
-AGASCyberSoulsHUD* AGASCyberSoulsHUD::GetInstance(UWorld* World)
+void AGASCyberSoulsHUD::BuildDefaultTexturesAsync()
 {
-	// If we already have an instance, return it
-	if (Instance)
+#if !UE_SERVER
+	// Nothing to build when every slot has a configured texture
+	if (ReticleTexture && UpperBodyTexture && LowerBodyTexture && LeftLegTexture && RightLegTexture)
 	{
-		return Instance;
+		return;
 	}
 	
-	// Otherwise, get the HUD from the player controller
-	APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
-	if (PC)
+	TWeakObjectPtr<AGASCyberSoulsHUD> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis]()
+	{
+		LLM_SCOPE_BYTAG(CyberSouls_HUD);
+		TArray<uint8> ReticlePixels = GASHUD::BuildReticlePixels();
+		TArray<uint8> BodyPartPixels = GASHUD::BuildBodyPartPixels();
+		
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, ReticlePixels = MoveTemp(ReticlePixels), BodyPartPixels = MoveTemp(BodyPartPixels)]() mutable
+		{
+			if (AGASCyberSoulsHUD* HUD = WeakThis.Get())
+			{
+				HUD->OnDefaultTexturesBuilt(MoveTemp(ReticlePixels), MoveTemp(BodyPartPixels));
+			}
+		});
+	});
+#endif
+}
+
+void AGASCyberSoulsHUD::OnDefaultTexturesBuilt(TArray<uint8>&& ReticlePixels, TArray<uint8>&& BodyPartPixels)
+{
+#if !UE_SERVER
+	LLM_SCOPE_BYTAG(CyberSouls_HUD);
+	DefaultReticleTexture = GASHUD::CreateTexture(GASHUD::ReticleSize, ReticlePixels);
+	DefaultBodyPartTexture = GASHUD::CreateTexture(GASHUD::BodyPartSize, BodyPartPixels);
+	
+	ApplyTextures();
+#endif
+}
+
+void AGASCyberSoulsHUD::ApplyTextures()
+{
+	if (!HUDWidget)
 	{
-		return Cast<AGASCyberSoulsHUD>(PC->GetHUD());
+		return;
 	}
 	
-	return nullptr;
+	// Use the configured textures or fall back to the defaults
+	HUDWidget->SetTextures(
+		ReticleTexture ? ReticleTexture : DefaultReticleTexture,
+		UpperBodyTexture ? UpperBodyTexture : DefaultBodyPartTexture,
+		LowerBodyTexture ? LowerBodyTexture : DefaultBodyPartTexture,
+		LeftLegTexture ? LeftLegTexture : DefaultBodyPartTexture,
+		RightLegTexture ? RightLegTexture : DefaultBodyPartTexture
+	);
 }
 
 void AGASCyberSoulsHUD::UpdateTargetingReticle(AGASCharacterBase* Target, EBodyPartType TargetedBodyPart)
@@ -160,24 +292,33 @@ void AGASCyberSoulsHUD::UpdateTargetingReticle(AGASCharacterBase* Target, EBodyP
 	CurrentTarget = Target;
 	CurrentTargetedBodyPart = TargetedBodyPart;
 	
-	// Update the enemy's targeted body part
-	AGASEnemyCharacter* EnemyCharacter = Cast<AGASEnemyCharacter>(Target);
-	if (EnemyCharacter)
+	if (HUDWidget)
 	{
-		EnemyCharacter->SetTargetedBodyPart(TargetedBodyPart);
+		HUDWidget->SetTargetedBodyPart(TargetedBodyPart);
 	}
+	UpdateReticlePosition();
 }
 
 void AGASCyberSoulsHUD::UpdateHackProgress(float CurrentProgress, float MaxProgress)
 {
 	HackProgressValue = CurrentProgress;
 	MaxHackProgressValue = MaxProgress;
+	
+	if (HUDWidget)
+	{
+		HUDWidget->SetHackProgress(CurrentProgress, MaxProgress);
+	}
 }
 
 void AGASCyberSoulsHUD::UpdateIntegrity(float CurrentIntegrity, float MaxIntegrity)
 {
 	IntegrityValue = CurrentIntegrity;
 	MaxIntegrityValue = MaxIntegrity;
+	
+	if (HUDWidget)
+	{
+		HUDWidget->SetIntegrity(CurrentIntegrity, MaxIntegrity);
+	}
 }
 
 void AGASCyberSoulsHUD::SetTargetingReticleVisible(bool bVisible)
@@ -190,34 +331,55 @@ void AGASCyberSoulsHUD::SetTargetingReticleVisible(bool bVisible)
 		CurrentTarget = nullptr;
 		CurrentTargetedBodyPart = EBodyPartType::None;
 	}
+	
+	if (HUDWidget)
+	{
+		HUDWidget->SetTargetingReticleVisible(bVisible);
+	}
+	
+	// The reticle follows the target on screen, nothing else needs a tick
+	SetActorTickEnabled(bVisible);
 }
 
 void AGASCyberSoulsHUD::SetHackProgressVisible(bool bVisible)
 {
+	if (bVisible == bHackProgressVisible)
+	{
+		return;
+	}
 	bHackProgressVisible = bVisible;
+	
+	if (HUDWidget)
+	{
+		HUDWidget->SetHackProgressVisible(bVisible);
+	}
 }
 
 void AGASCyberSoulsHUD::ShowQuickHackNotification(EQuickHackType QuickHackType, float Duration)
 {
 	// Set the text based on the QuickHack type
+	FText NotificationText;
 	switch (QuickHackType)
 	{
 		case EQuickHackType::InterruptProtocol:
-			QuickHackNotificationText = TEXT("QUICKHACK: Interrupt Protocol");
+			NotificationText = FText::FromString(TEXT("QUICKHACK: Interrupt Protocol"));
 			break;
 		case EQuickHackType::SystemFreeze:
-			QuickHackNotificationText = TEXT("QUICKHACK: System Freeze");
+			NotificationText = FText::FromString(TEXT("QUICKHACK: System Freeze"));
 			break;
 		case EQuickHackType::FirewallBarrier:
-			QuickHackNotificationText = TEXT("QUICKHACK: Firewall Barrier");
+			NotificationText = FText::FromString(TEXT("QUICKHACK: Firewall Barrier"));
 			break;
 		default:
-			QuickHackNotificationText = TEXT("QUICKHACK Activated");
+			NotificationText = FText::FromString(TEXT("QUICKHACK Activated"));
 			break;
 	}
 	
 	// Show the notification
-	bQuickHackNotificationVisible = true;
+	if (HUDWidget)
+	{
+		HUDWidget->ShowQuickHackNotification(NotificationText, QuickHackNotificationColor);
+	}
 	
 	// Set timer to hide the notification
 	GetWorldTimerManager().ClearTimer(QuickHackNotificationTimer);
@@ -232,237 +394,24 @@ void AGASCyberSoulsHUD::ShowQuickHackNotification(EQuickHackType QuickHackType,
 
 void AGASCyberSoulsHUD::HideQuickHackNotification()
 {
-	bQuickHackNotificationVisible = false;
-}
-
-void AGASCyberSoulsHUD::DrawTargetingReticle()
-{
-	if (!CurrentTarget || !Canvas)
+	if (HUDWidget)
 	{
-		return;
-	}
-	
-	// Get the screen position of the target
-	FVector TargetLocation = CurrentTarget->GetActorLocation();
-	FVector2D ScreenPosition;
-	
-	// Project the 3D position to 2D screen position
-	if (ProjectWorldLocationToScreen(TargetLocation, ScreenPosition))
-	{
-		// Use the texture or fallback to default
-		UTexture2D* TextureToUse = ReticleTexture ? ReticleTexture : DefaultReticleTexture;
-		
-		// Draw the reticle
-		DrawTexture(
-			TextureToUse,
-			ScreenPosition.X - 32.0f, // Center the texture
-			ScreenPosition.Y - 32.0f,
-			64.0f, // Width
-			64.0f, // Height
-			0.0f, 0.0f, 1.0f, 1.0f,
-			FLinearColor(1.0f, 1.0f, 1.0f, 1.0f)
-		);
+		HUDWidget->HideQuickHackNotification();
 	}
 }
 
-void AGASCyberSoulsHUD::DrawBodyPartIndicators()
+void AGASCyberSoulsHUD::UpdateReticlePosition()
 {
-	if (!CurrentTarget || !Canvas || CurrentTargetedBodyPart == EBodyPartType::None)
+	AGASCharacterBase* Target = CurrentTarget.Get();
+	if (!bTargetingReticleVisible || !Target || !HUDWidget || !PlayerOwner)
 	{
 		return;
 	}
 	
-	// Get the screen position of the target
-	FVector TargetLocation = CurrentTarget->GetActorLocation();
-	FVector2D ScreenPosition;
-	
-	// Project the 3D position to 2D screen position
-	if (ProjectWorldLocationToScreen(TargetLocation, ScreenPosition))
+	// Project into widget space so the position already accounts for DPI scale and split screen
+	FVector2D WidgetPosition;
+	if (UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(PlayerOwner, Target->GetActorLocation(), WidgetPosition, true))
 	{
-		// Determine which body part indicator to show
-		UTexture2D* TextureToUse = nullptr;
-		FVector2D Offset(0.0f, 0.0f);
-		
-		switch (CurrentTargetedBodyPart)
-		{
-			case EBodyPartType::UpperBody:
-				TextureToUse = UpperBodyTexture ? UpperBodyTexture : DefaultBodyPartTexture;
-				Offset = FVector2D(0.0f, -50.0f);
-				break;
-			case EBodyPartType::LowerBody:
-				TextureToUse = LowerBodyTexture ? LowerBodyTexture : DefaultBodyPartTexture;
-				Offset = FVector2D(0.0f, 50.0f);
-				break;
-			case EBodyPartType::LeftLeg:
-				TextureToUse = LeftLegTexture ? LeftLegTexture : DefaultBodyPartTexture;
-				Offset = FVector2D(-30.0f, 70.0f);
-				break;
-			case EBodyPartType::RightLeg:
-				TextureToUse = RightLegTexture ? RightLegTexture : DefaultBodyPartTexture;
-				Offset = FVector2D(30.0f, 70.0f);
-				break;
-			default:
-				break;
-		}
-		
-		// Draw the body part indicator
-		if (TextureToUse)
-		{
-			DrawTexture(
-				TextureToUse,
-				ScreenPosition.X + Offset.X - 16.0f, // Center the texture
-				ScreenPosition.Y + Offset.Y - 16.0f,
-				32.0f, // Width
-				32.0f, // Height
-				0.0f, 0.0f, 1.0f, 1.0f,
-				FLinearColor(1.0f, 0.0f, 0.0f, 1.0f) // Red for better visibility
-			);
-		}
+		HUDWidget->SetReticlePosition(WidgetPosition);
 	}
 }
-
-void AGASCyberSoulsHUD::DrawHackProgressBar()
-{
-	if (!Canvas)
-	{
-		return;
-	}
-	
-	// Calculate the progress percentage
-	float ProgressPercent = (MaxHackProgressValue > 0.0f) ? (HackProgressValue / MaxHackProgressValue) : 0.0f;
-	
-	// Determine color based on progress
-	FLinearColor Color;
-	if (ProgressPercent < 0.5f)
-	{
-		Color = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f); // Red
-	}
-	else if (ProgressPercent < 0.75f)
-	{
-		Color = FLinearColor(1.0f, 1.0f, 0.0f, 1.0f); // Yellow
-	}
-	else
-	{
-		Color = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f); // Red (danger zone)
-	}
-	
-	// Draw the progress bar at the top center of the screen
-	FString Text = FString::Printf(TEXT("Hack: %d%%"), FMath::RoundToInt(ProgressPercent * 100.0f));
-	DrawProgressBar(Canvas->SizeX * 0.5f - 100.0f, 50.0f, 200.0f, 20.0f, ProgressPercent, Color, Text);
-}
-
-void AGASCyberSoulsHUD::DrawIntegrityBar()
-{
-	if (!Canvas)
-	{
-		return;
-	}
-	
-	// Calculate the integrity percentage
-	float IntegrityPercent = (MaxIntegrityValue > 0.0f) ? (IntegrityValue / MaxIntegrityValue) : 0.0f;
-	
-	// Determine color based on integrity level
-	FLinearColor Color;
-	if (IntegrityPercent < 0.25f)
-	{
-		Color = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f); // Red
-	}
-	else if (IntegrityPercent < 0.5f)
-	{
-		Color = FLinearColor(1.0f, 0.5f, 0.0f, 1.0f); // Orange
-	}
-	else if (IntegrityPercent < 0.75f)
-	{
-		Color = FLinearColor(1.0f, 1.0f, 0.0f, 1.0f); // Yellow
-	}
-	else
-	{
-		Color = FLinearColor(0.0f, 1.0f, 0.0f, 1.0f); // Green
-	}
-	
-	// Draw the integrity bar at the bottom left of the screen
-	FString Text = FString::Printf(TEXT("Integrity: %d%%"), FMath::RoundToInt(IntegrityPercent * 100.0f));
-	DrawProgressBar(50.0f, Canvas->SizeY - 50.0f, 200.0f, 20.0f, IntegrityPercent, Color, Text);
-}
-
-void AGASCyberSoulsHUD::DrawQuickHackNotification()
-{
-	if (!Canvas || QuickHackNotificationText.IsEmpty())
-	{
-		return;
-	}
-	
-	// Draw the notification at the center of the screen
-	DrawText(
-		QuickHackNotificationText,
-		QuickHackNotificationColor,
-		Canvas->SizeX * 0.5f,
-		Canvas->SizeY * 0.3f,
-		GetOwningPlayerController()->GetPawnOrSpectator()->GetDefaultFontForText(),
-		1.5f, // Scale
-		true   // Center X
-	);
-}
-
-void AGASCyberSoulsHUD::DrawProgressBar(float X, float Y, float Width, float Height, float Progress, 
-                                        const FLinearColor& Color, const FString& Text)
-{
-	// Draw background
-	DrawRect(
-		FLinearColor(0.0f, 0.0f, 0.0f, 0.5f),
-		X,
-		Y,
-		Width,
-		Height
-	);
-	
-	// Draw progress
-	DrawRect(
-		Color,
-		X,
-		Y,
-		Width * Progress,
-		Height
-	);
-	
-	// Draw border
-	DrawRect(
-		FLinearColor(1.0f, 1.0f, 1.0f, 0.8f),
-		X,
-		Y,
-		Width,
-		1.0f
-	);
-	DrawRect(
-		FLinearColor(1.0f, 1.0f, 1.0f, 0.8f),
-		X,
-		Y + Height - 1.0f,
-		Width,
-		1.0f
-	);
-	DrawRect(
-		FLinearColor(1.0f, 1.0f, 1.0f, 0.8f),
-		X,
-		Y,
-		1.0f,
-		Height
-	);
-	DrawRect(
-		FLinearColor(1.0f, 1.0f, 1.0f, 0.8f),
-		X + Width - 1.0f,
-		Y,
-		1.0f,
-		Height
-	);
-	
-	// Draw text
-	DrawText(
-		Text,
-		FLinearColor(1.0f, 1.0f, 1.0f, 1.0f),
-		X + Width * 0.5f,
-		Y + 2.0f,
-		GetOwningPlayerController()->GetPawnOrSpectator()->GetDefaultFontForText(),
-		1.0f, // Scale
-		true   // Center X
-	);
-}
\ No newline at end of file
@@ -0,0 +1,256 @@
+// copyright GASCyberSouls
+
+#include "Game/GASEnemyOverlay.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASEnemyRegistry.h"
+#include "Attribute/GASAttributeSet.h"
+#include "Game/GASGameplayTagsSetup.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/Canvas.h"
+#include "SceneView.h"
+#include "RenderUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Profiling/GASStats.h"
+
+static TAutoConsoleVariable<bool> CVarEnemyOverlayEnabled(
+	TEXT("CyberSouls.EnemyOverlay.Enabled"),
+	true,
+	TEXT("Draw status bars over nearby enemies"));
+
+static TAutoConsoleVariable<int32> CVarEnemyOverlayMaxBars(
+	TEXT("CyberSouls.EnemyOverlay.MaxBars"),
+	12,
+	TEXT("Maximum number of enemy status bars drawn per frame"));
+
+static TAutoConsoleVariable<float> CVarEnemyOverlayMaxDistance(
+	TEXT("CyberSouls.EnemyOverlay.MaxDistance"),
+	3000.0f,
+	TEXT("Enemies further than this from the camera get no status bar"));
+
+static TAutoConsoleVariable<bool> CVarEnemyOverlaySortByThreat(
+	TEXT("CyberSouls.EnemyOverlay.SortByThreat"),
+	true,
+	TEXT("Rank hacking enemies before closer ones when choosing which bars to draw, otherwise rank by distance only"));
+
+namespace GASEnemyOverlay
+{
+	// Bar layout in canvas pixels
+	static constexpr float BarWidth = 64.0f;
+	static constexpr float BarHeight = 6.0f;
+	static constexpr float PipSize = 5.0f;
+	static constexpr float PipSpacing = 2.0f;
+	static constexpr float Border = 1.0f;
+	static constexpr int32 MaxPips = 5;
+
+	// World units above the capsule where the bar is anchored
+	static constexpr float HeadOffset = 30.0f;
+
+	// Fraction of MaxDistance over which bars fade out
+	static constexpr float FadeRange = 0.2f;
+
+	// Projected points slightly outside the view are kept so bars slide off screen instead of popping
+	static constexpr double ScreenMargin = 1.1;
+
+	static const FLinearColor BackgroundColor(0.0f, 0.0f, 0.0f, 0.6f);
+	static const FLinearColor IntegrityColor(0.9f, 0.15f, 0.15f, 1.0f);
+	static const FLinearColor BlockColor(0.3f, 0.6f, 1.0f, 1.0f);
+	static const FLinearColor DodgeColor(0.4f, 1.0f, 0.4f, 1.0f);
+	static const FLinearColor EmptyPipColor(0.25f, 0.25f, 0.25f, 1.0f);
+	static const FLinearColor HackColor(1.0f, 0.0f, 1.0f, 1.0f);
+
+	static uint8 ToPips(float Value)
+	{
+		return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value), 0, MaxPips));
+	}
+
+	static FLinearColor WithAlpha(FLinearColor Color, float Alpha)
+	{
+		Color.A *= Alpha;
+		return Color;
+	}
+}
+
+FGASEnemyOverlay::FGASEnemyOverlay()
+	: Batch(FVector2D::ZeroVector, FVector2D::ZeroVector, FVector2D::ZeroVector, nullptr)
+{
+	Batch.BlendMode = SE_BLEND_Translucent;
+	Batch.TriangleList.Reset();
+}
+
+void FGASEnemyOverlay::Draw(UCanvas* Canvas, const UWorld* World, const AActor* LockedTarget)
+{
+	CYBERSOULS_SCOPED_STAT(EnemyOverlay);
+
+	if (!CVarEnemyOverlayEnabled.GetValueOnGameThread() || !Canvas || !Canvas->Canvas || !Canvas->SceneView)
+	{
+		return;
+	}
+
+	VisibleEnemies.Reset();
+	GatherVisibleEnemies(Canvas, World, LockedTarget);
+
+	// Only the top N are drawn, so only sort when there are more candidates than slots
+	const int32 MaxBars = FMath::Max(CVarEnemyOverlayMaxBars.GetValueOnGameThread(), 0);
+	if (VisibleEnemies.Num() > MaxBars)
+	{
+		VisibleEnemies.Sort([](const FVisibleEnemy& A, const FVisibleEnemy& B)
+		{
+			return A.SortKey < B.SortKey;
+		});
+		VisibleEnemies.SetNum(MaxBars, EAllowShrinking::No);
+	}
+
+	if (VisibleEnemies.Num() == 0)
+	{
+		return;
+	}
+
+	Batch.TriangleList.Reset();
+	for (const FVisibleEnemy& Enemy : VisibleEnemies)
+	{
+		AddStatusBar(Enemy);
+	}
+
+	Batch.Texture = GWhiteTexture;
+	Canvas->DrawItem(Batch);
+
+	CYBERSOULS_INC_COUNTER(EnemyOverlayBars, VisibleEnemies.Num());
+}
+
+void FGASEnemyOverlay::GatherVisibleEnemies(const UCanvas* Canvas, const UWorld* World, const AActor* LockedTarget)
+{
+	const UGASEnemyRegistry* Registry = World ? World->GetSubsystem<UGASEnemyRegistry>() : nullptr;
+	if (!Registry)
+	{
+		return;
+	}
+
+	// One matrix for the whole pass, the same transform UCanvas::Project applies per call
+	const FSceneView* View = Canvas->SceneView;
+	const FMatrix ViewProjection = View->ViewMatrices.GetViewProjectionMatrix();
+	const FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+
+	const float MaxDistance = FMath::Max(CVarEnemyOverlayMaxDistance.GetValueOnGameThread(), 1.0f);
+	const float MaxDistanceSq = FMath::Square(MaxDistance);
+	const bool bSortByThreat = CVarEnemyOverlaySortByThreat.GetValueOnGameThread();
+	const double HalfWidth = Canvas->ClipX * 0.5;
+	const double HalfHeight = Canvas->ClipY * 0.5;
+
+	for (const AGASEnemyCharacter* Enemy : Registry->GetEnemies())
+	{
+		if (!Enemy || Enemy->IsHidden())
+		{
+			continue;
+		}
+
+		const FVector Anchor = Enemy->GetActorLocation() + FVector(0.0f, 0.0f, Enemy->GetSimpleCollisionHalfHeight() + GASEnemyOverlay::HeadOffset);
+		const float DistanceSq = FVector::DistSquared(ViewOrigin, Anchor);
+		if (DistanceSq > MaxDistanceSq)
+		{
+			continue;
+		}
+
+		// Behind the camera
+		const FVector4 Clip = ViewProjection.TransformFVector4(FVector4(Anchor, 1.0f));
+		if (Clip.W <= UE_KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		// Off screen
+		const double NdcX = Clip.X / Clip.W;
+		const double NdcY = Clip.Y / Clip.W;
+		if (FMath::Abs(NdcX) > GASEnemyOverlay::ScreenMargin || FMath::Abs(NdcY) > GASEnemyOverlay::ScreenMargin)
+		{
+			continue;
+		}
+
+		const UAbilitySystemComponent* ASC = Enemy->GetAbilitySystemComponent();
+		if (!ASC)
+		{
+			continue;
+		}
+
+		const float Distance = FMath::Sqrt(DistanceSq);
+		const float MaxIntegrity = ASC->GetNumericAttribute(UGASAttributeSet::GetMaxIntegrityAttribute());
+
+		FVisibleEnemy& Visible = VisibleEnemies.AddDefaulted_GetRef();
+		Visible.ScreenPosition = FVector2D(HalfWidth * (1.0 + NdcX), HalfHeight * (1.0 - NdcY));
+		Visible.Alpha = FMath::Clamp((MaxDistance - Distance) / (MaxDistance * GASEnemyOverlay::FadeRange), 0.0f, 1.0f);
+		Visible.IntegrityFraction = MaxIntegrity > 0.0f ? FMath::Clamp(ASC->GetNumericAttribute(UGASAttributeSet::GetIntegrityAttribute()) / MaxIntegrity, 0.0f, 1.0f) : 0.0f;
+		Visible.BlockCharges = GASEnemyOverlay::ToPips(ASC->GetNumericAttribute(UGASAttributeSet::GetBlockChargeAttribute()));
+		Visible.MaxBlockCharges = GASEnemyOverlay::ToPips(ASC->GetNumericAttribute(UGASAttributeSet::GetMaxBlockChargeAttribute()));
+		Visible.DodgeCharges = GASEnemyOverlay::ToPips(ASC->GetNumericAttribute(UGASAttributeSet::GetDodgeChargeAttribute()));
+		Visible.MaxDodgeCharges = GASEnemyOverlay::ToPips(ASC->GetNumericAttribute(UGASAttributeSet::GetMaxDodgeChargeAttribute()));
+		Visible.bHacking = ASC->HasMatchingGameplayTag(TAG_State_Hacking);
+
+		// Lower keys are drawn first when the cap is hit: locked target, then hacking enemies, then the closest
+		Visible.SortKey = Distance;
+		if (bSortByThreat && Visible.bHacking)
+		{
+			Visible.SortKey -= MaxDistance;
+		}
+		if (Enemy == LockedTarget)
+		{
+			Visible.SortKey -= 2.0f * MaxDistance;
+			Visible.Alpha = 1.0f;
+		}
+	}
+}
+
+void FGASEnemyOverlay::AddStatusBar(const FVisibleEnemy& Enemy)
+{
+	using namespace GASEnemyOverlay;
+
+	const float Alpha = Enemy.Alpha;
+	if (Alpha <= 0.0f)
+	{
+		return;
+	}
+
+	// Integrity bar centered over the anchor
+	const FVector2D BarMin(Enemy.ScreenPosition.X - BarWidth * 0.5f, Enemy.ScreenPosition.Y - BarHeight);
+	const FVector2D BarMax(BarMin.X + BarWidth, Enemy.ScreenPosition.Y);
+	AddQuad(BarMin - FVector2D(Border, Border), BarMax + FVector2D(Border, Border), WithAlpha(BackgroundColor, Alpha));
+	if (Enemy.IntegrityFraction > 0.0f)
+	{
+		AddQuad(BarMin, FVector2D(BarMin.X + BarWidth * Enemy.IntegrityFraction, BarMax.Y), WithAlpha(IntegrityColor, Alpha));
+	}
+
+	// Block pips from the left edge, dodge pips from the right edge, one row below the bar
+	const float PipTop = BarMax.Y + PipSpacing;
+	for (int32 Pip = 0; Pip < Enemy.MaxBlockCharges; ++Pip)
+	{
+		const FVector2D PipMin(BarMin.X + Pip * (PipSize + PipSpacing), PipTop);
+		AddQuad(PipMin, PipMin + FVector2D(PipSize, PipSize), WithAlpha(Pip < Enemy.BlockCharges ? BlockColor : EmptyPipColor, Alpha));
+	}
+	for (int32 Pip = 0; Pip < Enemy.MaxDodgeCharges; ++Pip)
+	{
+		const FVector2D PipMin(BarMax.X - PipSize - Pip * (PipSize + PipSpacing), PipTop);
+		AddQuad(PipMin, PipMin + FVector2D(PipSize, PipSize), WithAlpha(Pip < Enemy.DodgeCharges ? DodgeColor : EmptyPipColor, Alpha));
+	}
+
+	// Hack channel indicator to the left of the bar
+	if (Enemy.bHacking)
+	{
+		const float Size = BarHeight + PipSpacing + PipSize;
+		const FVector2D HackMin(BarMin.X - Border - PipSpacing - Size, BarMin.Y);
+		AddQuad(HackMin, HackMin + FVector2D(Size, Size), WithAlpha(HackColor, Alpha));
+	}
+}
+
+void FGASEnemyOverlay::AddQuad(const FVector2D& Min, const FVector2D& Max, const FLinearColor& Color)
+{
+	FCanvasUVTri Upper;
+	Upper.V0_Pos = Min;
+	Upper.V1_Pos = FVector2D(Max.X, Min.Y);
+	Upper.V2_Pos = Max;
+	Upper.V0_UV = Upper.V1_UV = Upper.V2_UV = FVector2D::ZeroVector;
+	Upper.V0_Color = Upper.V1_Color = Upper.V2_Color = Color;
+	Batch.TriangleList.Add(Upper);
+
+	FCanvasUVTri Lower = Upper;
+	Lower.V1_Pos = Max;
+	Lower.V2_Pos = FVector2D(Min.X, Max.Y);
+	Batch.TriangleList.Add(Lower);
+}
@@ -0,0 +1,200 @@
+// copyright GASCyberSouls
+
+#include "Game/GASFloatingCombatText.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "GameFramework/Actor.h"
+#include "SceneView.h"
+#include "HAL/IConsoleManager.h"
+#include "Profiling/GASStats.h"
+
+static TAutoConsoleVariable<bool> CVarFloatingCombatTextEnabled(
+	TEXT("CyberSouls.FloatingCombatText.Enabled"),
+	true,
+	TEXT("Show floating combat text for hits, blocks, dodges and hack ticks"));
+
+namespace GASFloatingCombatText
+{
+	// Seconds an entry stays on screen, the last FadeTime of it fading out
+	static constexpr float Lifetime = 1.2f;
+	static constexpr float FadeTime = 0.4f;
+
+	// Repeats on the same target and outcome within this window add to the existing number
+	static constexpr float MergeWindow = 0.35f;
+
+	// Canvas pixels per second the text rises
+	static constexpr float RiseSpeed = 60.0f;
+
+	// World units above the target's origin where entries spawn
+	static constexpr float SpawnHeight = 100.0f;
+
+	// Entries for the same target are spread horizontally so they do not stack exactly
+	static constexpr float MaxHorizontalOffset = 24.0f;
+
+	// Numbers above this are shown clamped so the text cache stays bounded
+	static constexpr int32 MaxDisplayedValue = 9999;
+
+	static const FLinearColor HitColor(1.0f, 0.85f, 0.3f, 1.0f);
+	static const FLinearColor BlockedColor(0.3f, 0.6f, 1.0f, 1.0f);
+	static const FLinearColor DodgedColor(0.4f, 1.0f, 0.4f, 1.0f);
+	static const FLinearColor HackColor(1.0f, 0.0f, 1.0f, 1.0f);
+
+	static bool IsDisplayed(EGASCombatOutcome Outcome)
+	{
+		return Outcome == EGASCombatOutcome::Hit
+			|| Outcome == EGASCombatOutcome::Blocked
+			|| Outcome == EGASCombatOutcome::Dodged
+			|| Outcome == EGASCombatOutcome::HackTick;
+	}
+}
+
+FGASFloatingCombatText::FGASFloatingCombatText()
+	: NextEntry(0)
+	, BlockedText(FText::FromString(TEXT("BLOCKED")))
+	, DodgedText(FText::FromString(TEXT("DODGED")))
+	, TextItem(FVector2D::ZeroVector, FText::GetEmpty(), nullptr, FLinearColor::White)
+{
+	TextItem.bCentreX = true;
+	TextItem.bCentreY = true;
+	TextItem.BlendMode = SE_BLEND_Translucent;
+}
+
+void FGASFloatingCombatText::AddEvent(const FGASCombatEvent& Event, const AActor* Target, float Now)
+{
+	using namespace GASFloatingCombatText;
+
+	if (!Target || !IsDisplayed(Event.Outcome) || !CVarFloatingCombatTextEnabled.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	// Blocks and dodges count occurrences, hits and hack ticks sum their magnitude
+	const bool bIsCount = Event.Outcome == EGASCombatOutcome::Blocked || Event.Outcome == EGASCombatOutcome::Dodged;
+	const float Amount = bIsCount ? 1.0f : Event.Magnitude;
+
+	if (FEntry* Existing = FindMergeCandidate(Event.TargetId, Event.Outcome, Now))
+	{
+		Existing->Value += Amount;
+		Existing->SpawnTime = Now;
+		return;
+	}
+
+	FEntry& Entry = Entries[NextEntry];
+	NextEntry = (NextEntry + 1) % Capacity;
+
+	Entry.WorldPosition = Target->GetActorLocation() + FVector(0.0f, 0.0f, SpawnHeight);
+	Entry.SpawnTime = Now;
+	Entry.Value = Amount;
+	Entry.TargetId = Event.TargetId;
+	Entry.HorizontalOffset = (static_cast<float>(NextEntry % 5) - 2.0f) * (MaxHorizontalOffset * 0.5f);
+	Entry.Outcome = Event.Outcome;
+	Entry.bActive = true;
+}
+
+FGASFloatingCombatText::FEntry* FGASFloatingCombatText::FindMergeCandidate(uint32 TargetId, EGASCombatOutcome Outcome, float Now)
+{
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.bActive && Entry.TargetId == TargetId && Entry.Outcome == Outcome
+			&& Now - Entry.SpawnTime <= GASFloatingCombatText::MergeWindow)
+		{
+			return &Entry;
+		}
+	}
+	return nullptr;
+}
+
+void FGASFloatingCombatText::Draw(UCanvas* Canvas, float Now)
+{
+	using namespace GASFloatingCombatText;
+
+	CYBERSOULS_SCOPED_STAT(FloatingCombatText);
+
+	if (!Canvas || !Canvas->SceneView || !GEngine)
+	{
+		return;
+	}
+
+	const FMatrix ViewProjection = Canvas->SceneView->ViewMatrices.GetViewProjectionMatrix();
+	const double HalfWidth = Canvas->ClipX * 0.5;
+	const double HalfHeight = Canvas->ClipY * 0.5;
+
+	TextItem.Font = GEngine->GetMediumFont();
+
+	int32 NumDrawn = 0;
+	for (FEntry& Entry : Entries)
+	{
+		if (!Entry.bActive)
+		{
+			continue;
+		}
+
+		const float Age = Now - Entry.SpawnTime;
+		if (Age >= Lifetime || Age < 0.0f)
+		{
+			Entry.bActive = false;
+			continue;
+		}
+
+		const FVector4 Clip = ViewProjection.TransformFVector4(FVector4(Entry.WorldPosition, 1.0f));
+		if (Clip.W <= UE_KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const double NdcX = Clip.X / Clip.W;
+		const double NdcY = Clip.Y / Clip.W;
+		if (FMath::Abs(NdcX) > 1.0 || FMath::Abs(NdcY) > 1.0)
+		{
+			continue;
+		}
+
+		const float Alpha = FMath::Clamp((Lifetime - Age) / FadeTime, 0.0f, 1.0f);
+
+		switch (Entry.Outcome)
+		{
+			case EGASCombatOutcome::Blocked:
+				TextItem.Text = BlockedText;
+				TextItem.SetColor(BlockedColor.CopyWithNewOpacity(Alpha));
+				break;
+			case EGASCombatOutcome::Dodged:
+				TextItem.Text = DodgedText;
+				TextItem.SetColor(DodgedColor.CopyWithNewOpacity(Alpha));
+				break;
+			case EGASCombatOutcome::HackTick:
+				TextItem.Text = GetNumberText(FMath::RoundToInt(Entry.Value));
+				TextItem.SetColor(HackColor.CopyWithNewOpacity(Alpha));
+				break;
+			default:
+				TextItem.Text = GetNumberText(FMath::RoundToInt(Entry.Value));
+				TextItem.SetColor(HitColor.CopyWithNewOpacity(Alpha));
+				break;
+		}
+
+		TextItem.Position = FVector2D(HalfWidth * (1.0 + NdcX) + Entry.HorizontalOffset, HalfHeight * (1.0 - NdcY) - Age * RiseSpeed);
+		Canvas->DrawItem(TextItem);
+		++NumDrawn;
+	}
+
+	CYBERSOULS_INC_COUNTER(FloatingCombatTexts, NumDrawn);
+}
+
+void FGASFloatingCombatText::Clear()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry.bActive = false;
+	}
+	NextEntry = 0;
+}
+
+const FText& FGASFloatingCombatText::GetNumberText(int32 Value)
+{
+	const int32 Clamped = FMath::Clamp(Value, 0, GASFloatingCombatText::MaxDisplayedValue);
+	if (const FText* Cached = NumberTexts.Find(Clamped))
+	{
+		return *Cached;
+	}
+	return NumberTexts.Add(Clamped, FText::AsNumber(Clamped));
+}
@@ -24,6 +24,9 @@ UE_DEFINE_GAMEPLAY_TAG(TAG_State_FirewallBarrier,              "State.FirewallBa
 UE_DEFINE_GAMEPLAY_TAG(TAG_State_PreventHackProgress,          "State.PreventHackProgress");
 UE_DEFINE_GAMEPLAY_TAG(TAG_State_ImmuneToQuickHacks,           "State.ImmuneToQuickHacks");
 
+// Events
+UE_DEFINE_GAMEPLAY_TAG(TAG_Event_Melee_Hit,                    "Event.Melee.Hit");
+
 // Cooldowns
 UE_DEFINE_GAMEPLAY_TAG(TAG_Ability_Attack_Cooldown,            "Ability.Attack.Cooldown");
 UE_DEFINE_GAMEPLAY_TAG(TAG_Ability_Block_Cooldown,             "Ability.Block.Cooldown");
@@ -0,0 +1,146 @@
+// copyright GASCyberSouls
+
+#include "Game/GASHUDRegistry.h"
+#include "Game/GASCyberSoulsHUD.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+
+AGASCyberSoulsHUD* UGASHUDRegistry::FindHUDForActor(const AActor* Actor)
+{
+	// Dedicated servers never have a HUD, every HUD update from gameplay code ends here
+#if UE_SERVER
+	return nullptr;
+#else
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	const APlayerController* PC = Cast<APlayerController>(Actor);
+	if (!PC)
+	{
+		const APawn* Pawn = Cast<APawn>(Actor);
+		PC = Cast<APlayerController>(Pawn ? Pawn->GetController() : Actor->GetInstigatorController());
+	}
+
+	// Remote players on a server have a controller but no local player
+	const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	const UGASHUDRegistry* Registry = LocalPlayer ? LocalPlayer->GetSubsystem<UGASHUDRegistry>() : nullptr;
+	return Registry ? Registry->GetHUD() : nullptr;
+#endif
+}
+
+void UGASHUDRegistry::RegisterHUD(AGASCyberSoulsHUD* HUD)
+{
+	ActiveHUD = HUD;
+}
+
+void UGASHUDRegistry::UnregisterHUD(AGASCyberSoulsHUD* HUD)
+{
+	// A HUD from the next world may already have registered
+	if (ActiveHUD.Get() == HUD)
+	{
+		ActiveHUD.Reset();
+	}
+}
+
+void UGASHUDRegistry::Deinitialize()
+{
+	ActiveHUD.Reset();
+
+	Super::Deinitialize();
+}
+
+#if !UE_SERVER
+namespace GASHUDRegistry
+{
+	// Every local player must resolve to its own HUD, both directly and through its pawn
+	static bool CheckLocalPlayers(UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		if (!GameInstance)
+		{
+			return false;
+		}
+
+		bool bPassed = true;
+		TSet<const AGASCyberSoulsHUD*> SeenHUDs;
+		for (ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
+		{
+			const APlayerController* PC = LocalPlayer ? LocalPlayer->GetPlayerController(World) : nullptr;
+			const UGASHUDRegistry* Registry = LocalPlayer ? LocalPlayer->GetSubsystem<UGASHUDRegistry>() : nullptr;
+			const AGASCyberSoulsHUD* HUD = Registry ? Registry->GetHUD() : nullptr;
+			const int32 ControllerId = LocalPlayer ? LocalPlayer->GetControllerId() : INDEX_NONE;
+
+			if (!PC || !HUD)
+			{
+				UE_LOG(LogTemp, Error, TEXT("HUD registry: local player %d has no %s"), ControllerId, PC ? TEXT("registered HUD") : TEXT("player controller"));
+				bPassed = false;
+				continue;
+			}
+
+			if (HUD->GetOwningPlayerController() != PC)
+			{
+				UE_LOG(LogTemp, Error, TEXT("HUD registry: local player %d resolves to a HUD owned by another controller"), ControllerId);
+				bPassed = false;
+			}
+
+			if (SeenHUDs.Contains(HUD))
+			{
+				UE_LOG(LogTemp, Error, TEXT("HUD registry: local player %d shares its HUD with another local player"), ControllerId);
+				bPassed = false;
+			}
+			SeenHUDs.Add(HUD);
+
+			if (PC->GetPawn() && UGASHUDRegistry::FindHUDForActor(PC->GetPawn()) != HUD)
+			{
+				UE_LOG(LogTemp, Error, TEXT("HUD registry: pawn of local player %d resolves to the wrong HUD"), ControllerId);
+				bPassed = false;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("HUD registry split-screen check %s for %d local player(s)"), bPassed ? TEXT("PASSED") : TEXT("FAILED"), GameInstance->GetNumLocalPlayers());
+		return bPassed;
+	}
+
+	// Adds a second local player when there is only one, checks every player on the next tick, then removes the added player
+	static FAutoConsoleCommandWithWorld SplitScreenCheckCommand(
+		TEXT("CyberSouls.HUD.SplitScreenCheck"),
+		TEXT("Verify every local player resolves to its own HUD through the HUD registry, adding a temporary split-screen player when needed"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			if (!GameInstance)
+			{
+				return;
+			}
+
+			TWeakObjectPtr<ULocalPlayer> AddedPlayer;
+			if (GameInstance->GetNumLocalPlayers() < 2)
+			{
+				if (APlayerController* NewPC = UGameplayStatics::CreatePlayer(World, INDEX_NONE, true))
+				{
+					AddedPlayer = NewPC->GetLocalPlayer();
+				}
+			}
+
+			TWeakObjectPtr<UWorld> WeakWorld(World);
+			World->GetTimerManager().SetTimerForNextTick([WeakWorld, AddedPlayer]()
+			{
+				UWorld* CheckWorld = WeakWorld.Get();
+				CheckLocalPlayers(CheckWorld);
+
+				if (CheckWorld && AddedPlayer.IsValid())
+				{
+					CheckWorld->GetGameInstance()->RemoveLocalPlayer(AddedPlayer.Get());
+				}
+			});
+		}));
+}
+#endif
@@ -0,0 +1,282 @@
+// copyright GASCyberSouls
+
+#include "Game/GASHUDWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/Image.h"
+#include "Components/InvalidationBox.h"
+#include "Components/Overlay.h"
+#include "Components/OverlaySlot.h"
+#include "Components/ProgressBar.h"
+#include "Components/TextBlock.h"
+#include "Engine/Texture2D.h"
+
+TSharedRef<SWidget> UGASHUDWidget::RebuildWidget()
+{
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		BuildWidgetTree();
+	}
+
+	return Super::RebuildWidget();
+}
+
+void UGASHUDWidget::BuildWidgetTree()
+{
+	UCanvasPanel* Root = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), TEXT("Root"));
+	Root->SetVisibility(ESlateVisibility::HitTestInvisible);
+	WidgetTree->RootWidget = Root;
+
+	// Integrity at the bottom left, always visible
+	IntegrityBox = CreateBar(Root, FVector2D(0.0f, 1.0f), FVector2D(50.0f, -50.0f), IntegrityBar, IntegrityLabel);
+
+	// Hack progress at the top center, hidden until a netrunner starts a hack
+	HackBox = CreateBar(Root, FVector2D(0.5f, 0.0f), FVector2D(-100.0f, 50.0f), HackBar, HackLabel);
+	HackBox->SetVisibility(ESlateVisibility::Collapsed);
+
+	// Reticle and body part indicator, moved as a whole through the box's render translation
+	ReticleBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("ReticleBox"));
+	UOverlay* ReticleOverlay = WidgetTree->ConstructWidget<UOverlay>(UOverlay::StaticClass(), TEXT("ReticleOverlay"));
+	ReticleImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("ReticleImage"));
+	ReticleImage->SetDesiredSizeOverride(FVector2D(64.0f, 64.0f));
+	BodyPartImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("BodyPartImage"));
+	BodyPartImage->SetDesiredSizeOverride(FVector2D(32.0f, 32.0f));
+	BodyPartImage->SetColorAndOpacity(FLinearColor(1.0f, 0.0f, 0.0f, 1.0f)); // Red for better visibility
+	BodyPartImage->SetVisibility(ESlateVisibility::Collapsed);
+
+	UOverlaySlot* ReticleSlot = ReticleOverlay->AddChildToOverlay(ReticleImage);
+	ReticleSlot->SetHorizontalAlignment(HAlign_Center);
+	ReticleSlot->SetVerticalAlignment(VAlign_Center);
+	UOverlaySlot* BodyPartSlot = ReticleOverlay->AddChildToOverlay(BodyPartImage);
+	BodyPartSlot->SetHorizontalAlignment(HAlign_Center);
+	BodyPartSlot->SetVerticalAlignment(VAlign_Center);
+
+	ReticleBox->SetContent(ReticleOverlay);
+	ReticleBox->SetVisibility(ESlateVisibility::Collapsed);
+	UCanvasPanelSlot* ReticleCanvasSlot = Root->AddChildToCanvas(ReticleBox);
+	ReticleCanvasSlot->SetAutoSize(true);
+	ReticleCanvasSlot->SetAlignment(FVector2D(0.5f, 0.5f));
+
+	// QuickHack notification at 30% of the screen height
+	NotificationBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("NotificationBox"));
+	NotificationLabel = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("NotificationLabel"));
+	FSlateFontInfo NotificationFont = NotificationLabel->GetFont();
+	NotificationFont.Size = 24;
+	NotificationLabel->SetFont(NotificationFont);
+	NotificationLabel->SetJustification(ETextJustify::Center);
+	NotificationBox->SetContent(NotificationLabel);
+	NotificationBox->SetVisibility(ESlateVisibility::Collapsed);
+	UCanvasPanelSlot* NotificationSlot = Root->AddChildToCanvas(NotificationBox);
+	NotificationSlot->SetAnchors(FAnchors(0.5f, 0.3f));
+	NotificationSlot->SetAlignment(FVector2D(0.5f, 0.5f));
+	NotificationSlot->SetAutoSize(true);
+}
+
+UInvalidationBox* UGASHUDWidget::CreateBar(UCanvasPanel* Root, const FVector2D& Anchor, const FVector2D& Position, TObjectPtr<UProgressBar>& OutBar, TObjectPtr<UTextBlock>& OutLabel)
+{
+	UInvalidationBox* Box = WidgetTree->ConstructWidget<UInvalidationBox>();
+	UOverlay* Overlay = WidgetTree->ConstructWidget<UOverlay>();
+
+	OutBar = WidgetTree->ConstructWidget<UProgressBar>();
+	OutBar->SetPercent(0.0f);
+	UOverlaySlot* BarSlot = Overlay->AddChildToOverlay(OutBar);
+	BarSlot->SetHorizontalAlignment(HAlign_Fill);
+	BarSlot->SetVerticalAlignment(VAlign_Fill);
+
+	OutLabel = WidgetTree->ConstructWidget<UTextBlock>();
+	FSlateFontInfo LabelFont = OutLabel->GetFont();
+	LabelFont.Size = 12;
+	OutLabel->SetFont(LabelFont);
+	UOverlaySlot* LabelSlot = Overlay->AddChildToOverlay(OutLabel);
+	LabelSlot->SetHorizontalAlignment(HAlign_Center);
+	LabelSlot->SetVerticalAlignment(VAlign_Center);
+
+	Box->SetContent(Overlay);
+
+	UCanvasPanelSlot* CanvasSlot = Root->AddChildToCanvas(Box);
+	CanvasSlot->SetAnchors(FAnchors(Anchor.X, Anchor.Y));
+	CanvasSlot->SetPosition(Position);
+	CanvasSlot->SetSize(FVector2D(200.0f, 20.0f));
+
+	return Box;
+}
+
+void UGASHUDWidget::SetIntegrity(float CurrentIntegrity, float MaxIntegrity)
+{
+	const float IntegrityPercent = (MaxIntegrity > 0.0f) ? (CurrentIntegrity / MaxIntegrity) : 0.0f;
+	const int32 DisplayPercent = FMath::RoundToInt(IntegrityPercent * 100.0f);
+	if (!IntegrityBar || DisplayPercent == DisplayedIntegrityPercent)
+	{
+		return;
+	}
+	DisplayedIntegrityPercent = DisplayPercent;
+
+	// Determine color based on integrity level
+	FLinearColor Color;
+	if (IntegrityPercent < 0.25f)
+	{
+		Color = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f); // Red
+	}
+	else if (IntegrityPercent < 0.5f)
+	{
+		Color = FLinearColor(1.0f, 0.5f, 0.0f, 1.0f); // Orange
+	}
+	else if (IntegrityPercent < 0.75f)
+	{
+		Color = FLinearColor(1.0f, 1.0f, 0.0f, 1.0f); // Yellow
+	}
+	else
+	{
+		Color = FLinearColor(0.0f, 1.0f, 0.0f, 1.0f); // Green
+	}
+
+	IntegrityBar->SetPercent(IntegrityPercent);
+	IntegrityBar->SetFillColorAndOpacity(Color);
+	IntegrityLabel->SetText(FText::FromString(FString::Printf(TEXT("Integrity: %d%%"), DisplayPercent)));
+}
+
+void UGASHUDWidget::SetHackProgress(float CurrentProgress, float MaxProgress)
+{
+	const float ProgressPercent = (MaxProgress > 0.0f) ? (CurrentProgress / MaxProgress) : 0.0f;
+	const int32 DisplayPercent = FMath::RoundToInt(ProgressPercent * 100.0f);
+	if (!HackBar || DisplayPercent == DisplayedHackPercent)
+	{
+		return;
+	}
+	DisplayedHackPercent = DisplayPercent;
+
+	// Yellow in the middle band, red otherwise (danger zone at the top)
+	const bool bMiddleBand = ProgressPercent >= 0.5f && ProgressPercent < 0.75f;
+	const FLinearColor Color = bMiddleBand ? FLinearColor(1.0f, 1.0f, 0.0f, 1.0f) : FLinearColor(1.0f, 0.0f, 0.0f, 1.0f);
+
+	HackBar->SetPercent(ProgressPercent);
+	HackBar->SetFillColorAndOpacity(Color);
+	HackLabel->SetText(FText::FromString(FString::Printf(TEXT("Hack: %d%%"), DisplayPercent)));
+}
+
+void UGASHUDWidget::SetHackProgressVisible(bool bVisible)
+{
+	if (HackBox)
+	{
+		HackBox->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
+
+void UGASHUDWidget::SetTargetingReticleVisible(bool bVisible)
+{
+	if (ReticleBox)
+	{
+		ReticleBox->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+
+	if (!bVisible)
+	{
+		SetTargetedBodyPart(EBodyPartType::None);
+		DisplayedReticlePosition = FVector2D(-1.0f, -1.0f);
+	}
+}
+
+void UGASHUDWidget::SetTargetedBodyPart(EBodyPartType BodyPart)
+{
+	if (BodyPart == DisplayedBodyPart)
+	{
+		return;
+	}
+	DisplayedBodyPart = BodyPart;
+	UpdateBodyPartImage();
+}
+
+void UGASHUDWidget::SetReticlePosition(const FVector2D& WidgetPosition)
+{
+	// Sub-pixel movement is not visible, skip the invalidation
+	if (!ReticleBox || WidgetPosition.Equals(DisplayedReticlePosition, 0.5f))
+	{
+		return;
+	}
+	DisplayedReticlePosition = WidgetPosition;
+
+	// Render translation only invalidates the transform, the cached reticle content is reused
+	ReticleBox->SetRenderTranslation(WidgetPosition);
+}
+
+void UGASHUDWidget::ShowQuickHackNotification(const FText& Text, const FLinearColor& Color)
+{
+	if (!NotificationBox)
+	{
+		return;
+	}
+
+	NotificationLabel->SetText(Text);
+	NotificationLabel->SetColorAndOpacity(FSlateColor(Color));
+	NotificationBox->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UGASHUDWidget::HideQuickHackNotification()
+{
+	if (NotificationBox)
+	{
+		NotificationBox->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void UGASHUDWidget::SetTextures(UTexture2D* Reticle, UTexture2D* UpperBody, UTexture2D* LowerBody, UTexture2D* LeftLeg, UTexture2D* RightLeg)
+{
+	ReticleTexture = Reticle;
+	UpperBodyTexture = UpperBody;
+	LowerBodyTexture = LowerBody;
+	LeftLegTexture = LeftLeg;
+	RightLegTexture = RightLeg;
+
+	if (ReticleImage && ReticleTexture)
+	{
+		ReticleImage->SetBrushFromTexture(ReticleTexture);
+		ReticleImage->SetDesiredSizeOverride(FVector2D(64.0f, 64.0f));
+	}
+
+	UpdateBodyPartImage();
+}
+
+void UGASHUDWidget::UpdateBodyPartImage()
+{
+	if (!BodyPartImage)
+	{
+		return;
+	}
+
+	UTexture2D* TextureToUse = nullptr;
+	FVector2D Offset(0.0f, 0.0f);
+
+	switch (DisplayedBodyPart)
+	{
+		case EBodyPartType::UpperBody:
+			TextureToUse = UpperBodyTexture;
+			Offset = FVector2D(0.0f, -50.0f);
+			break;
+		case EBodyPartType::LowerBody:
+			TextureToUse = LowerBodyTexture;
+			Offset = FVector2D(0.0f, 50.0f);
+			break;
+		case EBodyPartType::LeftLeg:
+			TextureToUse = LeftLegTexture;
+			Offset = FVector2D(-30.0f, 70.0f);
+			break;
+		case EBodyPartType::RightLeg:
+			TextureToUse = RightLegTexture;
+			Offset = FVector2D(30.0f, 70.0f);
+			break;
+		default:
+			break;
+	}
+
+	if (!TextureToUse)
+	{
+		BodyPartImage->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
+
+	BodyPartImage->SetBrushFromTexture(TextureToUse);
+	BodyPartImage->SetDesiredSizeOverride(FVector2D(32.0f, 32.0f));
+	BodyPartImage->SetRenderTranslation(Offset);
+	BodyPartImage->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
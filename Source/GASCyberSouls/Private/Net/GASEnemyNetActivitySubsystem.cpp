@@ -0,0 +1,184 @@
+// copyright GASCyberSouls
+
+#include "Net/GASEnemyNetActivitySubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASEnemyRegistry.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/GASReplicationGraph.h"
+#include "Profiling/GASStats.h"
+#include "Profiling/GASMemoryReport.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<bool> CVarEnemyNetActivityEnabled(
+	TEXT("CyberSouls.Net.EnemyActivity"),
+	true,
+	TEXT("Put idle enemies to net dormancy and scale the net update frequency of the rest with their combat involvement"));
+
+UGASEnemyNetActivitySubsystem::UGASEnemyNetActivitySubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASEnemyNetActivitySubsystem]
+	EvaluationInterval = 0.25f;
+	PerceptionRadius = 3000.0f;
+	CombatRadius = 1500.0f;
+	IdleSpeedSquared = 25.0f;
+	WakeLingerTime = 2.0f;
+	BackgroundFrequency = 2.0f;
+	CombatFrequency = 15.0f;
+	EngagedFrequency = 60.0f;
+}
+
+bool UGASEnemyNetActivitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGASEnemyNetActivitySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Dormancy and update rates only mean something where enemies are replicated from
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+	{
+		return;
+	}
+
+	InWorld.GetTimerManager().SetTimer(EvaluationTimerHandle, FTimerDelegate::CreateUObject(this, &UGASEnemyNetActivitySubsystem::UpdateAllEnemies), FMath::Max(EvaluationInterval, 0.05f), true);
+}
+
+void UGASEnemyNetActivitySubsystem::UpdateAllEnemies()
+{
+	CYBERSOULS_SCOPED_STAT(EnemyNetActivity);
+	LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+
+	const UGASEnemyRegistry* Registry = UGASEnemyRegistry::Get(this);
+	if (!Registry || !CVarEnemyNetActivityEnabled.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->GetPawn())
+		{
+			PlayerLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+
+	int32 NumDormant = 0;
+	for (AGASEnemyCharacter* Enemy : Registry->GetEnemies())
+	{
+		UpdateEnemy(Enemy);
+		NumDormant += IsValid(Enemy) && Enemy->NetDormancy > DORM_Awake ? 1 : 0;
+	}
+
+	CYBERSOULS_INC_COUNTER(NetDormantEnemies, NumDormant);
+}
+
+void UGASEnemyNetActivitySubsystem::UpdateEnemy(AGASEnemyCharacter* Enemy)
+{
+	if (!IsValid(Enemy) || !Enemy->HasAuthority() || !CVarEnemyNetActivityEnabled.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	float NearestPlayerDistanceSquared = MAX_flt;
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		NearestPlayerDistanceSquared = FMath::Min(NearestPlayerDistanceSquared, static_cast<float>(FVector::DistSquared(PlayerLocation, Enemy->GetActorLocation())));
+	}
+
+	const EGASEnemyNetActivity Activity = ClassifyEnemy(Enemy, NearestPlayerDistanceSquared);
+
+	// The replication graph caches the rate per actor, the default driver reads NetUpdateFrequency directly
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	UGASReplicationGraph* Graph = NetDriver ? NetDriver->GetReplicationDriver<UGASReplicationGraph>() : nullptr;
+
+	// Background enemies keep the grid's distance-scaled rate, engaged and combat ones replicate at their tier's frequency
+	if (Graph)
+	{
+		Graph->SetEnemyFixedRate(Enemy, Activity == EGASEnemyNetActivity::Engaged || Activity == EGASEnemyNetActivity::Combat);
+	}
+
+	if (Activity == EGASEnemyNetActivity::Idle)
+	{
+		if (Enemy->NetDormancy != DORM_DormantAll)
+		{
+			Enemy->SetNetDormancy(DORM_DormantAll);
+		}
+		return;
+	}
+
+	if (Enemy->NetDormancy > DORM_Awake)
+	{
+		Enemy->SetNetDormancy(DORM_Awake);
+	}
+
+	const float Frequency = Activity == EGASEnemyNetActivity::Engaged ? EngagedFrequency
+		: Activity == EGASEnemyNetActivity::Combat ? CombatFrequency
+		: BackgroundFrequency;
+
+	if (Enemy->NetUpdateFrequency == Frequency)
+	{
+		return;
+	}
+
+	const bool bRaised = Frequency > Enemy->NetUpdateFrequency;
+	Enemy->NetUpdateFrequency = Frequency;
+
+	if (Graph)
+	{
+		Graph->SetActorReplicationFrequency(Enemy, Frequency);
+	}
+
+	// Do not wait out the old, slower period when the enemy just became more important
+	if (bRaised)
+	{
+		Enemy->ForceNetUpdate();
+	}
+}
+
+EGASEnemyNetActivity UGASEnemyNetActivitySubsystem::ClassifyEnemy(const AGASEnemyCharacter* Enemy, float NearestPlayerDistanceSquared) const
+{
+	if (Enemy->IsEngaged())
+	{
+		return EGASEnemyNetActivity::Engaged;
+	}
+
+	bool bHasActiveAbility = false;
+	bool bHasActiveEffect = false;
+	if (const UAbilitySystemComponent* ASC = Enemy->GetAbilitySystemComponent())
+	{
+		for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+		{
+			if (Spec.IsActive())
+			{
+				bHasActiveAbility = true;
+				break;
+			}
+		}
+		bHasActiveEffect = ASC->GetActiveGameplayEffects().GetNumGameplayEffects() > 0;
+	}
+
+	// A wake-up from damage or an ability keeps the enemy in combat for a moment, so it does not flap back to dormant
+	const bool bRecentlyWoken = GetWorld()->GetTimeSeconds() - Enemy->GetLastNetWakeTime() < WakeLingerTime;
+
+	if (bHasActiveAbility || bHasActiveEffect || bRecentlyWoken || NearestPlayerDistanceSquared <= FMath::Square(CombatRadius))
+	{
+		return EGASEnemyNetActivity::Combat;
+	}
+
+	if (Enemy->GetVelocity().SizeSquared() > IdleSpeedSquared || NearestPlayerDistanceSquared <= FMath::Square(PerceptionRadius))
+	{
+		return EGASEnemyNetActivity::Background;
+	}
+
+	return EGASEnemyNetActivity::Idle;
+}
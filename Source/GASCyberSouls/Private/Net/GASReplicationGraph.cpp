@@ -0,0 +1,397 @@
+// copyright GASCyberSouls
+
+#include "Net/GASReplicationGraph.h"
+#include "Character/GASPlayerCharacter.h"
+#include "Character/GASTargetingComponent.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Engine/ChildConnection.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Profiling/GASStats.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<bool> CVarRepGraphEnabled(
+	TEXT("CyberSouls.RepGraph.Enabled"),
+	true,
+	TEXT("Use UGASReplicationGraph for the game net driver; read when the net driver is created"));
+
+void UGASReplicationGraphNode_OwnerRelevant::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	OwnedActors.ConditionalAdd(ActorInfo.Actor);
+}
+
+bool UGASReplicationGraphNode_OwnerRelevant::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	return OwnedActors.RemoveFast(ActorInfo.Actor);
+}
+
+void UGASReplicationGraphNode_OwnerRelevant::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	ReplicationActorList.Reset();
+
+	for (AActor* Actor : OwnedActors)
+	{
+		ReplicationActorList.ConditionalAdd(Actor);
+	}
+
+	auto AddIfReplicated = [this](AActor* Actor)
+	{
+		if (Actor && Actor->GetIsReplicated())
+		{
+			ReplicationActorList.ConditionalAdd(Actor);
+		}
+	};
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		AddIfReplicated(Viewer.InViewer);
+		AddIfReplicated(Viewer.ViewTarget);
+
+		const APlayerController* PC = Cast<APlayerController>(Viewer.InViewer);
+		if (!PC)
+		{
+			continue;
+		}
+
+		AddIfReplicated(PC->GetPawn());
+		AddIfReplicated(PC->PlayerState);
+
+		// The lock-on target, sent up by the owning client, stays relevant even when it sits outside the viewer's grid cells
+		const AGASPlayerCharacter* Player = Cast<AGASPlayerCharacter>(PC->GetPawn());
+		const UGASTargetingComponent* Targeting = Player ? Player->GetTargetingComponent() : nullptr;
+		if (Targeting)
+		{
+			AddIfReplicated(Targeting->GetCurrentTarget());
+		}
+	}
+
+	Super::GatherActorListsForConnection(Params);
+}
+
+UGASReplicationGraph::UGASReplicationGraph()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASReplicationGraph] in DefaultEngine.ini
+	GridCellSize = 5000.0f;
+	SpatialBiasX = -150000.0f;
+	SpatialBiasY = -150000.0f;
+	EnemyCullDistance = 0.0f;
+	FastSharedPathDistancePct = 0.3f;
+	FastSharedPathKBytesPerSecond = 10.0f;
+}
+
+UReplicationDriver* UGASReplicationGraph::ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
+{
+	// Only the game net driver of a game world replicates through the graph, beacons and demos keep the default path
+	if (!ForNetDriver || ForNetDriver->NetDriverName != NAME_GameNetDriver || !World || !World->IsGameWorld())
+	{
+		return nullptr;
+	}
+
+	if (!CVarRepGraphEnabled.GetValueOnGameThread() || FParse::Param(FCommandLine::Get(), TEXT("NoCyberSoulsRepGraph")))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Replication graph disabled, using default actor relevancy"));
+		return nullptr;
+	}
+
+	return NewObject<UGASReplicationGraph>(GetTransientPackage());
+}
+
+void UGASReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Explicit routing, everything else is derived from the class defaults
+	ClassRepNodePolicies.Set(AGASEnemyCharacter::StaticClass(), EGASRepNodeMapping::Spatialize_Dormancy);
+	ClassRepNodePolicies.Set(AGASPlayerCharacter::StaticClass(), EGASRepNodeMapping::AlwaysRelevant);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EGASRepNodeMapping::NotRouted);
+
+	// Per-class bytes and time in CSV captures (ReplicationGraphKBytes, ReplicationGraphMS), subclasses count towards their base
+	CSVTracker.SetImplicitClassTracking(AGASEnemyCharacter::StaticClass(), TEXT("Enemy"));
+	CSVTracker.SetImplicitClassTracking(AGASPlayerCharacter::StaticClass(), TEXT("Player"));
+	CSVTracker.SetImplicitClassTracking(APlayerState::StaticClass(), TEXT("PlayerState"));
+
+	// Native replicated classes get their settings up front, blueprint subclasses resolve through their native parent
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (!Class->IsChildOf(AActor::StaticClass())
+			|| !Class->HasAnyClassFlags(CLASS_Native)
+			|| Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			continue;
+		}
+
+		const AActor* CDO = Class->GetDefaultObject<AActor>();
+		if (!CDO || !CDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		const EGASRepNodeMapping Mapping = GetMappingPolicy(Class);
+		const bool bSpatialize = Mapping == EGASRepNodeMapping::Spatialize_Static
+			|| Mapping == EGASRepNodeMapping::Spatialize_Dynamic
+			|| Mapping == EGASRepNodeMapping::Spatialize_Dormancy;
+
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, bSpatialize);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+
+	// Distant enemies also send quantized movement through the fast shared path, engaged ones opt out in UpdateSharedReplication
+	FClassReplicationInfo& EnemyInfo = GlobalActorReplicationInfoMap.GetClassInfo(AGASEnemyCharacter::StaticClass());
+	EnemyInfo.FastSharedReplicationFunc = [](AActor* Actor)
+	{
+		return CastChecked<AGASEnemyCharacter>(Actor)->UpdateSharedReplication();
+	};
+	EnemyInfo.FastSharedReplicationFuncName = GET_FUNCTION_NAME_CHECKED(AGASEnemyCharacter, FastSharedReplication);
+
+	FastSharedPathConstants.DistanceRequirementPct = FastSharedPathDistancePct;
+	FastSharedPathConstants.MaxBitsPerFrame = static_cast<int32>(FastSharedPathKBytesPerSecond * 1024.0f * 8.0f / FMath::Max(NetDriver ? NetDriver->GetNetServerMaxTickRate() : 30, 1));
+}
+
+void UGASReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const
+{
+	const AActor* CDO = Class->GetDefaultObject<AActor>();
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(CDO->NetUpdateFrequency, 1.0f));
+
+	if (bSpatialize)
+	{
+		const bool bIsEnemy = Class->IsChildOf(AGASEnemyCharacter::StaticClass());
+		Info.SetCullDistanceSquared(bIsEnemy && EnemyCullDistance > 0.0f ? FMath::Square(EnemyCullDistance) : CDO->NetCullDistanceSquared);
+	}
+}
+
+EGASRepNodeMapping UGASReplicationGraph::GetMappingPolicy(const UClass* Class)
+{
+	if (const EGASRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+
+	const EGASRepNodeMapping Mapping = GetDefaultMappingPolicy(Class);
+	ClassRepNodePolicies.Set(Class, Mapping);
+	return Mapping;
+}
+
+EGASRepNodeMapping UGASReplicationGraph::GetDefaultMappingPolicy(const UClass* Class) const
+{
+	const AActor* CDO = Class ? Class->GetDefaultObject<AActor>() : nullptr;
+	if (!CDO || !CDO->GetIsReplicated())
+	{
+		return EGASRepNodeMapping::NotRouted;
+	}
+
+	// Controllers and other owner-only actors come from the owner's connection node
+	if (CDO->bOnlyRelevantToOwner)
+	{
+		return EGASRepNodeMapping::RelevantToOwner;
+	}
+
+	if (CDO->bAlwaysRelevant || Class->IsChildOf(APlayerState::StaticClass()))
+	{
+		return EGASRepNodeMapping::AlwaysRelevant;
+	}
+
+	return CDO->IsReplicatingMovement() ? EGASRepNodeMapping::Spatialize_Dynamic : EGASRepNodeMapping::Spatialize_Static;
+}
+
+void UGASReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(SpatialBiasX, SpatialBiasY);
+
+	// Moving actors in each cell replicate less often the farther away and further behind the viewer they are, distant ones mostly on the fast shared path
+	GridNode->CreateDynamicNodeOverride = [](UReplicationGraphNode_GridSpatialization2D* Parent)
+	{
+		return Parent->CreateChildNode<UReplicationGraphNode_DynamicSpatialFrequency>();
+	};
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	FixedRateEnemyNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(FixedRateEnemyNode);
+}
+
+void UGASReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UGASReplicationGraphNode_OwnerRelevant* OwnerNode = CreateNewNode<UGASReplicationGraphNode_OwnerRelevant>();
+	AddConnectionGraphNode(OwnerNode, RepGraphConnection);
+	OwnerNodes.Add(RepGraphConnection->NetConnection, OwnerNode);
+}
+
+void UGASReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	OwnerNodes.Remove(NetConnection);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+UGASReplicationGraphNode_OwnerRelevant* UGASReplicationGraph::FindOwnerNode(const AActor* Actor) const
+{
+	UNetConnection* Connection = Actor ? Actor->GetNetConnection() : nullptr;
+
+	// Split-screen players share their parent's connection nodes
+	if (const UChildConnection* ChildConnection = Cast<UChildConnection>(Connection))
+	{
+		Connection = ChildConnection->Parent;
+	}
+
+	const TObjectPtr<UGASReplicationGraphNode_OwnerRelevant>* OwnerNode = Connection ? OwnerNodes.Find(Connection) : nullptr;
+	return OwnerNode ? OwnerNode->Get() : nullptr;
+}
+
+void UGASReplicationGraph::RouteOwnerOnlyActors()
+{
+	for (int32 Index = OwnerOnlyActorsWithoutConnection.Num() - 1; Index >= 0; --Index)
+	{
+		AActor* Actor = OwnerOnlyActorsWithoutConnection[Index];
+		if (!IsValid(Actor))
+		{
+			OwnerOnlyActorsWithoutConnection.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (UGASReplicationGraphNode_OwnerRelevant* OwnerNode = FindOwnerNode(Actor))
+		{
+			OwnerNode->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+			OwnerOnlyActorsWithoutConnection.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void UGASReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+		case EGASRepNodeMapping::RelevantToOwner:
+			if (UGASReplicationGraphNode_OwnerRelevant* OwnerNode = FindOwnerNode(ActorInfo.GetActor()))
+			{
+				OwnerNode->NotifyAddNetworkActor(ActorInfo);
+			}
+			else
+			{
+				OwnerOnlyActorsWithoutConnection.AddUnique(ActorInfo.GetActor());
+			}
+			break;
+		case EGASRepNodeMapping::AlwaysRelevant:
+			AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Static:
+			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Dynamic:
+			GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Dormancy:
+			GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+			break;
+		default:
+			break;
+	}
+}
+
+void UGASReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+		case EGASRepNodeMapping::RelevantToOwner:
+			// The owner may have changed or gone since the actor was routed
+			OwnerOnlyActorsWithoutConnection.RemoveSingleSwap(ActorInfo.GetActor(), EAllowShrinking::No);
+			for (const TPair<TObjectPtr<UNetConnection>, TObjectPtr<UGASReplicationGraphNode_OwnerRelevant>>& OwnerNode : OwnerNodes)
+			{
+				if (OwnerNode.Value->NotifyRemoveNetworkActor(ActorInfo, false))
+				{
+					break;
+				}
+			}
+			break;
+		case EGASRepNodeMapping::AlwaysRelevant:
+			AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Static:
+			GridNode->RemoveActor_Static(ActorInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Dynamic:
+			GridNode->RemoveActor_Dynamic(ActorInfo);
+			break;
+		case EGASRepNodeMapping::Spatialize_Dormancy:
+			if (FixedRateEnemies.Remove(ActorInfo.GetActor()) > 0)
+			{
+				FixedRateEnemyNode->NotifyRemoveNetworkActor(ActorInfo);
+			}
+			else
+			{
+				GridNode->RemoveActor_Dormancy(ActorInfo);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+void UGASReplicationGraph::SetActorReplicationFrequency(AActor* Actor, float Frequency)
+{
+	FGlobalActorReplicationInfo* Info = GlobalActorReplicationInfoMap.Find(Actor);
+	if (!Info)
+	{
+		return;
+	}
+
+	const uint32 PeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(Frequency, 1.0f));
+	Info->Settings.ReplicationPeriodFrame = PeriodFrame;
+
+	// Connections copy the period when they first see the actor and never read the global setting again
+	for (UNetReplicationGraphConnection* ConnectionManager : Connections)
+	{
+		ConnectionManager->ActorInfoMap.FindOrAdd(Actor).ReplicationPeriodFrame = PeriodFrame;
+	}
+}
+
+void UGASReplicationGraph::SetEnemyFixedRate(AActor* Enemy, bool bFixedRate)
+{
+	if (!Enemy || GetMappingPolicy(Enemy->GetClass()) != EGASRepNodeMapping::Spatialize_Dormancy)
+	{
+		return;
+	}
+
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Enemy);
+	if (!GlobalInfo || FixedRateEnemies.Contains(Enemy) == bFixedRate)
+	{
+		return;
+	}
+
+	// The grid's dynamic frequency node sets each connection's rate from distance, which would override the tier
+	const FNewReplicatedActorInfo ActorInfo(Enemy);
+	if (bFixedRate)
+	{
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		FixedRateEnemyNode->NotifyAddNetworkActor(ActorInfo);
+		FixedRateEnemies.Add(Enemy);
+	}
+	else
+	{
+		FixedRateEnemyNode->NotifyRemoveNetworkActor(ActorInfo);
+		GridNode->AddActor_Dormancy(ActorInfo, *GlobalInfo);
+		FixedRateEnemies.Remove(Enemy);
+	}
+}
+
+int32 UGASReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	CYBERSOULS_SCOPED_STAT(ServerReplicateActors);
+
+	RouteOwnerOnlyActors();
+
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
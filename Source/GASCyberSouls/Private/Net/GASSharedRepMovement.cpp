@@ -0,0 +1,68 @@
+// copyright GASCyberSouls
+
+#include "Net/GASSharedRepMovement.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+FGASSharedRepMovement::FGASSharedRepMovement()
+{
+	Location = FVector::ZeroVector;
+	Velocity = FVector::ZeroVector;
+	Yaw = 0.0f;
+	MovementMode = 0;
+	TimeStamp = 0.0f;
+}
+
+bool FGASSharedRepMovement::FillForCharacter(const ACharacter* Character)
+{
+	const UCharacterMovementComponent* MovementComponent = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!MovementComponent)
+	{
+		return false;
+	}
+
+	// Based movement needs the base and a relative location, leave it to the default path
+	if (Character->GetBasedMovement().HasRelativeLocation())
+	{
+		return false;
+	}
+
+	// Quantize here as well so Equals compares what the clients would receive
+	Location = Character->GetActorLocation().GridSnap(1.0);
+	Velocity = Character->GetVelocity().GridSnap(1.0);
+	Yaw = FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Character->GetActorRotation().Yaw));
+	MovementMode = Character->GetReplicatedMovementMode();
+	TimeStamp = MovementComponent->GetServerLastTransformUpdateTimeStamp();
+	return true;
+}
+
+bool FGASSharedRepMovement::Equals(const FGASSharedRepMovement& Other) const
+{
+	// The time stamp is left out on purpose, it changes every move even when the character stands still
+	return Location == Other.Location
+		&& Velocity == Other.Velocity
+		&& Yaw == Other.Yaw
+		&& MovementMode == Other.MovementMode;
+}
+
+bool FGASSharedRepMovement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	// Whole units, 24 bits per component covers the level bounds and 20 bits any walking or falling speed
+	bOutSuccess &= SerializePackedVector<1, 24>(Location, Ar);
+	bOutSuccess &= SerializePackedVector<1, 20>(Velocity, Ar);
+
+	uint16 ShortYaw = FRotator::CompressAxisToShort(Yaw);
+	Ar << ShortYaw;
+	Ar << MovementMode;
+	Ar << TimeStamp;
+
+	if (Ar.IsLoading())
+	{
+		Yaw = FRotator::DecompressAxisFromShort(ShortYaw);
+	}
+
+	return bOutSuccess;
+}
@@ -0,0 +1,151 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASAllocationCounter.h"
+#include "HAL/PlatformAtomics.h"
+#include "Misc/CommandLine.h"
+
+static FGASCountingMalloc* GCountingMalloc = nullptr;
+
+FGASCountingMalloc::FGASCountingMalloc(FMalloc* InInnerMalloc)
+	: InnerMalloc(InInnerMalloc)
+	, NumAllocations(0)
+{
+}
+
+void* FGASCountingMalloc::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	return InnerMalloc->Malloc(Size, Alignment);
+}
+
+void* FGASCountingMalloc::TryMalloc(SIZE_T Size, uint32 Alignment)
+{
+	NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	return InnerMalloc->TryMalloc(Size, Alignment);
+}
+
+void* FGASCountingMalloc::Realloc(void* Original, SIZE_T Size, uint32 Alignment)
+{
+	// Growing an existing block is counted as well, TArray growth is exactly what we want to see
+	if (Size > 0)
+	{
+		NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	return InnerMalloc->Realloc(Original, Size, Alignment);
+}
+
+void* FGASCountingMalloc::TryRealloc(void* Original, SIZE_T Size, uint32 Alignment)
+{
+	if (Size > 0)
+	{
+		NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	return InnerMalloc->TryRealloc(Original, Size, Alignment);
+}
+
+void FGASCountingMalloc::Free(void* Original)
+{
+	InnerMalloc->Free(Original);
+}
+
+bool FGASCountingMalloc::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return InnerMalloc->GetAllocationSize(Original, SizeOut);
+}
+
+SIZE_T FGASCountingMalloc::QuantizeSize(SIZE_T Count, uint32 Alignment)
+{
+	return InnerMalloc->QuantizeSize(Count, Alignment);
+}
+
+void FGASCountingMalloc::Trim(bool bTrimThreadCaches)
+{
+	InnerMalloc->Trim(bTrimThreadCaches);
+}
+
+void FGASCountingMalloc::SetupTLSCachesOnCurrentThread()
+{
+	InnerMalloc->SetupTLSCachesOnCurrentThread();
+}
+
+void FGASCountingMalloc::MarkTLSCachesAsUsedOnCurrentThread()
+{
+	InnerMalloc->MarkTLSCachesAsUsedOnCurrentThread();
+}
+
+void FGASCountingMalloc::MarkTLSCachesAsUnusedOnCurrentThread()
+{
+	InnerMalloc->MarkTLSCachesAsUnusedOnCurrentThread();
+}
+
+void FGASCountingMalloc::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+}
+
+void FGASCountingMalloc::InitializeStatsMetadata()
+{
+	InnerMalloc->InitializeStatsMetadata();
+}
+
+void FGASCountingMalloc::UpdateStats()
+{
+	InnerMalloc->UpdateStats();
+}
+
+void FGASCountingMalloc::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	InnerMalloc->GetAllocatorStats(OutStats);
+}
+
+void FGASCountingMalloc::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	InnerMalloc->DumpAllocatorStats(Ar);
+}
+
+bool FGASCountingMalloc::IsInternallyThreadSafe() const
+{
+	return InnerMalloc->IsInternallyThreadSafe();
+}
+
+bool FGASCountingMalloc::ValidateHeap()
+{
+	return InnerMalloc->ValidateHeap();
+}
+
+const TCHAR* FGASCountingMalloc::GetDescriptiveName()
+{
+	return InnerMalloc->GetDescriptiveName();
+}
+
+void FGASAllocationCounter::InstallFromCommandLine()
+{
+	check(IsInGameThread());
+
+	if (GCountingMalloc || !GMalloc)
+	{
+		return;
+	}
+
+	if (!FParse::Param(FCommandLine::Get(), TEXT("CyberSoulsCountAllocs")) && !FParse::Param(FCommandLine::Get(), TEXT("CyberSoulsGauntlet")))
+	{
+		return;
+	}
+
+	// Never freed: blocks allocated through the proxy may be released after shutdown. The proxy only forwards, so blocks
+	// allocated before the swap and freed after it still reach the allocator that owns them
+	GCountingMalloc = new FGASCountingMalloc(GMalloc);
+	FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), GCountingMalloc);
+
+	UE_LOG(LogTemp, Display, TEXT("Allocation counter: counting heap allocations through %s"), GCountingMalloc->GetDescriptiveName());
+}
+
+bool FGASAllocationCounter::IsInstalled()
+{
+	return GCountingMalloc != nullptr;
+}
+
+uint64 FGASAllocationCounter::GetNumAllocations()
+{
+	return GCountingMalloc ? GCountingMalloc->GetNumAllocations() : 0;
+}
@@ -0,0 +1,330 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASCombatEventLog.h"
+#include "GameFramework/Actor.h"
+#include "CoreGlobals.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<bool> CVarCombatLogEnabled(
+	TEXT("CyberSouls.CombatLog.Enabled"),
+	true,
+	TEXT("Record combat events into the binary combat log"));
+
+static TAutoConsoleVariable<int32> CVarCombatLogMaxFileKB(
+	TEXT("CyberSouls.CombatLog.MaxFileKB"),
+	16 * 1024,
+	TEXT("Size in KB after which the combat log rotates to a new file"));
+
+static TAutoConsoleVariable<int32> CVarCombatLogMaxFiles(
+	TEXT("CyberSouls.CombatLog.MaxFiles"),
+	8,
+	TEXT("Number of rotated combat log files to keep"));
+
+// How often the writer thread wakes up to drain the ring
+static constexpr uint32 CombatLogDrainIntervalMs = 50;
+
+// Number of events written to disk per write call
+static constexpr int32 CombatLogWriteBatch = 1024;
+
+FGASCombatEventRing::FGASCombatEventRing()
+{
+	for (uint32 Index = 0; Index < Capacity; ++Index)
+	{
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+
+	EnqueuePos.store(0, std::memory_order_relaxed);
+	DequeuePos.store(0, std::memory_order_relaxed);
+}
+
+bool FGASCombatEventRing::TryPush(const FGASCombatEvent& Event)
+{
+	uint32 Pos = EnqueuePos.load(std::memory_order_relaxed);
+	FSlot* Slot = nullptr;
+
+	for (;;)
+	{
+		Slot = &Slots[Pos & IndexMask];
+		const uint32 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+		const int32 Diff = static_cast<int32>(Sequence - Pos);
+
+		if (Diff == 0)
+		{
+			// Slot is free for this position, try to claim it
+			if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (Diff < 0)
+		{
+			// The writer has not caught up yet, the ring is full
+			return false;
+		}
+		else
+		{
+			// Another producer claimed this position first
+			Pos = EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	Slot->Event = Event;
+	Slot->Sequence.store(Pos + 1, std::memory_order_release);
+	return true;
+}
+
+bool FGASCombatEventRing::TryPop(FGASCombatEvent& OutEvent)
+{
+	const uint32 Pos = DequeuePos.load(std::memory_order_relaxed);
+	FSlot& Slot = Slots[Pos & IndexMask];
+	const uint32 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+
+	if (static_cast<int32>(Sequence - (Pos + 1)) < 0)
+	{
+		// Nothing published at this position yet
+		return false;
+	}
+
+	OutEvent = Slot.Event;
+	Slot.Sequence.store(Pos + Capacity, std::memory_order_release);
+	DequeuePos.store(Pos + 1, std::memory_order_relaxed);
+	return true;
+}
+
+FGASCombatEventLog& FGASCombatEventLog::Get()
+{
+	static FGASCombatEventLog Instance;
+	return Instance;
+}
+
+FGASCombatEventLog::FGASCombatEventLog()
+	: NumDroppedEvents(0)
+	, bStopRequested(false)
+	, Thread(nullptr)
+	, WakeEvent(nullptr)
+	, FileHandle(nullptr)
+	, CurrentFileBytes(0)
+	, FileSequence(0)
+{
+}
+
+FGASCombatEventLog::~FGASCombatEventLog()
+{
+	StopWriter();
+}
+
+void FGASCombatEventLog::Record(EGASCombatAbility Ability, EGASCombatOutcome Outcome, const AActor* Source, const AActor* Target,
+                                EBodyPartType BodyPart, float Magnitude)
+{
+	FGASCombatEventLog& Log = Get();
+	// Listeners are bound and unbound on the game thread, other threads must not even look at the delegate
+	const bool bBroadcast = IsInGameThread() && Log.EventRecordedDelegate.IsBound();
+	if (!bBroadcast && !CVarCombatLogEnabled.GetValueOnAnyThread())
+	{
+		return;
+	}
+
+	FGASCombatEvent Event;
+	Event.Timestamp = FPlatformTime::Seconds() - GStartTime;
+	Event.SourceId = Source ? Source->GetUniqueID() : 0;
+	Event.TargetId = Target ? Target->GetUniqueID() : 0;
+	Event.Magnitude = Magnitude;
+	Event.Ability = Ability;
+	Event.BodyPart = BodyPart;
+	Event.Outcome = Outcome;
+
+	if (bBroadcast)
+	{
+		Log.EventRecordedDelegate.Broadcast(Event, Source, Target);
+	}
+
+	if (CVarCombatLogEnabled.GetValueOnAnyThread() && !Log.Ring.TryPush(Event))
+	{
+		Log.NumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FGASCombatEventLog::StartWriter()
+{
+	if (Thread || IsRunningCommandlet() || FParse::Param(FCommandLine::Get(), TEXT("NoCombatLog")))
+	{
+		return;
+	}
+
+	SessionStamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	FileSequence = 0;
+	bStopRequested.store(false);
+	WriteBuffer.Reserve(CombatLogWriteBatch);
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("CyberSoulsCombatLog"), 0, TPri_BelowNormal);
+}
+
+void FGASCombatEventLog::StopWriter()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FGASCombatEventLog::Stop()
+{
+	bStopRequested.store(true);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+uint32 FGASCombatEventLog::Run()
+{
+	while (!bStopRequested.load())
+	{
+		WakeEvent->Wait(CombatLogDrainIntervalMs);
+		Drain();
+	}
+
+	// Flush whatever was recorded before shutdown
+	Drain();
+	CloseFile();
+	return 0;
+}
+
+void FGASCombatEventLog::Drain()
+{
+	FGASCombatEvent Event;
+	while (Ring.TryPop(Event))
+	{
+		WriteBuffer.Add(Event);
+		if (WriteBuffer.Num() < CombatLogWriteBatch)
+		{
+			continue;
+		}
+
+		if (!FileHandle && !OpenNextFile())
+		{
+			WriteBuffer.Reset();
+			continue;
+		}
+
+		const int64 NumBytes = WriteBuffer.Num() * sizeof(FGASCombatEvent);
+		FileHandle->Write(reinterpret_cast<const uint8*>(WriteBuffer.GetData()), NumBytes);
+		CurrentFileBytes += NumBytes;
+		WriteBuffer.Reset();
+
+		if (CurrentFileBytes >= static_cast<int64>(CVarCombatLogMaxFileKB.GetValueOnAnyThread()) * 1024)
+		{
+			CloseFile();
+		}
+	}
+
+	if (WriteBuffer.Num() > 0 && (FileHandle || OpenNextFile()))
+	{
+		const int64 NumBytes = WriteBuffer.Num() * sizeof(FGASCombatEvent);
+		FileHandle->Write(reinterpret_cast<const uint8*>(WriteBuffer.GetData()), NumBytes);
+		FileHandle->Flush();
+		CurrentFileBytes += NumBytes;
+	}
+
+	WriteBuffer.Reset();
+}
+
+bool FGASCombatEventLog::OpenNextFile()
+{
+	const FString Directory = GetLogDirectory();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Directory);
+
+	const FString FileName = FPaths::Combine(Directory, FString::Printf(TEXT("CombatLog_%s_%03d.cslog"), *SessionStamp, FileSequence++));
+	FileHandle = PlatformFile.OpenWrite(*FileName);
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	const FGASCombatLogFileHeader Header;
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	CurrentFileBytes = sizeof(Header);
+
+	// Remove the oldest files past the retention count
+	TArray<FString> ExistingFiles;
+	IFileManager::Get().FindFiles(ExistingFiles, *FPaths::Combine(Directory, TEXT("*.cslog")), true, false);
+	ExistingFiles.Sort();
+
+	const int32 MaxFiles = FMath::Max(1, CVarCombatLogMaxFiles.GetValueOnAnyThread());
+	for (int32 Index = 0; Index < ExistingFiles.Num() - MaxFiles; ++Index)
+	{
+		PlatformFile.DeleteFile(*FPaths::Combine(Directory, ExistingFiles[Index]));
+	}
+
+	return true;
+}
+
+void FGASCombatEventLog::CloseFile()
+{
+	if (FileHandle)
+	{
+		FileHandle->Flush();
+		delete FileHandle;
+		FileHandle = nullptr;
+	}
+	CurrentFileBytes = 0;
+}
+
+FString FGASCombatEventLog::GetLogDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("CombatLogs"));
+}
+
+const TCHAR* FGASCombatEventLog::LexAbility(EGASCombatAbility Ability)
+{
+	switch (Ability)
+	{
+		case EGASCombatAbility::Attack:            return TEXT("Attack");
+		case EGASCombatAbility::Slash:             return TEXT("Slash");
+		case EGASCombatAbility::Block:             return TEXT("Block");
+		case EGASCombatAbility::Dodge:             return TEXT("Dodge");
+		case EGASCombatAbility::Hack:              return TEXT("Hack");
+		case EGASCombatAbility::InterruptProtocol: return TEXT("InterruptProtocol");
+		case EGASCombatAbility::SystemFreeze:      return TEXT("SystemFreeze");
+		case EGASCombatAbility::FirewallBarrier:   return TEXT("FirewallBarrier");
+		default:                                   return TEXT("None");
+	}
+}
+
+const TCHAR* FGASCombatEventLog::LexOutcome(EGASCombatOutcome Outcome)
+{
+	switch (Outcome)
+	{
+		case EGASCombatOutcome::Activated:        return TEXT("Activated");
+		case EGASCombatOutcome::Ended:            return TEXT("Ended");
+		case EGASCombatOutcome::Cancelled:        return TEXT("Cancelled");
+		case EGASCombatOutcome::Hit:              return TEXT("Hit");
+		case EGASCombatOutcome::Blocked:          return TEXT("Blocked");
+		case EGASCombatOutcome::Dodged:           return TEXT("Dodged");
+		case EGASCombatOutcome::OutOfRange:       return TEXT("OutOfRange");
+		case EGASCombatOutcome::NoTarget:         return TEXT("NoTarget");
+		case EGASCombatOutcome::HackTick:         return TEXT("HackTick");
+		case EGASCombatOutcome::HackPrevented:    return TEXT("HackPrevented");
+		case EGASCombatOutcome::QuickHackApplied: return TEXT("QuickHackApplied");
+		case EGASCombatOutcome::Missed:           return TEXT("Missed");
+		default:                                  return TEXT("None");
+	}
+}
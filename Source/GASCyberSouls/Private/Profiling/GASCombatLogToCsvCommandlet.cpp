@@ -0,0 +1,116 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASCombatLogToCsvCommandlet.h"
+#include "Profiling/GASCombatEventLog.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UGASCombatLogToCsvCommandlet::UGASCombatLogToCsvCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGASCombatLogToCsvCommandlet::Main(const FString& Params)
+{
+	// Default to every log in Saved/CombatLogs
+	FString Input = FGASCombatEventLog::GetLogDirectory();
+	FParse::Value(*Params, TEXT("Input="), Input);
+
+	FString Output = FPaths::Combine(FGASCombatEventLog::GetLogDirectory(), TEXT("CombatLog.csv"));
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	// Collect the files to convert, oldest first
+	TArray<FString> InputFiles;
+	if (IFileManager::Get().DirectoryExists(*Input))
+	{
+		IFileManager::Get().FindFiles(InputFiles, *FPaths::Combine(Input, TEXT("*.cslog")), true, false);
+		InputFiles.Sort();
+		for (FString& File : InputFiles)
+		{
+			File = FPaths::Combine(Input, File);
+		}
+	}
+	else
+	{
+		InputFiles.Add(Input);
+	}
+
+	if (InputFiles.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No combat log files found in %s"), *Input);
+		return 1;
+	}
+
+	FString Csv = TEXT("Timestamp,SourceId,TargetId,Ability,BodyPart,Outcome,Magnitude\n");
+	int32 TotalRecords = 0;
+
+	for (const FString& InputFile : InputFiles)
+	{
+		const int32 NumRecords = ConvertFile(InputFile, Csv);
+		if (NumRecords == INDEX_NONE)
+		{
+			return 1;
+		}
+		TotalRecords += NumRecords;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Output))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *Output);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Converted %d combat events from %d file(s) to %s"), TotalRecords, InputFiles.Num(), *Output);
+	return 0;
+}
+
+int32 UGASCombatLogToCsvCommandlet::ConvertFile(const FString& InputFile, FString& OutCsv) const
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InputFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to read %s"), *InputFile);
+		return INDEX_NONE;
+	}
+
+	FGASCombatLogFileHeader Header;
+	if (Bytes.Num() < static_cast<int32>(sizeof(Header)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is too small to be a combat log"), *InputFile);
+		return INDEX_NONE;
+	}
+
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+	if (Header.Magic != FGASCombatLogFileHeader::ExpectedMagic
+		|| Header.Version != FGASCombatLogFileHeader::CurrentVersion
+		|| Header.RecordSize != sizeof(FGASCombatEvent))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a version %d combat log"), *InputFile, FGASCombatLogFileHeader::CurrentVersion);
+		return INDEX_NONE;
+	}
+
+	// A file cut off mid-write may end with a partial record, which is skipped
+	const int32 NumRecords = (Bytes.Num() - sizeof(Header)) / sizeof(FGASCombatEvent);
+	const UEnum* BodyPartEnum = StaticEnum<EBodyPartType>();
+
+	for (int32 Index = 0; Index < NumRecords; ++Index)
+	{
+		FGASCombatEvent Event;
+		FMemory::Memcpy(&Event, Bytes.GetData() + sizeof(Header) + Index * sizeof(FGASCombatEvent), sizeof(Event));
+
+		OutCsv += FString::Printf(TEXT("%.6f,%u,%u,%s,%s,%s,%.3f\n"),
+			Event.Timestamp,
+			Event.SourceId,
+			Event.TargetId,
+			FGASCombatEventLog::LexAbility(Event.Ability),
+			*BodyPartEnum->GetNameStringByValue(static_cast<int64>(Event.BodyPart)),
+			FGASCombatEventLog::LexOutcome(Event.Outcome),
+			Event.Magnitude);
+	}
+
+	return NumRecords;
+}
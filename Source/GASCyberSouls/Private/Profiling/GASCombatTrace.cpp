@@ -0,0 +1,102 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASCombatTrace.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "TimerManager.h"
+
+UE_TRACE_CHANNEL_DEFINE(CyberSoulsCombatChannel)
+
+UE_TRACE_EVENT_BEGIN(CyberSoulsCombat, AbilityPhase)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, SpecHandle)
+	UE_TRACE_EVENT_FIELD(uint32, OwnerId)
+	UE_TRACE_EVENT_FIELD(uint8, Phase)
+	UE_TRACE_EVENT_FIELD(float, Magnitude)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, AbilityClass)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, OwnerName)
+UE_TRACE_EVENT_END()
+
+namespace GASCombatTrace
+{
+	// Region names must match between begin and end, so they are built from the class and owner only
+	static FString MakeRegionName(const TCHAR* Window, const UGameplayAbility* Ability, const AActor* Owner)
+	{
+		return FString::Printf(TEXT("%s %s [%s]"), Window, *Ability->GetClass()->GetName(), *GetNameSafe(Owner));
+	}
+}
+
+void FGASCombatTrace::AbilityPhase(const UGameplayAbility* Ability, EGASAbilityTracePhase Phase, float Magnitude)
+{
+#if UE_TRACE_ENABLED
+	if (!Ability || !UE_TRACE_CHANNELEXPR_IS_ENABLED(CyberSoulsCombatChannel))
+	{
+		return;
+	}
+
+	const FGameplayAbilityActorInfo* ActorInfo = Ability->GetCurrentActorInfo();
+	const AActor* Owner = ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr;
+	const FString AbilityClass = Ability->GetClass()->GetName();
+	const FString OwnerName = GetNameSafe(Owner);
+
+	UE_TRACE_LOG(CyberSoulsCombat, AbilityPhase, CyberSoulsCombatChannel)
+		<< AbilityPhase.Cycle(FPlatformTime::Cycles64())
+		<< AbilityPhase.SpecHandle(static_cast<int32>(GetTypeHash(Ability->GetCurrentAbilitySpecHandle())))
+		<< AbilityPhase.OwnerId(Owner ? Owner->GetUniqueID() : 0)
+		<< AbilityPhase.Phase(static_cast<uint8>(Phase))
+		<< AbilityPhase.Magnitude(Magnitude)
+		<< AbilityPhase.AbilityClass(*AbilityClass, AbilityClass.Len())
+		<< AbilityPhase.OwnerName(*OwnerName, OwnerName.Len());
+
+	// Lifecycle windows as timing regions so overlapping casts line up against the frame timeline
+	switch (Phase)
+	{
+		case EGASAbilityTracePhase::Activate:
+			TRACE_BEGIN_REGION(*GASCombatTrace::MakeRegionName(TEXT("Active"), Ability, Owner));
+			break;
+		case EGASAbilityTracePhase::End:
+			TRACE_END_REGION(*GASCombatTrace::MakeRegionName(TEXT("Active"), Ability, Owner));
+			break;
+		case EGASAbilityTracePhase::CastStart:
+			TRACE_BEGIN_REGION(*GASCombatTrace::MakeRegionName(TEXT("Cast"), Ability, Owner));
+			break;
+		case EGASAbilityTracePhase::CastComplete:
+		case EGASAbilityTracePhase::CastInterrupt:
+			TRACE_END_REGION(*GASCombatTrace::MakeRegionName(TEXT("Cast"), Ability, Owner));
+			break;
+		default:
+			break;
+	}
+#endif
+}
+
+void FGASCombatTrace::Cooldown(const UGameplayAbility* Ability, float Duration)
+{
+#if UE_TRACE_ENABLED
+	if (!Ability || Duration <= 0.0f || !UE_TRACE_CHANNELEXPR_IS_ENABLED(CyberSoulsCombatChannel))
+	{
+		return;
+	}
+
+	AbilityPhase(Ability, EGASAbilityTracePhase::Cooldown, Duration);
+
+	UWorld* World = Ability->GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// The ability may be gone when the cooldown ends, so the region end is owned by the world timer
+	const FGameplayAbilityActorInfo* ActorInfo = Ability->GetCurrentActorInfo();
+	const FString RegionName = GASCombatTrace::MakeRegionName(TEXT("Cooldown"), Ability, ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr);
+	TRACE_BEGIN_REGION(*RegionName);
+
+	FTimerHandle TimerHandle;
+	World->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda([RegionName]()
+	{
+		TRACE_END_REGION(*RegionName);
+	}), Duration, false);
+#endif
+}
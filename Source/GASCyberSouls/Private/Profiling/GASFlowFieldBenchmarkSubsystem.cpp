@@ -0,0 +1,370 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASFlowFieldBenchmarkSubsystem.h"
+#include "AIController.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASFlowFieldSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "TimerManager.h"
+
+namespace GASFlowFieldBenchmark
+{
+	// An enemy this close to its path point moves on to the next one
+	static constexpr float PathPointReachedDistance = 75.0f;
+
+	static const TCHAR* GetModeName(EGASChaseMode Mode)
+	{
+		return Mode == EGASChaseMode::FlowField ? TEXT("FlowField") : TEXT("PathQuery");
+	}
+}
+
+UGASFlowFieldBenchmarkSubsystem::UGASFlowFieldBenchmarkSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASFlowFieldBenchmarkSubsystem]
+	EnemyCounts = { 100, 500, 1000 };
+	bComparePathQueries = true;
+	RepathInterval = 0.5f;
+	SpawnRadius = 4000.0f;
+	TargetOrbitRadius = 1000.0f;
+	StageWarmupTime = 3.0f;
+	StageMeasureTime = 10.0f;
+	MaxAverageFlowFieldMs = 0.0f;
+
+	Random.Initialize(0x464C4F57); // Fixed seed so every run spawns the same crowd
+
+	StageIndex = INDEX_NONE;
+	bMeasuring = false;
+	SpawnOrigin = FVector::ZeroVector;
+	OrbitAngle = 0.0f;
+	NextRepathEnemy = 0;
+	PathQueryBudget = 0.0f;
+	BuildsAtStageStart = 0;
+	BuildSecondsAtStageStart = 0.0;
+}
+
+bool UGASFlowFieldBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("CyberSoulsFlowFieldBench")))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UGASFlowFieldBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UGASFlowFieldSubsystem>();
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UGASFlowFieldBenchmarkSubsystem::OnWorldPreActorTick);
+}
+
+void UGASFlowFieldBenchmarkSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+
+	Super::Deinitialize();
+}
+
+void UGASFlowFieldBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<APlayerStart> It(&InWorld); It; ++It)
+	{
+		SpawnOrigin = It->GetActorLocation();
+		break;
+	}
+
+	if (!FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Flow field benchmark: %s has no navigation system, every lookup will miss"), *InWorld.GetMapName());
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Flow field benchmark: starting on %s with %d crowd size(s)"), *InWorld.GetMapName(), EnemyCounts.Num());
+
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UGASFlowFieldBenchmarkSubsystem::StartNextStage));
+}
+
+void UGASFlowFieldBenchmarkSubsystem::StartNextStage()
+{
+	// Stages run every mode at one crowd size before moving on to the next size
+	const int32 NumModes = bComparePathQueries ? 2 : 1;
+	++StageIndex;
+	if (StageIndex >= EnemyCounts.Num() * NumModes)
+	{
+		const bool bPassed = ReportResults();
+		UE_LOG(LogTemp, Display, TEXT("Flow field benchmark: %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+		return;
+	}
+
+	FStageResult& Result = Results.AddDefaulted_GetRef();
+	Result.NumEnemies = FMath::Max(EnemyCounts[StageIndex / NumModes], 0);
+	Result.Mode = StageIndex % NumModes == 0 ? EGASChaseMode::FlowField : EGASChaseMode::PathQuery;
+
+	SpawnEnemies(Result.NumEnemies);
+
+	// Every path query stage starts from scratch, as a freshly alerted crowd would
+	for (TArray<FVector>& Path : EnemyPaths)
+	{
+		Path.Reset();
+	}
+	NextRepathEnemy = 0;
+	PathQueryBudget = 0.0f;
+
+	UE_LOG(LogTemp, Display, TEXT("Flow field benchmark: %d enemies chasing with %s, warming up for %.1fs"),
+		SpawnedEnemies.Num(), GASFlowFieldBenchmark::GetModeName(Result.Mode), StageWarmupTime);
+
+	GetWorld()->GetTimerManager().SetTimer(StageTimerHandle, FTimerDelegate::CreateUObject(this, &UGASFlowFieldBenchmarkSubsystem::StartMeasuring), FMath::Max(StageWarmupTime, 0.01f), false);
+}
+
+void UGASFlowFieldBenchmarkSubsystem::StartMeasuring()
+{
+	if (const UGASFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UGASFlowFieldSubsystem>())
+	{
+		BuildsAtStageStart = FlowFields->GetNumBuilds();
+		BuildSecondsAtStageStart = FlowFields->GetTotalBuildSeconds();
+	}
+
+	bMeasuring = true;
+	GetWorld()->GetTimerManager().SetTimer(StageTimerHandle, FTimerDelegate::CreateUObject(this, &UGASFlowFieldBenchmarkSubsystem::FinishStage), FMath::Max(StageMeasureTime, 0.01f), false);
+}
+
+void UGASFlowFieldBenchmarkSubsystem::FinishStage()
+{
+	bMeasuring = false;
+
+	// Fields are rebuilt in both modes, the player keeps moving
+	FStageResult& Result = Results.Last();
+	if (const UGASFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UGASFlowFieldSubsystem>())
+	{
+		Result.NumFieldBuilds = FlowFields->GetNumBuilds() - BuildsAtStageStart;
+		Result.FieldBuildSeconds = FlowFields->GetTotalBuildSeconds() - BuildSecondsAtStageStart;
+	}
+
+	StartNextStage();
+}
+
+void UGASFlowFieldBenchmarkSubsystem::SpawnEnemies(int32 Count)
+{
+	UWorld* World = GetWorld();
+
+	while (SpawnedEnemies.Num() < Count)
+	{
+		const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+		const float Distance = SpawnRadius * FMath::Sqrt(Random.FRandRange(0.25f, 1.0f));
+		const FVector Location = SpawnOrigin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+		const FTransform SpawnTransform(FRotator::ZeroRotator, Location);
+
+		AGASEnemyCharacter* Enemy = World->SpawnActorDeferred<AGASEnemyCharacter>(AGASEnemyCharacter::StaticClass(), SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Enemy)
+		{
+			break;
+		}
+
+		Enemy->EnemyType = EEnemyType::Basic;
+
+		// Plain controller, the benchmark moves the enemies itself instead of the chase AI
+		Enemy->AIControllerClass = AAIController::StaticClass();
+		Enemy->FinishSpawning(SpawnTransform);
+
+		// A controller is needed for movement input to be consumed
+		if (!Enemy->GetController())
+		{
+			Enemy->SpawnDefaultController();
+		}
+
+		SpawnedEnemies.Add(Enemy);
+	}
+
+	EnemyPaths.SetNum(SpawnedEnemies.Num());
+	EnemyPathPoints.SetNumZeroed(SpawnedEnemies.Num());
+}
+
+void UGASFlowFieldBenchmarkSubsystem::OnWorldPreActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TickWorld != GetWorld() || !Results.Num())
+	{
+		return;
+	}
+
+	const APlayerController* PC = TickWorld->GetFirstPlayerController();
+	APawn* Target = PC ? PC->GetPawn() : nullptr;
+	if (!Target)
+	{
+		return;
+	}
+
+	// Keep the player walking a circle, so fields are rebuilt at the rate a moving player causes
+	const float Speed = Target->GetMovementComponent() ? Target->GetMovementComponent()->GetMaxSpeed() : 0.0f;
+	OrbitAngle += DeltaSeconds * Speed / FMath::Max(TargetOrbitRadius, 1.0f);
+	const FVector OrbitPoint = SpawnOrigin + FVector(FMath::Cos(OrbitAngle), FMath::Sin(OrbitAngle), 0.0f) * TargetOrbitRadius;
+	Target->AddMovementInput((OrbitPoint - Target->GetActorLocation()).GetSafeNormal2D());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FStageResult& Result = Results.Last();
+	if (Result.Mode == EGASChaseMode::FlowField)
+	{
+		SteerWithFlowField(Target);
+	}
+	else
+	{
+		PathQueryBudget += SpawnedEnemies.Num() * DeltaSeconds / FMath::Max(RepathInterval, 0.01f);
+		SteerWithPathQueries(Target);
+	}
+
+	if (bMeasuring)
+	{
+		Result.SteeringMs.Add(static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0));
+	}
+}
+
+void UGASFlowFieldBenchmarkSubsystem::SteerWithFlowField(const APawn* Target)
+{
+	UGASFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UGASFlowFieldSubsystem>();
+	if (!FlowFields)
+	{
+		return;
+	}
+
+	for (AGASEnemyCharacter* Enemy : SpawnedEnemies)
+	{
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		// Straight at the player outside the field, as a chasing enemy without navigation would
+		FVector Direction;
+		if (!FlowFields->GetChaseDirection(Target, Enemy->GetActorLocation(), Direction))
+		{
+			Direction = (Target->GetActorLocation() - Enemy->GetActorLocation()).GetSafeNormal2D();
+		}
+		Enemy->AddMovementInput(Direction);
+	}
+}
+
+void UGASFlowFieldBenchmarkSubsystem::SteerWithPathQueries(const APawn* Target)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	const int32 NumEnemies = SpawnedEnemies.Num();
+
+	// Round robin, so each enemy repaths once per RepathInterval
+	while (NavData && NumEnemies > 0 && PathQueryBudget >= 1.0f)
+	{
+		PathQueryBudget -= 1.0f;
+
+		const int32 Index = NextRepathEnemy;
+		NextRepathEnemy = (NextRepathEnemy + 1) % NumEnemies;
+
+		const AGASEnemyCharacter* Enemy = SpawnedEnemies[Index];
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		FPathFindingQuery Query(Enemy, *NavData, Enemy->GetNavAgentLocation(), Target->GetNavAgentLocation());
+		const FPathFindingResult PathResult = NavSys->FindPathSync(Query);
+
+		TArray<FVector>& Path = EnemyPaths[Index];
+		Path.Reset();
+		if (PathResult.IsSuccessful() && PathResult.Path.IsValid())
+		{
+			for (const FNavPathPoint& Point : PathResult.Path->GetPathPoints())
+			{
+				Path.Add(Point.Location);
+			}
+		}
+		EnemyPathPoints[Index] = Path.Num() > 1 ? 1 : 0;
+
+		if (bMeasuring)
+		{
+			++Results.Last().NumPathQueries;
+		}
+	}
+
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		AGASEnemyCharacter* Enemy = SpawnedEnemies[Index];
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		const TArray<FVector>& Path = EnemyPaths[Index];
+		int32& PathPoint = EnemyPathPoints[Index];
+		while (Path.IsValidIndex(PathPoint) && FVector::DistSquared2D(Path[PathPoint], Enemy->GetActorLocation()) < FMath::Square(GASFlowFieldBenchmark::PathPointReachedDistance))
+		{
+			++PathPoint;
+		}
+
+		const FVector Goal = Path.IsValidIndex(PathPoint) ? Path[PathPoint] : Target->GetActorLocation();
+		Enemy->AddMovementInput((Goal - Enemy->GetActorLocation()).GetSafeNormal2D());
+	}
+}
+
+bool UGASFlowFieldBenchmarkSubsystem::ReportResults() const
+{
+	bool bPassed = true;
+	FString Csv = TEXT("Enemies,Mode,Frames,AverageMs,P95Ms,PeakMs,PathQueries,FieldBuilds,AverageFieldBuildMs\n");
+
+	for (const FStageResult& Result : Results)
+	{
+		const int32 NumFrames = Result.SteeringMs.Num();
+		if (NumFrames == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Flow field benchmark: no frames were recorded for %d enemies with %s"), Result.NumEnemies, GASFlowFieldBenchmark::GetModeName(Result.Mode));
+			bPassed = false;
+			continue;
+		}
+
+		float TotalMs = 0.0f;
+		float PeakMs = 0.0f;
+		for (float Ms : Result.SteeringMs)
+		{
+			TotalMs += Ms;
+			PeakMs = FMath::Max(PeakMs, Ms);
+		}
+
+		TArray<float> Sorted = Result.SteeringMs;
+		Sorted.Sort();
+		const float P95Ms = Sorted[FMath::Min(FMath::FloorToInt(NumFrames * 0.95f), NumFrames - 1)];
+		const float AverageMs = TotalMs / NumFrames;
+		const double AverageBuildMs = Result.NumFieldBuilds > 0 ? Result.FieldBuildSeconds * 1000.0 / Result.NumFieldBuilds : 0.0;
+
+		UE_LOG(LogTemp, Display, TEXT("Flow field benchmark [%s]: %d enemies, %d frames, steering avg %.3fms p95 %.3fms peak %.3fms, %d path queries, %d field builds avg %.3fms on the worker"),
+			GASFlowFieldBenchmark::GetModeName(Result.Mode), Result.NumEnemies, NumFrames, AverageMs, P95Ms, PeakMs, Result.NumPathQueries, Result.NumFieldBuilds, AverageBuildMs);
+
+		Csv += FString::Printf(TEXT("%d,%s,%d,%.4f,%.4f,%.4f,%d,%d,%.4f\n"), Result.NumEnemies, GASFlowFieldBenchmark::GetModeName(Result.Mode),
+			NumFrames, AverageMs, P95Ms, PeakMs, Result.NumPathQueries, Result.NumFieldBuilds, AverageBuildMs);
+
+		if (Result.Mode == EGASChaseMode::FlowField && MaxAverageFlowFieldMs > 0.0f && AverageMs > MaxAverageFlowFieldMs)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Flow field benchmark: steering %d enemies over budget (%.3fms > %.3fms)"), Result.NumEnemies, AverageMs, MaxAverageFlowFieldMs);
+			bPassed = false;
+		}
+	}
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("FlowFieldBenchmark"),
+		FString::Printf(TEXT("FlowFieldBenchmark_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	return bPassed;
+}
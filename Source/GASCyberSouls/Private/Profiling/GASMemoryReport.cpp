@@ -0,0 +1,244 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASMemoryReport.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "AttributeSet.h"
+#include "Character/GASTargetingComponent.h"
+#include "Combat/GASHitZoneComponent.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Enemy/GASEnemyRegistry.h"
+#include "Engine/World.h"
+#include "Game/GASCyberSoulsHUD.h"
+#include "Game/GASHUDWidget.h"
+#include "GameplayEffect.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+LLM_DEFINE_TAG(CyberSouls);
+LLM_DEFINE_TAG(CyberSouls_Abilities, NAME_None, TEXT("CyberSouls"));
+LLM_DEFINE_TAG(CyberSouls_Effects, NAME_None, TEXT("CyberSouls"));
+LLM_DEFINE_TAG(CyberSouls_Attributes, NAME_None, TEXT("CyberSouls"));
+LLM_DEFINE_TAG(CyberSouls_Targeting, NAME_None, TEXT("CyberSouls"));
+LLM_DEFINE_TAG(CyberSouls_HUD, NAME_None, TEXT("CyberSouls"));
+LLM_DEFINE_TAG(CyberSouls_Enemies, NAME_None, TEXT("CyberSouls"));
+
+namespace GASMemoryReport
+{
+	static const TCHAR* EnemiesCategory = TEXT("Enemies");
+
+	// The object and the containers it owns as counted by serializing it, the Max column of obj list. Exclusive resource size
+	// is 0 for plain UObjects and only adds memory held outside the object, e.g. render data
+	static int64 GetObjectBytes(UObject* Object)
+	{
+		return static_cast<int64>(FArchiveCountMem(Object).GetMax()) + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	// The object and everything outered to it, e.g. a widget and its widget tree
+	static int64 GetObjectBytesWithSubobjects(UObject* Object)
+	{
+		int64 NumBytes = GetObjectBytes(Object);
+		ForEachObjectWithOuter(Object, [&NumBytes](UObject* Subobject)
+		{
+			NumBytes += GetObjectBytes(Subobject);
+		}, true);
+		return NumBytes;
+	}
+
+	// Active effects live in the component's container, not in UObjects
+	static int64 GetActiveEffectBytes(const UAbilitySystemComponent* AbilitySystem)
+	{
+		return AbilitySystem ? static_cast<int64>(AbilitySystem->GetNumActiveGameplayEffects()) * sizeof(FActiveGameplayEffect) : 0;
+	}
+
+	// Templates and objects of other worlds are left out, transient effect definitions have no world at all
+	static bool IsReported(const UObject* Object, const UWorld* World, bool bAllowTransient = false)
+	{
+		if (!IsValid(Object) || Object->IsTemplate())
+		{
+			return false;
+		}
+		return Object->GetWorld() == World || (bAllowTransient && Object->IsIn(GetTransientPackage()));
+	}
+}
+
+FGASMemoryReport FGASMemoryReport::Gather(const UWorld* World)
+{
+	using namespace GASMemoryReport;
+
+	FGASMemoryReport Report;
+	if (!World)
+	{
+		return Report;
+	}
+
+	TMap<FString, int32> RowIndices;
+	auto AddToRow = [&Report, &RowIndices](const TCHAR* Category, const FString& Archetype, int32 NumObjects, int64 NumBytes)
+	{
+		const FString Key = FString::Printf(TEXT("%s/%s"), Category, *Archetype);
+		const int32* RowIndex = RowIndices.Find(Key);
+		if (!RowIndex)
+		{
+			RowIndex = &RowIndices.Add(Key, Report.Rows.Num());
+			FGASMemoryReportRow& NewRow = Report.Rows.AddDefaulted_GetRef();
+			NewRow.Category = Category;
+			NewRow.Archetype = Archetype;
+		}
+
+		FGASMemoryReportRow& Row = Report.Rows[*RowIndex];
+		Row.NumObjects += NumObjects;
+		Row.NumBytes += NumBytes;
+	};
+
+	for (TObjectIterator<UGameplayAbility> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("Abilities"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	// Definitions built at runtime by the abilities, they stay in the transient package until the next GC
+	for (TObjectIterator<UGameplayEffect> It; It; ++It)
+	{
+		if (IsReported(*It, World, true))
+		{
+			AddToRow(TEXT("Effects"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<UAbilitySystemComponent> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("Effects"), TEXT("ActiveGameplayEffect"), It->GetNumActiveGameplayEffects(), GetActiveEffectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<UAttributeSet> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("Attributes"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<UGASTargetingComponent> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("Targeting"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<UGASHitZoneComponent> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("Targeting"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<AGASCyberSoulsHUD> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("HUD"), It->GetClass()->GetName(), 1, GetObjectBytes(*It));
+		}
+	}
+
+	for (TObjectIterator<UGASHUDWidget> It; It; ++It)
+	{
+		if (IsReported(*It, World))
+		{
+			AddToRow(TEXT("HUD"), It->GetClass()->GetName(), 1, GetObjectBytesWithSubobjects(*It));
+		}
+	}
+
+	// One row per enemy type, each enemy counted with everything it owns
+	if (const UGASEnemyRegistry* Registry = UGASEnemyRegistry::Get(World))
+	{
+		for (AGASEnemyCharacter* Enemy : Registry->GetEnemies())
+		{
+			if (!IsValid(Enemy))
+			{
+				continue;
+			}
+
+			const FString Archetype = FString::Printf(TEXT("%s %s"), *Enemy->GetClass()->GetName(), *StaticEnum<EEnemyType>()->GetNameStringByValue(static_cast<int64>(Enemy->EnemyType)));
+			AddToRow(EnemiesCategory, Archetype, 1, GetObjectBytesWithSubobjects(Enemy) + GetActiveEffectBytes(Enemy->GetAbilitySystemComponent()));
+		}
+	}
+
+	Report.Rows.Sort([](const FGASMemoryReportRow& A, const FGASMemoryReportRow& B)
+	{
+		return A.Category != B.Category ? A.Category < B.Category : A.NumBytes > B.NumBytes;
+	});
+
+	return Report;
+}
+
+void FGASMemoryReport::Log() const
+{
+	UE_LOG(LogTemp, Display, TEXT("Memory report: %-10s %-48s %8s %10s %10s"), TEXT("Category"), TEXT("Archetype"), TEXT("Objects"), TEXT("TotalKB"), TEXT("AvgKB"));
+
+	int64 TotalBytes = 0;
+	for (const FGASMemoryReportRow& Row : Rows)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Memory report: %-10s %-48s %8d %10.1f %10.2f"),
+			*Row.Category, *Row.Archetype, Row.NumObjects, Row.NumBytes / 1024.0, Row.GetAverageBytes() / 1024.0);
+
+		// Enemy rows already contain their abilities, attribute sets and components
+		if (Row.Category != GASMemoryReport::EnemiesCategory)
+		{
+			TotalBytes += Row.NumBytes;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Memory report: %d rows, %.1fKB outside the enemy rows"), Rows.Num(), TotalBytes / 1024.0);
+}
+
+FString FGASMemoryReport::SaveCsv() const
+{
+	FString Csv = TEXT("Category,Archetype,Objects,Bytes,AverageBytes\n");
+	for (const FGASMemoryReportRow& Row : Rows)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%lld,%lld\n"), *Row.Category, *Row.Archetype, Row.NumObjects, Row.NumBytes, Row.GetAverageBytes());
+	}
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MemoryReports"), FString::Printf(TEXT("MemoryReport_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+	return CsvPath;
+}
+
+int64 FGASMemoryReport::GetMaxEnemyFootprint() const
+{
+	int64 MaxBytes = 0;
+	for (const FGASMemoryReportRow& Row : Rows)
+	{
+		if (Row.Category == GASMemoryReport::EnemiesCategory)
+		{
+			MaxBytes = FMath::Max(MaxBytes, Row.GetAverageBytes());
+		}
+	}
+	return MaxBytes;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs MemoryReportCommand(
+	TEXT("CyberSouls.Memory.Report"),
+	TEXT("Log UObject counts and memory footprint per archetype for abilities, effects, attribute sets, targeting, HUD and enemies. Usage: CyberSouls.Memory.Report [Csv]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const FGASMemoryReport Report = FGASMemoryReport::Gather(World);
+		Report.Log();
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Csv"), ESearchCase::IgnoreCase))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Memory report: written to %s"), *Report.SaveCsv());
+		}
+	}));
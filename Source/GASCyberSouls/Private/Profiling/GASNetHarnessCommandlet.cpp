@@ -0,0 +1,191 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASNetHarnessCommandlet.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UGASNetHarnessCommandlet::UGASNetHarnessCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGASNetHarnessCommandlet::Main(const FString& Params)
+{
+	FString Map;
+	if (!FParse::Value(*Params, TEXT("Map="), Map))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Net harness: -Map=<map> is required"));
+		return 2;
+	}
+
+	int32 NumClients = 8;
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	NumClients = FMath::Max(NumClients, 1);
+
+	int32 Port = 7777;
+	FParse::Value(*Params, TEXT("Port="), Port);
+
+	float Timeout = 600.0f;
+	FParse::Value(*Params, TEXT("Timeout="), Timeout);
+
+	// Cold starts with shader and asset loading can take minutes, the clients are only launched once the server is ready
+	float ServerStartTimeout = 300.0f;
+	FParse::Value(*Params, TEXT("ServerStartTimeout="), ServerStartTimeout);
+
+	// The commandlet host binary can run the server and the clients, a cooked server target can be passed instead
+	FString Executable = FPlatformProcess::ExecutablePath();
+	FParse::Value(*Params, TEXT("Executable="), Executable);
+
+	FString ServerArgs;
+	FParse::Value(*Params, TEXT("ServerArgs="), ServerArgs, false);
+
+	FString ClientArgs;
+	FParse::Value(*Params, TEXT("ClientArgs="), ClientArgs, false);
+
+	// Every artifact of the run shares one name under Saved/NetHarness
+	const FString RunName = FString::Printf(TEXT("NetHarness_%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+	const FString OutputDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("NetHarness")));
+	const FString ReportPath = FPaths::Combine(OutputDir, RunName + TEXT(".txt"));
+	const FString TracePath = FPaths::Combine(OutputDir, RunName + TEXT(".utrace"));
+	const FString ReadyPath = FPaths::Combine(OutputDir, RunName + TEXT(".ready"));
+	const FString Project = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	// Per-class replication cost goes to the CSV capture, per-property bandwidth to the Networking Insights trace
+	const FString ServerCommandLine = FString::Printf(
+		TEXT("\"%s\" %s -server -port=%d -nullrhi -nosound -unattended -log -abslog=\"%s\" -CyberSoulsRepBench -RepBenchReport=\"%s\" -RepBenchReadyFile=\"%s\" ")
+		TEXT("-ini:Game:[/Script/GASCyberSouls.GASRepBenchmarkSubsystem]:ExpectedClients=%d ")
+		TEXT("-csvCategories=CyberSouls,ReplicationGraph,ReplicationGraphKBytes,ReplicationGraphMS,ReplicationGraphNumReps ")
+		TEXT("-NetTrace=1 -trace=net -tracefile=\"%s\" %s"),
+		*Project, *Map, Port, *FPaths::Combine(OutputDir, RunName + TEXT("_Server.log")), *ReportPath, *ReadyPath, NumClients, *TracePath, *ServerArgs);
+
+	UE_LOG(LogTemp, Display, TEXT("Net harness: starting server on port %d"), Port);
+	FProcHandle Server = Launch(Executable, ServerCommandLine);
+	if (!Server.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Net harness: failed to launch %s"), *Executable);
+		return 2;
+	}
+
+	// The server writes the ready file once it is listening and has spawned its crowd
+	const double ServerStartTime = FPlatformTime::Seconds();
+	while (!IFileManager::Get().FileExists(*ReadyPath))
+	{
+		if (!FPlatformProcess::IsProcRunning(Server))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Net harness: server exited before it was ready, see %s"), *FPaths::Combine(OutputDir, RunName + TEXT("_Server.log")));
+			FPlatformProcess::CloseProc(Server);
+			return 2;
+		}
+		if (FPlatformTime::Seconds() - ServerStartTime > ServerStartTimeout)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Net harness: server was not ready within %.0fs"), ServerStartTimeout);
+			FPlatformProcess::TerminateProc(Server, true);
+			FPlatformProcess::CloseProc(Server);
+			return 2;
+		}
+		FPlatformProcess::Sleep(0.5f);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Net harness: server ready after %.1fs"), FPlatformTime::Seconds() - ServerStartTime);
+
+	bool bClientsFailed = false;
+	TArray<FProcHandle> Clients;
+	for (int32 Index = 0; Index < NumClients && FPlatformProcess::IsProcRunning(Server); ++Index)
+	{
+		const FString ClientCommandLine = FString::Printf(
+			TEXT("\"%s\" 127.0.0.1:%d -game -nullrhi -nosound -unattended -log -abslog=\"%s\" %s"),
+			*Project, Port, *FPaths::Combine(OutputDir, FString::Printf(TEXT("%s_Client%d.log"), *RunName, Index)), *ClientArgs);
+
+		FProcHandle Client = Launch(Executable, ClientCommandLine);
+		if (!Client.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Net harness: failed to launch client %d"), Index);
+			bClientsFailed = true;
+			continue;
+		}
+		Clients.Add(Client);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Net harness: %d clients launched, waiting for the server"), Clients.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (FPlatformProcess::IsProcRunning(Server))
+	{
+		if (FPlatformTime::Seconds() - StartTime > Timeout)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Net harness: server did not finish within %.0fs"), Timeout);
+			FPlatformProcess::TerminateProc(Server, true);
+			FPlatformProcess::CloseProc(Server);
+			StopClients(Clients);
+			return 2;
+		}
+
+		// A client that quits before the server has reported never connected or dropped out, the server's own connect
+		// timeout fails its run as well but only after waiting for it
+		if (!bClientsFailed && !IFileManager::Get().FileExists(*ReportPath))
+		{
+			for (int32 Index = 0; Index < Clients.Num(); ++Index)
+			{
+				if (!FPlatformProcess::IsProcRunning(Clients[Index]))
+				{
+					UE_LOG(LogTemp, Error, TEXT("Net harness: client %d exited while the server was still running, see %s"), Index,
+						*FPaths::Combine(OutputDir, FString::Printf(TEXT("%s_Client%d.log"), *RunName, Index)));
+					bClientsFailed = true;
+				}
+			}
+		}
+		FPlatformProcess::Sleep(1.0f);
+	}
+
+	int32 ReturnCode = 2;
+	FPlatformProcess::GetProcReturnCode(Server, &ReturnCode);
+	FPlatformProcess::CloseProc(Server);
+	StopClients(Clients);
+
+	FString Report;
+	if (FFileHelper::LoadFileToString(Report, *ReportPath))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Net harness report (%s):\n%s"), *ReportPath, *Report);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Net harness: the server wrote no report, see %s"), *FPaths::Combine(OutputDir, RunName + TEXT("_Server.log")));
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Net harness: server exited with %d, per-property bandwidth is in %s (open with Unreal Insights)"), ReturnCode, *TracePath);
+
+	IFileManager::Get().Delete(*ReadyPath, false, true, true);
+
+	if (bClientsFailed && ReturnCode == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Net harness: FAILED, not every client took part in the run"));
+		return 2;
+	}
+	return ReturnCode;
+}
+
+FProcHandle UGASNetHarnessCommandlet::Launch(const FString& Executable, const FString& Args)
+{
+	return FPlatformProcess::CreateProc(*Executable, *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+}
+
+void UGASNetHarnessCommandlet::StopClients(TArray<FProcHandle>& Clients)
+{
+	for (FProcHandle& Client : Clients)
+	{
+		if (FPlatformProcess::IsProcRunning(Client))
+		{
+			FPlatformProcess::TerminateProc(Client, true);
+		}
+		FPlatformProcess::CloseProc(Client);
+	}
+	Clients.Reset();
+}
@@ -0,0 +1,504 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASPerfGauntletSubsystem.h"
+#include "Profiling/GASAllocationCounter.h"
+#include "Profiling/GASMemoryReport.h"
+#include "Ability/GASAttackAbility.h"
+#include "Ability/GASBlockAbility.h"
+#include "Ability/GASDodgeAbility.h"
+#include "Ability/GASFirewallBarrierAbility.h"
+#include "Ability/GASHackAbility.h"
+#include "Ability/GASInterruptProtocolAbility.h"
+#include "Ability/GASSlashAbility.h"
+#include "Ability/GASSystemFreezeAbility.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Character/GASPlayerCharacter.h"
+#include "Character/GASTargetingComponent.h"
+#include "AIController.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "UObject/UObjectGlobals.h"
+
+UGASPerfGauntletSubsystem::UGASPerfGauntletSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASPerfGauntletSubsystem]
+	EnemyMix.Add(EEnemyType::Basic, 6);
+	EnemyMix.Add(EEnemyType::Block, 4);
+	EnemyMix.Add(EEnemyType::Dodge, 4);
+	EnemyMix.Add(EEnemyType::Netrunner, 3);
+	EnemyMix.Add(EEnemyType::BuffNetrunner, 2);
+	EnemyMix.Add(EEnemyType::DebuffNetrunner, 2);
+
+	Sequence = {
+		EGASGauntletStep::LockOn,
+		EGASGauntletStep::Attack,
+		EGASGauntletStep::Slash,
+		EGASGauntletStep::EnemyRound,
+		EGASGauntletStep::Dodge,
+		EGASGauntletStep::CycleTarget,
+		EGASGauntletStep::InterruptProtocol,
+		EGASGauntletStep::SystemFreeze,
+		EGASGauntletStep::EnemyRound,
+		EGASGauntletStep::FirewallBarrier,
+		EGASGauntletStep::Slash
+	};
+
+	Iterations = 10;
+	StepInterval = 0.5f;
+	WarmupTime = 2.0f;
+
+	MaxAverageGameThreadMs = 8.0f;
+	MaxPeakGameThreadMs = 20.0f;
+	MaxGCMs = 30.0f;
+	MaxAverageAllocationsPerFrame = 2000.0f;
+	MaxEnemyFootprintKB = 256.0f;
+
+	bMeasuring = false;
+	StepIndex = 0;
+	FrameStartTime = 0.0;
+	AllocationsAtFrameStart = 0;
+	GCStartTime = 0.0;
+}
+
+bool UGASPerfGauntletSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("CyberSoulsGauntlet")))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UGASPerfGauntletSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// -CyberSoulsGauntlet installs the allocation counter on module startup
+	ensureMsgf(FGASAllocationCounter::IsInstalled(), TEXT("Perf gauntlet: allocation counter not installed, allocation budgets cannot be checked"));
+
+	// The whole frame, so timers, tickable subsystems and net sends are part of the game thread time
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UGASPerfGauntletSubsystem::OnBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGASPerfGauntletSubsystem::OnEndFrame);
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UGASPerfGauntletSubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UGASPerfGauntletSubsystem::OnPostGarbageCollect);
+}
+
+void UGASPerfGauntletSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Super::Deinitialize();
+}
+
+void UGASPerfGauntletSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: starting on %s"), *InWorld.GetMapName());
+
+	// Give the player a frame to be possessed before spawning around it
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UGASPerfGauntletSubsystem::SpawnEnemies));
+}
+
+void UGASPerfGauntletSubsystem::SpawnEnemies()
+{
+	UWorld* World = GetWorld();
+	APlayerController* PC = World->GetFirstPlayerController();
+	AGASPlayerCharacter* Player = PC ? Cast<AGASPlayerCharacter>(PC->GetPawn()) : nullptr;
+	if (!Player)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: no AGASPlayerCharacter to drive, check the map's game mode"));
+		FPlatformMisc::RequestExitWithStatus(false, 2);
+		return;
+	}
+
+	GrantMissingAbilities(Player);
+
+	UClass* SpawnClass = EnemyClass.IsNull() ? AGASEnemyCharacter::StaticClass() : EnemyClass.LoadSynchronous();
+	const FVector Origin = Player->GetActorLocation();
+	const FRotator Facing = Player->GetActorRotation();
+
+	// Fixed layout so every run sees the same fight
+	int32 TotalEnemies = 0;
+	for (const TPair<EEnemyType, int32>& Entry : EnemyMix)
+	{
+		TotalEnemies += Entry.Value;
+	}
+
+	int32 SpawnIndex = 0;
+	for (const TPair<EEnemyType, int32>& Entry : EnemyMix)
+	{
+		for (int32 Count = 0; Count < Entry.Value; ++Count, ++SpawnIndex)
+		{
+			const float Alpha = TotalEnemies > 1 ? static_cast<float>(SpawnIndex) / (TotalEnemies - 1) : 0.5f;
+			const float Yaw = FMath::Lerp(-35.0f, 35.0f, Alpha);
+			const float Distance = 300.0f + (SpawnIndex % 4) * 150.0f;
+			const FVector Location = Origin + (Facing + FRotator(0.0f, Yaw, 0.0f)).Vector() * Distance;
+
+			// Enemy actor and its components, the abilities granted below get their own tag
+			LLM_SCOPE_BYTAG(CyberSouls_Enemies);
+			const FTransform SpawnTransform(Facing + FRotator(0.0f, 180.0f, 0.0f), Location);
+			AGASEnemyCharacter* Enemy = World->SpawnActorDeferred<AGASEnemyCharacter>(SpawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+			if (!Enemy)
+			{
+				continue;
+			}
+
+			Enemy->EnemyType = Entry.Key;
+
+			// Plain controller, the scripted fight keeps every enemy where it was spawned
+			Enemy->AIControllerClass = AAIController::StaticClass();
+			Enemy->FinishSpawning(SpawnTransform);
+
+			// Possession grants the enemy type abilities
+			if (!Enemy->GetController())
+			{
+				Enemy->SpawnDefaultController();
+			}
+
+			GrantEnemyAbilities(Enemy);
+			SpawnedEnemies.Add(Enemy);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: spawned %d enemies, warming up for %.1fs"), SpawnedEnemies.Num(), WarmupTime);
+
+	FTimerHandle WarmupHandle;
+	World->GetTimerManager().SetTimer(WarmupHandle, FTimerDelegate::CreateUObject(this, &UGASPerfGauntletSubsystem::StartMeasuring), FMath::Max(WarmupTime, 0.01f), false);
+}
+
+void UGASPerfGauntletSubsystem::GrantMissingAbilities(AGASPlayerCharacter* Player) const
+{
+	UAbilitySystemComponent* ASC = Player->GetAbilitySystemComponent();
+	if (!ASC || !Player->HasAuthority())
+	{
+		return;
+	}
+
+	const TSubclassOf<UGameplayAbility> PlayerAbilities[] = {
+		UGASAttackAbility::StaticClass(),
+		UGASSlashAbility::StaticClass(),
+		UGASDodgeAbility::StaticClass(),
+		UGASInterruptProtocolAbility::StaticClass(),
+		UGASSystemFreezeAbility::StaticClass(),
+		UGASFirewallBarrierAbility::StaticClass()
+	};
+
+	LLM_SCOPE_BYTAG(CyberSouls_Abilities);
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : PlayerAbilities)
+	{
+		if (!ASC->FindAbilitySpecFromClass(AbilityClass))
+		{
+			ASC->GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, INDEX_NONE, Player));
+		}
+	}
+}
+
+void UGASPerfGauntletSubsystem::GrantEnemyAbilities(AGASEnemyCharacter* Enemy) const
+{
+	UAbilitySystemComponent* ASC = Enemy->GetAbilitySystemComponent();
+	if (!ASC)
+	{
+		return;
+	}
+
+	TArray<TSubclassOf<UGameplayAbility>, TInlineAllocator<4>> Abilities;
+	Abilities.Add(UGASAttackAbility::StaticClass());
+
+	switch (Enemy->EnemyType)
+	{
+		case EEnemyType::Block:
+			Abilities.Add(UGASBlockAbility::StaticClass());
+			break;
+		case EEnemyType::Dodge:
+			Abilities.Add(UGASDodgeAbility::StaticClass());
+			break;
+		case EEnemyType::Netrunner:
+			Abilities.Add(UGASHackAbility::StaticClass());
+			break;
+		case EEnemyType::BuffNetrunner:
+			Abilities.Add(UGASHackAbility::StaticClass());
+			Abilities.Add(UGASFirewallBarrierAbility::StaticClass());
+			break;
+		case EEnemyType::DebuffNetrunner:
+			Abilities.Add(UGASHackAbility::StaticClass());
+			Abilities.Add(UGASSystemFreezeAbility::StaticClass());
+			break;
+		default:
+			break;
+	}
+
+	LLM_SCOPE_BYTAG(CyberSouls_Abilities);
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : Abilities)
+	{
+		if (!ASC->FindAbilitySpecFromClass(AbilityClass))
+		{
+			ASC->GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, INDEX_NONE, Enemy));
+		}
+	}
+}
+
+void UGASPerfGauntletSubsystem::StartMeasuring()
+{
+	const int32 NumSteps = Sequence.Num() * FMath::Max(Iterations, 1);
+	GameThreadMs.Reset(NumSteps * 64);
+	AllocationsPerFrame.Reset(NumSteps * 64);
+	GCMs.Reset();
+
+	AllocationsAtFrameStart = FGASAllocationCounter::GetNumAllocations();
+	FrameStartTime = 0.0;
+	StepIndex = 0;
+	bMeasuring = true;
+
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: running %d steps"), NumSteps);
+
+	GetWorld()->GetTimerManager().SetTimer(StepTimerHandle, FTimerDelegate::CreateUObject(this, &UGASPerfGauntletSubsystem::RunNextStep), StepInterval, true, 0.0f);
+}
+
+void UGASPerfGauntletSubsystem::RunNextStep()
+{
+	const int32 NumSteps = Sequence.Num() * FMath::Max(Iterations, 1);
+	if (StepIndex >= NumSteps)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(StepTimerHandle);
+
+		// Include a full purge in the measured window, then give it a moment to run
+		GEngine->ForceGarbageCollection(true);
+
+		FTimerHandle FinishHandle;
+		GetWorld()->GetTimerManager().SetTimer(FinishHandle, FTimerDelegate::CreateUObject(this, &UGASPerfGauntletSubsystem::FinishRun), 1.0f, false);
+		return;
+	}
+
+	ExecuteStep(Sequence[StepIndex % Sequence.Num()]);
+	++StepIndex;
+}
+
+void UGASPerfGauntletSubsystem::ExecuteStep(EGASGauntletStep Step)
+{
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	AGASPlayerCharacter* Player = PC ? Cast<AGASPlayerCharacter>(PC->GetPawn()) : nullptr;
+	if (!Player)
+	{
+		return;
+	}
+
+	UGASTargetingComponent* TargetingComp = Player->GetTargetingComponent();
+
+	switch (Step)
+	{
+		case EGASGauntletStep::LockOn:
+			if (TargetingComp && !TargetingComp->HasTarget())
+			{
+				TargetingComp->LockOnTarget();
+			}
+			break;
+		case EGASGauntletStep::Attack:
+			ActivateByTag(Player, FName("Ability.Attack"));
+			break;
+		case EGASGauntletStep::Slash:
+			ActivateByTag(Player, FName("Ability.Slash"));
+			break;
+		case EGASGauntletStep::Dodge:
+			ActivateByTag(Player, FName("Ability.Dodge"));
+			break;
+		case EGASGauntletStep::CycleTarget:
+			if (TargetingComp)
+			{
+				TargetingComp->CycleTargetRight();
+			}
+			break;
+		case EGASGauntletStep::InterruptProtocol:
+			ActivateByTag(Player, FName("Ability.QuickHack.InterruptProtocol"));
+			break;
+		case EGASGauntletStep::SystemFreeze:
+			ActivateByTag(Player, FName("Ability.QuickHack.SystemFreeze"));
+			break;
+		case EGASGauntletStep::FirewallBarrier:
+			ActivateByTag(Player, FName("Ability.QuickHack.FirewallBarrier"));
+			break;
+		case EGASGauntletStep::EnemyRound:
+			// Every enemy uses what its archetype has, netrunners keep a hack channel going
+			for (AGASEnemyCharacter* Enemy : SpawnedEnemies)
+			{
+				if (!IsValid(Enemy))
+				{
+					continue;
+				}
+
+				ActivateByTag(Enemy, FName("Ability.Attack"));
+				if (Enemy->bCanHack)
+				{
+					ActivateByTag(Enemy, FName("Ability.Hack"));
+				}
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+bool UGASPerfGauntletSubsystem::ActivateByTag(AActor* Actor, const FName& TagName)
+{
+	UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor);
+	if (!ASC)
+	{
+		return false;
+	}
+
+	FGameplayTagContainer Tags;
+	Tags.AddTag(FGameplayTag::RequestGameplayTag(TagName));
+	return ASC->TryActivateAbilitiesByTag(Tags);
+}
+
+void UGASPerfGauntletSubsystem::FinishRun()
+{
+	bMeasuring = false;
+
+	const bool bPassed = ReportResults();
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+
+	FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+}
+
+bool UGASPerfGauntletSubsystem::ReportResults() const
+{
+	const int32 NumFrames = GameThreadMs.Num();
+	if (NumFrames == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: no frames were recorded"));
+		return false;
+	}
+
+	float TotalGameThreadMs = 0.0f;
+	float PeakGameThreadMs = 0.0f;
+	for (float Ms : GameThreadMs)
+	{
+		TotalGameThreadMs += Ms;
+		PeakGameThreadMs = FMath::Max(PeakGameThreadMs, Ms);
+	}
+
+	uint64 TotalAllocations = 0;
+	for (uint32 Count : AllocationsPerFrame)
+	{
+		TotalAllocations += Count;
+	}
+
+	float PeakGCMs = 0.0f;
+	for (float Ms : GCMs)
+	{
+		PeakGCMs = FMath::Max(PeakGCMs, Ms);
+	}
+
+	const float AverageGameThreadMs = TotalGameThreadMs / NumFrames;
+	const float AverageAllocations = AllocationsPerFrame.Num() > 0 ? static_cast<float>(TotalAllocations) / AllocationsPerFrame.Num() : 0.0f;
+
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: %d frames, game thread avg %.2fms (budget %.2f) peak %.2fms (budget %.2f)"),
+		NumFrames, AverageGameThreadMs, MaxAverageGameThreadMs, PeakGameThreadMs, MaxPeakGameThreadMs);
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: %d GCs, peak %.2fms (budget %.2f)"), GCMs.Num(), PeakGCMs, MaxGCMs);
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: allocations avg %.1f per frame (budget %.1f), %llu total"), AverageAllocations, MaxAverageAllocationsPerFrame, TotalAllocations);
+
+	// Per-frame samples for offline comparison between runs
+	FString Csv = TEXT("Frame,GameThreadMs,Allocations\n");
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Csv += FString::Printf(TEXT("%d,%.3f,%u\n"), Frame, GameThreadMs[Frame], AllocationsPerFrame.IsValidIndex(Frame) ? AllocationsPerFrame[Frame] : 0u);
+	}
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PerfGauntlet"), FString::Printf(TEXT("PerfGauntlet_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"))));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	// Enemies are still alive here, so the report covers the whole fight's objects
+	const FGASMemoryReport MemoryReport = FGASMemoryReport::Gather(GetWorld());
+	MemoryReport.Log();
+	MemoryReport.SaveCsv();
+
+	const float EnemyFootprintKB = MemoryReport.GetMaxEnemyFootprint() / 1024.0f;
+	UE_LOG(LogTemp, Display, TEXT("Perf gauntlet: largest enemy footprint %.1fKB (budget %.1f)"), EnemyFootprintKB, MaxEnemyFootprintKB);
+
+	bool bPassed = true;
+	if (AverageGameThreadMs > MaxAverageGameThreadMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: average game thread time over budget"));
+		bPassed = false;
+	}
+	if (PeakGameThreadMs > MaxPeakGameThreadMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: peak game thread time over budget"));
+		bPassed = false;
+	}
+	if (PeakGCMs > MaxGCMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: GC time over budget"));
+		bPassed = false;
+	}
+	if (AverageAllocations > MaxAverageAllocationsPerFrame)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: allocations per frame over budget"));
+		bPassed = false;
+	}
+	if (EnemyFootprintKB > MaxEnemyFootprintKB)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Perf gauntlet: enemy memory footprint over budget"));
+		bPassed = false;
+	}
+
+	return bPassed;
+}
+
+void UGASPerfGauntletSubsystem::OnBeginFrame()
+{
+	if (!bMeasuring)
+	{
+		return;
+	}
+
+	// Allocations are counted for the whole previous frame, including rendering and GC work
+	const uint64 Allocations = FGASAllocationCounter::GetNumAllocations();
+	AllocationsPerFrame.Add(static_cast<uint32>(Allocations - AllocationsAtFrameStart));
+	AllocationsAtFrameStart = Allocations;
+
+	FrameStartTime = FPlatformTime::Seconds();
+}
+
+void UGASPerfGauntletSubsystem::OnEndFrame()
+{
+	if (!bMeasuring || FrameStartTime == 0.0)
+	{
+		return;
+	}
+
+	// The frame rate limiter's sleep is idle time, not game thread work
+	const double FrameSeconds = FPlatformTime::Seconds() - FrameStartTime - FApp::GetIdleTime();
+	GameThreadMs.Add(static_cast<float>(FMath::Max(FrameSeconds, 0.0) * 1000.0));
+}
+
+void UGASPerfGauntletSubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void UGASPerfGauntletSubsystem::OnPostGarbageCollect()
+{
+	if (bMeasuring && GCStartTime > 0.0)
+	{
+		GCMs.Add(static_cast<float>((FPlatformTime::Seconds() - GCStartTime) * 1000.0));
+	}
+	GCStartTime = 0.0;
+}
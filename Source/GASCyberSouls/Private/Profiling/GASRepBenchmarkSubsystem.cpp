@@ -0,0 +1,440 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASRepBenchmarkSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Attribute/GASAttributeSet.h"
+#include "AIController.h"
+#include "Enemy/GASEnemyCharacter.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "TimerManager.h"
+
+UGASRepBenchmarkSubsystem::UGASRepBenchmarkSubsystem()
+{
+	// Defaults, overridable in [/Script/GASCyberSouls.GASRepBenchmarkSubsystem]
+	EnemyCount = 500;
+	ExpectedClients = 8;
+	ConnectTimeout = 120.0f;
+	SpawnHalfExtent = 15000.0f;
+	MovingFraction = 0.25f;
+	ChangingFraction = 0.05f;
+	WarmupTime = 5.0f;
+	MeasureTime = 30.0f;
+	MaxAverageReplicationMs = 0.0f;
+	MaxBytesPerEnemyPerSecond = 0.0f;
+
+	Random.Initialize(0x52455042); // Fixed seed so every run walks the same way
+
+	bMeasuring = false;
+	SpawnOrigin = FVector::ZeroVector;
+	NextChangingEnemy = 0;
+	WaitStartTime = 0.0;
+	FlushStartTime = 0.0;
+	MeasureStartTime = 0.0;
+	MeasureEndTime = 0.0;
+	LastOutTotalBytes = 0;
+	LastOutTotalPackets = 0;
+}
+
+bool UGASRepBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("CyberSoulsRepBench")))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UGASRepBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UGASRepBenchmarkSubsystem::OnWorldPreActorTick);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UGASRepBenchmarkSubsystem::OnWorldPostActorTick);
+}
+
+void UGASRepBenchmarkSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+void UGASRepBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Clients launched with the same command line have nothing to measure
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Rep benchmark: %s is not a server, nothing to measure"), *InWorld.GetMapName());
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark: starting on %s with %s and %s"), *InWorld.GetMapName(),
+		InWorld.GetNetDriver() && InWorld.GetNetDriver()->GetReplicationDriver() ? TEXT("the replication graph") : TEXT("default relevancy"),
+		IS_PUSH_MODEL_ENABLED() ? TEXT("push model replication") : TEXT("polled property compares"));
+
+	PostTickFlushHandle = InWorld.OnPostTickFlush().AddUObject(this, &UGASRepBenchmarkSubsystem::OnPostTickFlush);
+
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UGASRepBenchmarkSubsystem::SpawnEnemies));
+}
+
+void UGASRepBenchmarkSubsystem::SpawnEnemies()
+{
+	UWorld* World = GetWorld();
+
+	SpawnOrigin = FVector::ZeroVector;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		SpawnOrigin = It->GetActorLocation();
+		break;
+	}
+
+	// Square grid, the same layout every run
+	const int32 Count = FMath::Max(EnemyCount, 0);
+	const int32 Columns = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))), 1);
+	const float Spacing = Columns > 1 ? (2.0f * SpawnHalfExtent) / (Columns - 1) : 0.0f;
+	const int32 NumMoving = FMath::RoundToInt(Count * FMath::Clamp(MovingFraction, 0.0f, 1.0f));
+
+	SpawnedEnemies.Reserve(Count);
+	MoveDirections.Reserve(NumMoving);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Location = SpawnOrigin + FVector(-SpawnHalfExtent + (Index % Columns) * Spacing, -SpawnHalfExtent + (Index / Columns) * Spacing, 0.0f);
+		const FTransform SpawnTransform(FRotator(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f), Location);
+
+		AGASEnemyCharacter* Enemy = World->SpawnActorDeferred<AGASEnemyCharacter>(AGASEnemyCharacter::StaticClass(), SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Enemy)
+		{
+			continue;
+		}
+
+		// Cycle through every archetype, skipping None
+		Enemy->EnemyType = static_cast<EEnemyType>(1 + Index % static_cast<int32>(EEnemyType::DebuffNetrunner));
+
+		// Plain controller, the benchmark moves the enemies itself instead of the chase AI
+		Enemy->AIControllerClass = AAIController::StaticClass();
+		Enemy->FinishSpawning(SpawnTransform);
+
+		// A controller is needed for movement input to be consumed
+		if (!Enemy->GetController())
+		{
+			Enemy->SpawnDefaultController();
+		}
+
+		SpawnedEnemies.Add(Enemy);
+		if (MoveDirections.Num() < NumMoving)
+		{
+			MoveDirections.Add(FRotator(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f).Vector());
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark: spawned %d enemies (%d walking), waiting for %d clients"), SpawnedEnemies.Num(), MoveDirections.Num(), ExpectedClients);
+
+	// The server is listening and the crowd is in place, -RepBenchReadyFile=<path> tells a launcher the clients can connect now
+	FString ReadyPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("RepBenchReadyFile="), ReadyPath))
+	{
+		FFileHelper::SaveStringToFile(FString::Printf(TEXT("%d\n"), SpawnedEnemies.Num()), *ReadyPath);
+	}
+
+	WaitStartTime = FPlatformTime::Seconds();
+	World->GetTimerManager().SetTimer(WaitTimerHandle, FTimerDelegate::CreateUObject(this, &UGASRepBenchmarkSubsystem::WaitForClients), 1.0f, true);
+
+	if (ChangingFraction > 0.0f)
+	{
+		World->GetTimerManager().SetTimer(ChangeTimerHandle, FTimerDelegate::CreateUObject(this, &UGASRepBenchmarkSubsystem::ChangeEnemyState), 1.0f, true);
+	}
+}
+
+void UGASRepBenchmarkSubsystem::WaitForClients()
+{
+	const int32 NumClients = GetNumClients();
+	if (NumClients >= ExpectedClients)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(WaitTimerHandle);
+
+		UE_LOG(LogTemp, Display, TEXT("Rep benchmark: %d clients connected, warming up for %.1fs"), NumClients, WarmupTime);
+
+		FTimerHandle WarmupHandle;
+		GetWorld()->GetTimerManager().SetTimer(WarmupHandle, FTimerDelegate::CreateUObject(this, &UGASRepBenchmarkSubsystem::StartMeasuring), FMath::Max(WarmupTime, 0.01f), false);
+		return;
+	}
+
+	if (FPlatformTime::Seconds() - WaitStartTime > ConnectTimeout)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rep benchmark: only %d of %d clients connected within %.0fs"), NumClients, ExpectedClients, ConnectTimeout);
+		FPlatformMisc::RequestExitWithStatus(false, 2);
+	}
+}
+
+void UGASRepBenchmarkSubsystem::StartMeasuring()
+{
+	ReplicationMs.Reset();
+	NumConnectionsPerFrame.Reset();
+	OutBytesPerFrame.Reset();
+	OutPacketsPerFrame.Reset();
+
+	if (const UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+	{
+		LastOutTotalBytes = NetDriver->OutTotalBytes;
+		LastOutTotalPackets = NetDriver->OutTotalPackets;
+	}
+
+	MeasureStartTime = FPlatformTime::Seconds();
+	bMeasuring = true;
+
+#if CSV_PROFILER
+	// Per-class replication cost from the replication graph's CSV tracker, only for the measured window
+	if (FCsvProfiler::Get() && !FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->BeginCapture(-1, FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RepBenchmark")));
+	}
+#endif
+
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark: measuring for %.1fs"), MeasureTime);
+
+	FTimerHandle MeasureHandle;
+	GetWorld()->GetTimerManager().SetTimer(MeasureHandle, FTimerDelegate::CreateUObject(this, &UGASRepBenchmarkSubsystem::FinishRun), FMath::Max(MeasureTime, 0.01f), false);
+}
+
+void UGASRepBenchmarkSubsystem::FinishRun()
+{
+	bMeasuring = false;
+	MeasureEndTime = FPlatformTime::Seconds();
+
+#if CSV_PROFILER
+	// The capture is written out at the end of this frame, before the exit request is handled
+	if (FCsvProfiler::Get() && FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	const bool bPassed = ReportResults();
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark: %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+
+	FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+}
+
+void UGASRepBenchmarkSubsystem::ChangeEnemyState()
+{
+	const int32 NumEnemies = SpawnedEnemies.Num();
+	const int32 NumChanging = FMath::Min(FMath::RoundToInt(NumEnemies * FMath::Clamp(ChangingFraction, 0.0f, 1.0f)), NumEnemies);
+
+	// Walk the crowd round robin so every enemy changes eventually
+	for (int32 Step = 0; Step < NumChanging; ++Step)
+	{
+		AGASEnemyCharacter* Enemy = SpawnedEnemies[NextChangingEnemy];
+		NextChangingEnemy = (NextChangingEnemy + 1) % NumEnemies;
+
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		// Release counts as a change too, so enemies drop back out of the engaged state instead of staying locked on forever
+		const int32 NextBodyPart = (static_cast<int32>(Enemy->GetTargetedBodyPart()) + 1) % (static_cast<int32>(EBodyPartType::LeftLeg) + 1);
+		Enemy->SetTargetedBodyPart(static_cast<EBodyPartType>(NextBodyPart));
+
+		// Hack progress stands in for the hack channel traffic of an enemy being hacked
+		if (UAbilitySystemComponent* ASC = Enemy->GetAbilitySystemComponent())
+		{
+			const float HackProgress = ASC->GetNumericAttributeBase(UGASAttributeSet::GetHackProgressAttribute());
+			ASC->SetNumericAttributeBase(UGASAttributeSet::GetHackProgressAttribute(), FMath::Fmod(HackProgress + 10.0f, 100.0f));
+		}
+	}
+}
+
+bool UGASRepBenchmarkSubsystem::ReportResults() const
+{
+	const int32 NumFrames = ReplicationMs.Num();
+	if (NumFrames == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rep benchmark: no frames were recorded"));
+		return false;
+	}
+
+	float TotalMs = 0.0f;
+	float PeakMs = 0.0f;
+	for (float Ms : ReplicationMs)
+	{
+		TotalMs += Ms;
+		PeakMs = FMath::Max(PeakMs, Ms);
+	}
+
+	// 95th percentile, more stable than the peak across runs
+	TArray<float> Sorted = ReplicationMs;
+	Sorted.Sort();
+	const float P95Ms = Sorted[FMath::Min(FMath::FloorToInt(NumFrames * 0.95f), NumFrames - 1)];
+	const float AverageMs = TotalMs / NumFrames;
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const FString Mode = FString::Printf(TEXT("%s_%s"),
+		NetDriver && NetDriver->GetReplicationDriver() ? TEXT("RepGraph") : TEXT("Default"),
+		IS_PUSH_MODEL_ENABLED() ? TEXT("PushModel") : TEXT("Polling"));
+
+	// Bandwidth over the measured window, normalized per client and per enemy
+	uint64 TotalOutBytes = 0;
+	uint64 TotalOutPackets = 0;
+	for (int32 Frame = 0; Frame < OutBytesPerFrame.Num(); ++Frame)
+	{
+		TotalOutBytes += OutBytesPerFrame[Frame];
+		TotalOutPackets += OutPacketsPerFrame.IsValidIndex(Frame) ? OutPacketsPerFrame[Frame] : 0;
+	}
+
+	const double MeasuredSeconds = FMath::Max(MeasureEndTime - MeasureStartTime, 0.001);
+	const int32 NumClients = FMath::Max(GetNumClients(), 1);
+	const int32 NumEnemies = FMath::Max(SpawnedEnemies.Num(), 1);
+	const double BytesPerSecond = TotalOutBytes / MeasuredSeconds;
+	const double BytesPerClientPerSecond = BytesPerSecond / NumClients;
+	const double BytesPerEnemyPerSecond = BytesPerClientPerSecond / NumEnemies;
+
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark [%s]: %d enemies, %d clients, %d frames, replication avg %.3fms p95 %.3fms peak %.3fms"),
+		*Mode, SpawnedEnemies.Num(), GetNumClients(), NumFrames, AverageMs, P95Ms, PeakMs);
+	UE_LOG(LogTemp, Display, TEXT("Rep benchmark [%s]: sent %.1f KB/s total, %.1f KB/s per client, %.2f bytes per enemy per client per second"),
+		*Mode, BytesPerSecond / 1024.0, BytesPerClientPerSecond / 1024.0, BytesPerEnemyPerSecond);
+
+	FString Csv = TEXT("Frame,ReplicationMs,Connections,OutBytes,OutPackets\n");
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Csv += FString::Printf(TEXT("%d,%.4f,%d,%u,%u\n"), Frame, ReplicationMs[Frame],
+			NumConnectionsPerFrame.IsValidIndex(Frame) ? NumConnectionsPerFrame[Frame] : 0,
+			OutBytesPerFrame.IsValidIndex(Frame) ? OutBytesPerFrame[Frame] : 0u,
+			OutPacketsPerFrame.IsValidIndex(Frame) ? OutPacketsPerFrame[Frame] : 0u);
+	}
+
+	const FString BaseName = FString::Printf(TEXT("RepBenchmark_%s_%s"), *Mode, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RepBenchmark"), BaseName + TEXT(".csv"));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+
+	bool bPassed = true;
+	FString Failures;
+
+	if (MaxAverageReplicationMs > 0.0f && AverageMs > MaxAverageReplicationMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rep benchmark: average replication time over budget (%.3fms > %.3fms)"), AverageMs, MaxAverageReplicationMs);
+		Failures += FString::Printf(TEXT("  replication time %.3fms > %.3fms\n"), AverageMs, MaxAverageReplicationMs);
+		bPassed = false;
+	}
+
+	if (MaxBytesPerEnemyPerSecond > 0.0f && BytesPerEnemyPerSecond > MaxBytesPerEnemyPerSecond)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rep benchmark: bandwidth per enemy over budget (%.2f > %.2f bytes/s)"), BytesPerEnemyPerSecond, MaxBytesPerEnemyPerSecond);
+		Failures += FString::Printf(TEXT("  bytes per enemy per second %.2f > %.2f\n"), BytesPerEnemyPerSecond, MaxBytesPerEnemyPerSecond);
+		bPassed = false;
+	}
+
+	// A client that dropped during the measured window leaves the per-client numbers meaningless
+	int32 MinConnections = NumConnectionsPerFrame.Num() > 0 ? NumConnectionsPerFrame[0] : 0;
+	for (int32 NumConnections : NumConnectionsPerFrame)
+	{
+		MinConnections = FMath::Min(MinConnections, NumConnections);
+	}
+	if (MinConnections < ExpectedClients)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rep benchmark: only %d of %d clients stayed connected while measuring"), MinConnections, ExpectedClients);
+		Failures += FString::Printf(TEXT("  clients connected %d < %d\n"), MinConnections, ExpectedClients);
+		bPassed = false;
+	}
+
+	// Plain text summary, -RepBenchReport=<path> lets a launcher pick it up at a known location
+	FString Report;
+	Report += FString::Printf(TEXT("Mode: %s\n"), *Mode);
+	Report += FString::Printf(TEXT("Enemies: %d (%d walking, %.0f%% changing state every second)\n"), SpawnedEnemies.Num(), MoveDirections.Num(), ChangingFraction * 100.0f);
+	Report += FString::Printf(TEXT("Clients: %d\n"), GetNumClients());
+	Report += FString::Printf(TEXT("Measured: %.1fs, %d frames\n"), MeasuredSeconds, NumFrames);
+	Report += FString::Printf(TEXT("Replication ms: avg %.3f, p95 %.3f, peak %.3f\n"), AverageMs, P95Ms, PeakMs);
+	Report += FString::Printf(TEXT("Sent: %llu bytes in %llu packets, %.1f KB/s, %.1f KB/s per client\n"), TotalOutBytes, TotalOutPackets, BytesPerSecond / 1024.0, BytesPerClientPerSecond / 1024.0);
+	Report += FString::Printf(TEXT("Bytes per enemy per client per second: %.2f (budget %.2f)\n"), BytesPerEnemyPerSecond, MaxBytesPerEnemyPerSecond);
+	Report += FString::Printf(TEXT("Frames: %s\n"), *CsvPath);
+	Report += TEXT("Per-class cost: ReplicationGraphKBytes and ReplicationGraphMS in the CSV profile under Saved/RepBenchmark\n");
+	Report += FString::Printf(TEXT("Result: %s\n%s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"), *Failures);
+
+	FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RepBenchmark"), BaseName + TEXT(".txt"));
+	FParse::Value(FCommandLine::Get(), TEXT("RepBenchReport="), ReportPath);
+	FFileHelper::SaveStringToFile(Report, *ReportPath);
+
+	return bPassed;
+}
+
+int32 UGASRepBenchmarkSubsystem::GetNumClients() const
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	return NetDriver ? NetDriver->ClientConnections.Num() : 0;
+}
+
+void UGASRepBenchmarkSubsystem::OnWorldPreActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (TickWorld != GetWorld())
+	{
+		return;
+	}
+
+	// Walk in a straight line and turn around at the edge of the spawn area
+	for (int32 Index = 0; Index < MoveDirections.Num() && Index < SpawnedEnemies.Num(); ++Index)
+	{
+		AGASEnemyCharacter* Enemy = SpawnedEnemies[Index];
+		if (!IsValid(Enemy))
+		{
+			continue;
+		}
+
+		const FVector Offset = Enemy->GetActorLocation() - SpawnOrigin;
+		FVector& Direction = MoveDirections[Index];
+		if (FMath::Abs(Offset.X) > SpawnHalfExtent || FMath::Abs(Offset.Y) > SpawnHalfExtent)
+		{
+			Direction = FVector(-Offset.X, -Offset.Y, 0.0f).GetSafeNormal();
+		}
+		Enemy->AddMovementInput(Direction);
+	}
+}
+
+void UGASRepBenchmarkSubsystem::OnWorldPostActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (bMeasuring && TickWorld == GetWorld())
+	{
+		FlushStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UGASRepBenchmarkSubsystem::OnPostTickFlush(float DeltaSeconds)
+{
+	if (!bMeasuring || FlushStartTime == 0.0)
+	{
+		return;
+	}
+
+	ReplicationMs.Add(static_cast<float>((FPlatformTime::Seconds() - FlushStartTime) * 1000.0));
+	NumConnectionsPerFrame.Add(GetNumClients());
+
+	// Unsigned deltas stay correct across a wrap of the driver totals
+	if (const UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+	{
+		OutBytesPerFrame.Add(NetDriver->OutTotalBytes - LastOutTotalBytes);
+		OutPacketsPerFrame.Add(NetDriver->OutTotalPackets - LastOutTotalPackets);
+		LastOutTotalBytes = NetDriver->OutTotalBytes;
+		LastOutTotalPackets = NetDriver->OutTotalPackets;
+	}
+	FlushStartTime = 0.0;
+}
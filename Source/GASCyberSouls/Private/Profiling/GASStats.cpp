@@ -0,0 +1,35 @@
+// copyright GASCyberSouls
+
+#include "Profiling/GASStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(GASCYBERSOULS_API, CyberSouls, true);
+
+DEFINE_STAT(STAT_CyberSouls_FindTargetsInRange);
+DEFINE_STAT(STAT_CyberSouls_FindBestTarget);
+DEFINE_STAT(STAT_CyberSouls_AbilityEnd);
+DEFINE_STAT(STAT_CyberSouls_PostGameplayEffectExecute);
+DEFINE_STAT(STAT_CyberSouls_MeleeHitWindow);
+DEFINE_STAT(STAT_CyberSouls_MeleeHitResolve);
+DEFINE_STAT(STAT_CyberSouls_HitZoneUpdate);
+DEFINE_STAT(STAT_CyberSouls_VisibilityTraces);
+DEFINE_STAT(STAT_CyberSouls_ServerReplicateActors);
+DEFINE_STAT(STAT_CyberSouls_EnemyNetActivity);
+DEFINE_STAT(STAT_CyberSouls_FlowFieldUpdate);
+DEFINE_STAT(STAT_CyberSouls_FlowFieldBuild);
+DEFINE_STAT(STAT_CyberSouls_EnemyPathRequests);
+DEFINE_STAT(STAT_CyberSouls_DrawHUD);
+DEFINE_STAT(STAT_CyberSouls_EnemyOverlay);
+DEFINE_STAT(STAT_CyberSouls_FloatingCombatText);
+
+DEFINE_STAT(STAT_CyberSouls_GEApplications);
+DEFINE_STAT(STAT_CyberSouls_TargetsScanned);
+DEFINE_STAT(STAT_CyberSouls_AbilitiesActivated);
+DEFINE_STAT(STAT_CyberSouls_EnemyOverlayBars);
+DEFINE_STAT(STAT_CyberSouls_FloatingCombatTexts);
+DEFINE_STAT(STAT_CyberSouls_NetDormantEnemies);
+DEFINE_STAT(STAT_CyberSouls_MovementCorrections);
+DEFINE_STAT(STAT_CyberSouls_PathRequestsRun);
+DEFINE_STAT(STAT_CyberSouls_MeleeSweeps);
+DEFINE_STAT(STAT_CyberSouls_VisibilityTracesIssued);
+DEFINE_STAT(STAT_CyberSouls_VisibilityGridRejects);
+DEFINE_STAT(STAT_CyberSouls_CombatScratchBytes);
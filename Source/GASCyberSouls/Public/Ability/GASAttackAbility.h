@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GAS/GASGameplayAbility.h"
+#include "WorldCollision.h"
 #include "GASAttackAbility.generated.h"
 
 /**
@@ -41,4 +42,11 @@ protected:
 	// Apply damage to target
 	UFUNCTION(BlueprintCallable, Category = "Attack")
 	void ApplyDamage();
+	
+private:
+	// Result of the enemy attack overlap queued by ApplyDamage, one frame later
+	void OnEnemyAttackOverlap(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum);
+	
+	// Set while an enemy attack overlap is in flight, the ability ends when it returns
+	bool bAwaitingEnemyOverlap;
 };
\ No newline at end of file
@@ -6,9 +6,13 @@
 #include "GAS/GASGameplayAbility.h"
 #include "GASDodgeAbility.generated.h"
 
+class UGASCharacterMovementComponent;
+
 /**
  * Dodge ability for GASCyberSouls
  * Used by dodge-capable enemies to dodge attacks to lower body
+ * Distance and duration belong to the avatar's UGASCharacterMovementComponent, the server replays the dodge from the
+ * saved move and has to build the same root motion as the client
  */
 UCLASS()
 class GASCYBERSOULS_API UGASDodgeAbility : public UGASGameplayAbility
@@ -25,15 +29,21 @@ public:
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	
 protected:
-	// Dodge duration in seconds
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
-	float DodgeDuration;
-	
 	// Dodge cooldown in seconds
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
 	float CooldownTime;
 	
-	// Dodge distance
+	// Extra time after the root motion dodge before the ability ends on its own
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
-	float DodgeDistance;
+	float DodgeEndGraceTime;
+	
+private:
+	// Ends the ability when the movement component's dodge is over
+	void OnDodgeFinished();
+	
+	TWeakObjectPtr<UGASCharacterMovementComponent> DodgeMovementComponent;
+	
+	FDelegateHandle DodgeFinishedHandle;
+	
+	FTimerHandle EndTimerHandle;
 };
\ No newline at end of file
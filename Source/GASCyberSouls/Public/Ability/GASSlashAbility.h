@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "GAS/GASGameplayAbility.h"
 #include "Character/GASTypes.h"
+#include "Combat/GASHitZoneComponent.h"
 #include "GASSlashAbility.generated.h"
 
 /**
@@ -29,7 +30,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slash")
 	float BaseDamage;
 	
-	// Bonus damage multiplier when targeting specific body parts
+	// Bonus damage multiplier on legs, for targets without hit zones
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slash")
 	float BodyPartDamageMultiplier;
 	
@@ -41,6 +42,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slash")
 	float CooldownTime;
 	
+	// Slack for positions that moved between a client's sweep and the server's check of the reported hit
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slash")
+	float MaxClientHitError;
+	
 	// Montages for different body part attacks
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slash|Animation")
 	UAnimMontage* UpperBodySlashMontage;
@@ -56,6 +61,26 @@ protected:
 	
 	UFUNCTION(BlueprintCallable) // Or other UFUNCTION specifiers if needed
 	void ApplySlashDamage(); // Should take NO parameters
+	
+	// Event.Melee.Hit from a hit window on the slash montage
+	UFUNCTION()
+	void OnMeleeHit(FGameplayEventData Payload);
+	
+	// Completed, blended out, interrupted or cancelled before a hit landed
+	UFUNCTION()
+	void OnSlashMontageEnded();
+	
+	// Server side of a remote player's slash, the hit their client swept and sent as target data
+	void OnClientHitReceived(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayTag ApplicationTag);
+	
+	bool IsValidClientHit(const FHitResult& Hit) const;
+	
+	void ResolveHitZone(const AActor* Target, const FGameplayAbilityTargetDataHandle& TargetData);
+	
+private:
+	// Zone of the target the hit window touched, set before ApplySlashDamage when the target has hit zones
+	FGASHitZoneResult HitZone;
+	bool bHasHitZone;
 
 	
 };
\ No newline at end of file
@@ -5,14 +5,24 @@
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
 #include "AbilitySystemComponent.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "GASAttributeSet.generated.h"
 
+// Attributes replicate through the push model, so direct writes such as Init must mark the property dirty themselves
+#define GASATTRIBUTE_VALUE_INITTER(ClassName, PropertyName) \
+	FORCEINLINE void Init##PropertyName(float NewVal) \
+	{ \
+		PropertyName.SetBaseValue(NewVal); \
+		PropertyName.SetCurrentValue(NewVal); \
+		MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, this); \
+	}
+
 // Uses macros from AttributeSet.h
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
 GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
 GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
-GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
+GASATTRIBUTE_VALUE_INITTER(ClassName, PropertyName)
 
 /**
  * Base Attribute Set for GASCyberSouls game
@@ -29,74 +39,105 @@ public:
 	// Called after attribute change
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 	
+	// Every attribute change goes through these, they mark the attribute dirty for push-model replication
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
+	
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Called on clients when the owner's actor channel opens, on first relevance and when it leaves dormancy
+	void OnOwnerChannelOpened() { OwnerChannelOpenFrame = GFrameCounter; }
+
+	// True while the values from the channel's opening bunch are arriving, they are catch-up state rather than combat events
+	bool IsReceivingInitialValues() const { return OwnerChannelOpenFrame == GFrameCounter; }
+	
+	UFUNCTION()
+	void OnRep_Integrity(const FGameplayAttributeData& OldIntegrity);
+	UFUNCTION()
+	void OnRep_MaxIntegrity(const FGameplayAttributeData& OldMaxIntegrity);
+	UFUNCTION()
+	void OnRep_HackProgress(const FGameplayAttributeData& OldHackProgress);
+	UFUNCTION()
 	void OnRep_MaxHackProgress(const FGameplayAttributeData& OldMaxHackProgress);
+	UFUNCTION()
 	void OnRep_BlockCharge(const FGameplayAttributeData& OldBlockCharge);
+	UFUNCTION()
 	void OnRep_MaxBlockCharge(const FGameplayAttributeData& OldMaxBlockCharge);
+	UFUNCTION()
 	void OnRep_DodgeCharge(const FGameplayAttributeData& OldDodgeCharge);
+	UFUNCTION()
 	void OnRep_MaxDodgeCharge(const FGameplayAttributeData& OldMaxDodgeCharge);
+	UFUNCTION()
 	void OnRep_QuickHackProgress(const FGameplayAttributeData& OldQuickHackProgress);
+	UFUNCTION()
 	void OnRep_AttackSpeed(const FGameplayAttributeData& OldAttackSpeed);
+	UFUNCTION()
 	void OnRep_SlashSpeed(const FGameplayAttributeData& OldSlashSpeed);
+	UFUNCTION()
 	void OnRep_QuickHackSpeed(const FGameplayAttributeData& OldQuickHackSpeed);
 
 
 	// Integrity attribute (player's health in CyberSouls)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Integrity, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData Integrity;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, Integrity);
 	
 	// Max Integrity attribute
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxIntegrity, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData MaxIntegrity;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, MaxIntegrity);
 	
 	// HackProgress attribute (0-100)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_HackProgress, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData HackProgress;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, HackProgress);
 	
 	// Max HackProgress attribute
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxHackProgress, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData MaxHackProgress;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, MaxHackProgress);
 	
 	// BlockCharge attribute (for enemies with block ability)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_BlockCharge, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData BlockCharge;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, BlockCharge);
 	
 	// MaxBlockCharge attribute
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxBlockCharge, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData MaxBlockCharge;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, MaxBlockCharge);
 	
 	// DodgeCharge attribute (for enemies with dodge ability)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_DodgeCharge, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData DodgeCharge;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, DodgeCharge);
 	
 	// MaxDodgeCharge attribute
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_MaxDodgeCharge, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData MaxDodgeCharge;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, MaxDodgeCharge);
 	
 	// QuickHackProgress attribute (for tracking casting progress)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_QuickHackProgress, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData QuickHackProgress;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, QuickHackProgress);
 	
 	// AttackSpeed attribute (cooldown for Attack ability)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_AttackSpeed, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData AttackSpeed;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, AttackSpeed);
 	
 	// SlashSpeed attribute (cooldown for Slash ability)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_SlashSpeed, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData SlashSpeed;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, SlashSpeed);
 	
 	// QuickHackSpeed attribute (cooldown for QuickHack abilities)
-	UPROPERTY(BlueprintReadOnly, Category = "CyberSouls|Attributes")
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_QuickHackSpeed, Category = "CyberSouls|Attributes")
 	FGameplayAttributeData QuickHackSpeed;
 	ATTRIBUTE_ACCESSORS(UGASAttributeSet, QuickHackSpeed);
+
+private:
+	// Frame the owner's actor channel last opened on this client
+	uint64 OwnerChannelOpenFrame = MAX_uint64;
 };
\ No newline at end of file
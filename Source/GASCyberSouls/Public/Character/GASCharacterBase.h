@@ -12,6 +12,7 @@
 class UAbilitySystemComponent;
 class UAttributeSet;
 class UGameplayAbility;
+struct FGameplayEffectSpec;
 
 /**
  * Base Character class for GASCyberSouls game
@@ -23,14 +24,17 @@ class GASCYBERSOULS_API AGASCharacterBase : public ACharacter, public IAbilitySy
 	GENERATED_BODY()
 
 public:
-	// Sets default values for this character's properties
-	AGASCharacterBase();
+	// Sets default values for this character's properties, character movement is a UGASCharacterMovementComponent
+	AGASCharacterBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	// Implement IAbilitySystemInterface
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 	
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+
+	// Lets the attribute set tell catch-up values apart from combat events
+	virtual void OnActorChannelOpen(class FInBunch& InBunch, class UNetConnection* Connection) override;
 	
 	// Gameplay Ability System Components
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AbilitySystem")
@@ -55,6 +59,9 @@ protected:
 	// Add starting abilities to this character
 	virtual void AddStartingAbilities();
 
+	// Called whenever a gameplay effect is applied to this character
+	void OnGameplayEffectAppliedToSelf(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+
 	// Abilities to grant to this character when it spawns
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilitySystem")
 	TArray<TSubclassOf<UGameplayAbility>> StartingAbilities;
@@ -0,0 +1,110 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameplayTagContainer.h"
+#include "GASCharacterMovementComponent.generated.h"
+
+class UAbilitySystemComponent;
+class UCurveFloat;
+
+// Max speed multiplier applied while the owner has a gameplay tag
+USTRUCT(BlueprintType)
+struct FGASMovementSpeedModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
+	FGameplayTag Tag;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
+	float Multiplier = 1.0f;
+};
+
+DECLARE_MULTICAST_DELEGATE(FGASOnDodgeFinished);
+
+/**
+ * Character movement for GASCyberSouls characters
+ * Dodges are a predicted root motion source requested through a saved-move flag, so the owning client and the server
+ * run the same dodge from the same move instead of the server correcting a client-side launch
+ * Max speed is scaled by a stack of multiplicative, tag-driven modifiers, cached on tag change and kept in saved moves
+ * so replays use the speed each move was predicted with
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGASCharacterMovementComponent();
+
+	// Dodge on the next move. Players dodge along their movement input so the server derives the same direction from the
+	// replicated acceleration; server-controlled characters may pass an explicit direction
+	void RequestDodge(const FVector& Direction = FVector::ZeroVector);
+
+	bool IsDodging() const;
+
+	// Broadcast when the dodge root motion source has run its course
+	FGASOnDodgeFinished& OnDodgeFinished() { return DodgeFinishedDelegate; }
+
+	// Corrections received from the server since the component was created
+	int32 GetNumClientAdjustments() const { return NumClientAdjustments; }
+
+	// Product of the modifiers whose tags the owner has, 1 when none apply
+	float GetSpeedMultiplier() const;
+
+	virtual float GetMaxSpeed() const override;
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+	virtual void ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode, TOptional<FRotator> OptionalRotation = TOptional<FRotator>()) override;
+
+	// Distance covered by a dodge
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
+	float DodgeDistance;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
+	float DodgeDuration;
+
+	// Speed over the normalized dodge time, constant when unset
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dodge")
+	TObjectPtr<UCurveFloat> DodgeStrengthOverTime;
+
+	// Modifiers multiplied into max speed, e.g. frozen, stunned or rooted characters do not move
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
+	TArray<FGASMovementSpeedModifier> SpeedModifiers;
+
+	// Set from the saved move flag, consumed by the next movement update
+	uint8 bWantsToDodge : 1;
+
+	// Speed multiplier of the saved move being replayed, negative outside of replays
+	float ReplaySpeedMultiplier;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
+
+private:
+	void StartDodge();
+
+	// Recomputes the cached speed multiplier, bound to the owner's modifier tags
+	void OnSpeedModifierTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	void UpdateSpeedMultiplier();
+
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	float CachedSpeedMultiplier;
+
+	// Explicit direction of a server-side dodge, never sent over the network
+	FVector PendingDodgeDirection;
+
+	uint16 DodgeRootMotionSourceID;
+
+	int32 NumClientAdjustments;
+
+	FGASOnDodgeFinished DodgeFinishedDelegate;
+};
@@ -8,6 +8,7 @@
 #include "GASTargetingComponent.generated.h"
 
 class AGASCharacterBase;
+class AGASEnemyCharacter;
 
 /**
  * Component that handles targeting functionality for CyberSouls
@@ -23,6 +24,9 @@ public:
 
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	
+	// Clears the lock-on mark on the targeted enemy
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -64,6 +68,13 @@ public:
 	bool HasTarget() const { return CurrentTarget != nullptr; }
 
 private:
+	// The owning client's lock-on, so the server knows it for replication relevance and engaged enemies
+	UFUNCTION(Server, Reliable)
+	void ServerSetLockOnTarget(AGASCharacterBase* NewTarget, EBodyPartType NewBodyPart);
+	
+	// Send a lock-on change made on the owning client to the server, on the server mark the targeted enemy as locked on
+	void OnLockOnChanged();
+	
 	// Find potential targets in range
 	void FindTargetsInRange();
 	
@@ -78,6 +89,9 @@ private:
 	UPROPERTY()
 	EBodyPartType CurrentBodyPart;
 	
+	// Enemy whose targeted body part this component set, cleared when the lock moves or is released
+	TWeakObjectPtr<AGASEnemyCharacter> LockedEnemy;
+	
 	// List of potential targets
 	UPROPERTY()
 	TArray<AGASCharacterBase*> PotentialTargets;
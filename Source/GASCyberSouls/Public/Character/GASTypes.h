@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "GASTypes.generated.h"
 
+// "Combat" trace channel from DefaultEngine.ini, only the Pawn profile responds to it so melee queries skip the level geometry
+#define ECC_Combat ECC_GameTraceChannel1
+
 UENUM(BlueprintType)
 enum class EBodyPartType : uint8
 {
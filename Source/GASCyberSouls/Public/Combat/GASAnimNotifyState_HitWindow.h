@@ -0,0 +1,65 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Engine/EngineTypes.h"
+#include "Character/GASTypes.h"
+#include "GASAnimNotifyState_HitWindow.generated.h"
+
+struct FGASMeleeHitWindow;
+class UGASMeleeHitSubsystem;
+
+/**
+ * Melee hit window on an attack montage
+ * While the window is open the weapon capsule is swept from its pose in the previous frame to its pose in this one, split
+ * into interpolated sub-steps when the blade tip moved far, so a fast swing hits the same targets at 20 fps as at 120 fps.
+ * Each actor is hit at most once per window, contacts go to the melee hit subsystem and reach the attacker as Event.Melee.Hit.
+ * The notify is shared by every mesh playing the montage and keeps no state, open windows live in the melee hit subsystem
+ * Usage: add it over the active frames of a swing, with the weapon socket and blade offsets of the character's mesh
+ */
+UCLASS(meta = (DisplayName = "Melee Hit Window"))
+class GASCYBERSOULS_API UGASAnimNotifyState_HitWindow : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	UGASAnimNotifyState_HitWindow();
+
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+
+	// Socket the blade is attached to
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	FName WeaponSocket;
+
+	// Blade hilt and tip in socket space
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	FVector BladeStart;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	FVector BladeEnd;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	float BladeRadius;
+
+	// Blade tip travel covered by one sweep, longer frames are split into more sub-steps
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	float MaxSubstepDistance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	int32 MaxSubsteps;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hit Window")
+	TEnumAsByte<ECollisionChannel> TraceChannel;
+
+private:
+	// Players sweep on their own machine, AI on the server, other copies of the montage are cosmetic
+	static bool ShouldSweep(const USkeletalMeshComponent* MeshComp);
+
+	static UGASMeleeHitSubsystem* GetMeleeHits(const USkeletalMeshComponent* MeshComp);
+
+	void SweepBlade(USkeletalMeshComponent* MeshComp, UGASMeleeHitSubsystem& MeleeHits, FGASMeleeHitWindow& Window, const FTransform& SocketTransform) const;
+};
@@ -0,0 +1,36 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASBakeVisibilityGridCommandlet.generated.h"
+
+class UGASVisibilityGrid;
+class UWorld;
+
+/**
+ * Bakes the coarse cell-to-cell visibility grid of a map from its static collision
+ * Cells are traced against each other on all cores, a pair is visible when any ray between the centres, corners and face
+ * centres of the two cells misses the level's static geometry. Visible pairs are then spread to the cells around both ends,
+ * so doorways and windows narrower than the ray spacing stay visible. World Partition maps have every actor loaded through
+ * an editor loader region first. Needs an editor build to save the grid, runs headless
+ * Usage: UnrealEditor-Cmd <project> -run=GASBakeVisibilityGrid -Map=<map package> [-CellSize=400] [-Range=3000] [-RangeZ=800]
+ * [-MaxCells=262144] -unattended -nullrhi
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASBakeVisibilityGridCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASBakeVisibilityGridCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+#if WITH_EDITOR
+	// Trace every cell against its neighbours in range, returns the number of traces run
+	static int64 BakeGrid(UWorld* World, UGASVisibilityGrid* Grid);
+#endif
+};
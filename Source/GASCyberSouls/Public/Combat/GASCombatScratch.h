@@ -0,0 +1,188 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+/**
+ * Per-frame linear arena for temporary combat query results on the game thread
+ * Allocations only bump a pointer and are all released at once at the end of the frame, so a scratch array must never
+ * outlive the frame it was filled in. Off the game thread, or with CyberSouls.Combat.ScratchAllocator 0, scratch arrays
+ * fall back to the heap
+ * Usage: TGASScratchArray<AActor*> Candidates; CyberSouls.Memory.AllocsPerFrame [Frames] in a -CyberSoulsCountAllocs run
+ * compares heap allocations per frame with and without the arena
+ */
+struct GASCYBERSOULS_API FGASCombatScratch
+{
+	// Hook the end of frame flush, called once on module startup
+	static void Startup();
+	static void Shutdown();
+
+	// True when scratch allocations come from the arena on the calling thread
+	static bool IsActive();
+
+	static void* Alloc(SIZE_T Size, uint32 Alignment);
+
+	// Bytes handed out since the last flush
+	static int64 GetBytesUsed();
+
+	// Heap allocations per frame over the next frames, once with the arena and once without
+	static void StartAllocationReport(int32 NumFrames);
+};
+
+/**
+ * TArray allocator policy backed by the combat scratch arena
+ * Growing copies into a new block, the old block stays in the arena until the end of the frame
+ */
+template <uint32 Alignment = DEFAULT_ALIGNMENT>
+class TGASCombatScratchAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType()
+			: Data(nullptr)
+			, bHeap(false)
+		{
+		}
+
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		~ForAnyElementType()
+		{
+			FreeHeap();
+		}
+
+		void MoveToEmpty(ForAnyElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			FreeHeap();
+			Data = Other.Data;
+			bHeap = Other.bHeap;
+			Other.Data = nullptr;
+			Other.bHeap = false;
+		}
+
+		FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			if (NumElements <= 0)
+			{
+				FreeHeap();
+				Data = nullptr;
+				return;
+			}
+
+			const SIZE_T NumBytes = static_cast<SIZE_T>(NumElements) * NumBytesPerElement;
+			if (!FGASCombatScratch::IsActive())
+			{
+				// Heap fallback, an arena block is copied out once and then grows in place
+				if (bHeap)
+				{
+					Data = static_cast<FScriptContainerElement*>(FMemory::Realloc(Data, NumBytes, Alignment));
+					return;
+				}
+
+				FScriptContainerElement* NewData = static_cast<FScriptContainerElement*>(FMemory::Malloc(NumBytes, Alignment));
+				CopyElements(NewData, PreviousNumElements, NumElements, NumBytesPerElement);
+				Data = NewData;
+				bHeap = true;
+				return;
+			}
+
+			FScriptContainerElement* NewData = static_cast<FScriptContainerElement*>(FGASCombatScratch::Alloc(NumBytes, Alignment));
+			CopyElements(NewData, PreviousNumElements, NumElements, NumBytesPerElement);
+			FreeHeap();
+			Data = NewData;
+		}
+
+		SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+
+		SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return static_cast<SIZE_T>(NumAllocatedElements) * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return Data != nullptr;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		void CopyElements(FScriptContainerElement* NewData, SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			if (Data && PreviousNumElements > 0)
+			{
+				FMemory::Memcpy(NewData, Data, static_cast<SIZE_T>(FMath::Min(PreviousNumElements, NumElements)) * NumBytesPerElement);
+			}
+		}
+
+		void FreeHeap()
+		{
+			if (bHeap)
+			{
+				FMemory::Free(Data);
+				bHeap = false;
+			}
+		}
+
+		FScriptContainerElement* Data;
+
+		// Set when the block came from the heap fallback and has to be freed
+		bool bHeap;
+	};
+
+	template <typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		ElementType* GetAllocation() const
+		{
+			return (ElementType*)ForAnyElementType::GetAllocation();
+		}
+	};
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TGASCombatScratchAllocator<Alignment>> : TAllocatorTraitsBase<TGASCombatScratchAllocator<Alignment>>
+{
+	enum { SupportsMove = true };
+	enum { IsZeroConstruct = true };
+};
+
+using FGASCombatScratchAllocator = TGASCombatScratchAllocator<>;
+
+// Frame-local array for combat query results, see FGASCombatScratch
+template <typename ElementType>
+using TGASScratchArray = TArray<ElementType, FGASCombatScratchAllocator>;
@@ -0,0 +1,82 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Character/GASTypes.h"
+#include "GASHitZoneComponent.generated.h"
+
+class USkeletalMeshComponent;
+struct FHitResult;
+
+// Body part and damage multiplier of the zone a hit landed in
+struct FGASHitZoneResult
+{
+	EBodyPartType BodyPart = EBodyPartType::None;
+	float DamageMultiplier = 1.0f;
+};
+
+/**
+ * Body part hit zones of a character
+ * At begin play the physics asset bodies of the mesh are reduced to one capsule per shape and tagged with the body part of
+ * their closest mapped bone. Zones follow the bones lazily, at most once per frame and only when a hit is resolved against
+ * them, so only characters in a fight pay for it
+ * Usage: ResolveHit with a melee or trace hit on the owner to get the body part and its damage multiplier
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class GASCYBERSOULS_API UGASHitZoneComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGASHitZoneComponent();
+
+	virtual void BeginPlay() override;
+
+	// Rebuild the zone capsules from the physics asset of the owner's mesh
+	void BuildZones();
+
+	// Zone closest to the segment, false when the owner has no zones
+	bool ResolveHit(const FVector& Start, const FVector& End, FGASHitZoneResult& OutResult);
+
+	// Zone closest to the contact, probing inwards from the impact point
+	bool ResolveHit(const FHitResult& Hit, FGASHitZoneResult& OutResult);
+
+	float GetDamageMultiplier(EBodyPartType BodyPart) const;
+
+	int32 GetNumZones() const { return Shapes.Num(); }
+
+	// Bones that start a body part, every other physics body takes the part of its closest mapped parent
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Zones")
+	TMap<FName, EBodyPartType> BoneBodyParts;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Hit Zones")
+	TMap<EBodyPartType, float> DamageMultipliers;
+
+private:
+	struct FZoneShape
+	{
+		int32 BoneIndex;
+
+		// Capsule segment in bone space
+		FVector LocalStart;
+		FVector LocalEnd;
+		float Radius;
+		EBodyPartType BodyPart;
+	};
+
+	// Move the world space segments to the current bone transforms, once per frame, refreshing the bones of unrendered meshes first
+	void UpdateZones();
+
+	EBodyPartType FindBodyPart(const USkeletalMeshComponent* Mesh, FName BoneName) const;
+
+	// Sorted by bone, world segments use the same order
+	TArray<FZoneShape> Shapes;
+	TArray<FVector> WorldStarts;
+	TArray<FVector> WorldEnds;
+	float WorldScale;
+
+	TWeakObjectPtr<USkeletalMeshComponent> ZoneMesh;
+	uint64 LastUpdateFrame;
+};
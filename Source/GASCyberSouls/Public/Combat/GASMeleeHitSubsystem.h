@@ -0,0 +1,63 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Engine/HitResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASMeleeHitSubsystem.generated.h"
+
+class UAnimNotifyState;
+class USkeletalMeshComponent;
+
+// One contact found by a melee hit window sweep
+struct FGASMeleeHit
+{
+	TWeakObjectPtr<AActor> Instigator;
+	TWeakObjectPtr<AActor> Victim;
+	FHitResult Hit;
+};
+
+// An open melee hit window of one mesh
+struct FGASMeleeHitWindow
+{
+	// Weapon socket pose at the end of the last sweep
+	FTransform LastSocketTransform;
+
+	// Each actor is hit at most once per window
+	TArray<TWeakObjectPtr<AActor>> HitActors;
+};
+
+/**
+ * Resolves melee hits once per frame on the game thread
+ * Hit windows only queue their contacts, the queue takes producers on any thread. Each queued hit becomes an
+ * Event.Melee.Hit gameplay event on the instigator, with the victim as event target and the hit result as target data
+ * Also keeps the open hit windows per mesh and notify, an anim notify is shared by every mesh playing its montage
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASMeleeHitSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Safe to call from any thread
+	void QueueHit(FGASMeleeHit&& Hit);
+
+	// Open, look up and close the hit window of a notify on a mesh, game thread only
+	FGASMeleeHitWindow& OpenWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify);
+	FGASMeleeHitWindow* FindWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify);
+	void CloseWindow(const USkeletalMeshComponent* Mesh, const UAnimNotifyState* Notify);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TQueue<FGASMeleeHit, EQueueMode::Mpsc> PendingHits;
+
+	using FWindowKey = TPair<TWeakObjectPtr<const USkeletalMeshComponent>, TWeakObjectPtr<const UAnimNotifyState>>;
+	TMap<FWindowKey, FGASMeleeHitWindow> OpenWindows;
+};
@@ -0,0 +1,83 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GASVisibilityGrid.generated.h"
+
+/**
+ * Baked cell-to-cell visibility of a level, from its static collision
+ * The level is cut into cubic cells, and each cell keeps one bit per neighbour cell within range: set when a ray between the
+ * centres, corners or face centres of the two cells got through, then spread to every pair within one cell of a visible pair.
+ * A cleared bit means static geometry blocked all of those rays for the cells and their neighbours, pairs out of range or
+ * outside the grid count as visible, so the grid can only rule traces out
+ * Usage: baked by -run=GASBakeVisibilityGrid, loaded at level start by the visibility grid subsystem
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASVisibilityGrid : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Serialize(FArchive& Ar) override;
+
+	// Package the grid of a map is saved to, e.g. /Game/VisibilityGrids/VG_ThirdPersonMap
+	static FString GetPackageNameForMap(const FString& GridDirectory, const FString& MapPackageName);
+
+	// Size the bitset for the grid layout and clear every bit
+	void Reset(const FVector& InOrigin, float InCellSize, const FIntVector& InCellCounts, int32 InRangeCells, int32 InRangeCellsZ);
+
+	// False only when no baked ray got through between the cells of the two points or the cells around them
+	bool IsPotentiallyVisible(const FVector& From, const FVector& To) const;
+
+	bool IsValidGrid() const;
+
+	// Cell of a location, false outside the grid
+	bool GetCell(const FVector& Location, FIntVector& OutCell) const;
+
+	int32 GetCellIndex(const FIntVector& Cell) const { return (Cell.Z * CellCounts.Y + Cell.Y) * CellCounts.X + Cell.X; }
+	int32 GetNumCells() const { return CellCounts.X * CellCounts.Y * CellCounts.Z; }
+
+	// Bit of a neighbour offset within a cell's row, offsets must be within range
+	int32 GetNeighbourBit(const FIntVector& Offset) const;
+	FIntVector GetNeighbourOffset(int32 NeighbourBit) const;
+	bool IsInRange(const FIntVector& Offset) const;
+	int32 GetNumNeighbours() const { return (2 * RangeCells + 1) * (2 * RangeCells + 1) * (2 * RangeCellsZ + 1); }
+
+	void SetVisible(int32 CellIndex, int32 NeighbourBit);
+
+	// Mark every pair within one cell of a visible pair on either side visible, so openings narrower than the spacing of the
+	// baked rays are not ruled out
+	void Dilate();
+
+	// Grids baked before the current rules fail IsValidGrid and have to be baked again
+	static constexpr int32 CurrentBakeVersion = 1;
+
+	// Minimum corner of cell 0, 0, 0
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	float CellSize = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	FIntVector CellCounts = FIntVector::ZeroValue;
+
+	// Neighbour range in cells, horizontally and vertically
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	int32 RangeCells = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	int32 RangeCellsZ = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	int32 WordsPerCell = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Visibility Grid")
+	int32 BakeVersion = 0;
+
+private:
+	// One row of WordsPerCell words per cell, serialized in bulk rather than as a property
+	TArray<uint64> Bits;
+};
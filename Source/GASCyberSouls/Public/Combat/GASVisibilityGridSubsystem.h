@@ -0,0 +1,41 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASVisibilityGridSubsystem.generated.h"
+
+class UGASVisibilityGrid;
+
+/**
+ * Loads the baked visibility grid of the current map at level start
+ * Maps without a baked grid work as before, every pair is potentially visible and goes to a real trace
+ * Usage: IsPotentiallyVisible as a pre-filter, only a false answer is final
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASVisibilityGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASVisibilityGridSubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// O(1), false only when no baked ray got through between the cells of the two points or the cells around them
+	bool IsPotentiallyVisible(const FVector& From, const FVector& To) const;
+
+	bool HasGrid() const { return Grid != nullptr; }
+
+	// Content directory the bake commandlet writes grids to
+	UPROPERTY(Config)
+	FString GridDirectory;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UGASVisibilityGrid> Grid;
+};
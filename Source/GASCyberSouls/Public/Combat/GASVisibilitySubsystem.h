@@ -0,0 +1,94 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASVisibilitySubsystem.generated.h"
+
+class UGASVisibilityGridSubsystem;
+
+/**
+ * Shared line of sight cache for targeting, hacking and AI
+ * Queries never trace themselves, they answer from the cache and queue a refresh when the pair is unknown, older than the
+ * cache lifetime or either side moved. Pairs the baked visibility grid rules out are settled without a trace. Queued pairs are traced once per frame as a batch of async line traces, up to a
+ * per-frame limit, and the results land in the cache the frame after
+ * Usage: HasLineOfSight(Source, Target) every time it is needed, repeated queries for the same pair are free
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASVisibilitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASVisibilitySubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Cached line of sight from the source's eyes to the target, the last known answer while a refresh is in flight
+	bool HasLineOfSight(const AActor* Source, const AActor* Target, bool bVisibleWhenUnknown = false);
+
+	int32 GetNumCachedPairs() const { return Entries.Num(); }
+
+	// Seconds a traced result stays valid
+	UPROPERTY(Config)
+	float CacheLifetime;
+
+	// Movement of either side since the trace that makes the result stale
+	UPROPERTY(Config)
+	float InvalidateDistance;
+
+	// Async traces issued per frame at most, the rest wait for the next frame
+	UPROPERTY(Config)
+	int32 MaxTracesPerFrame;
+
+	// Pairs nobody asked about for this many seconds are dropped
+	UPROPERTY(Config)
+	float EvictAfter;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FVisibilityKey = TPair<FObjectKey, FObjectKey>;
+
+	struct FVisibilityEntry
+	{
+		TWeakObjectPtr<const AActor> Source;
+		TWeakObjectPtr<const AActor> Target;
+
+		// Actor locations when the last trace was issued
+		FVector SourceLocation = FVector::ZeroVector;
+		FVector TargetLocation = FVector::ZeroVector;
+
+		double TraceTime = -MAX_dbl;
+		double LastQueryTime = 0.0;
+		bool bVisible = false;
+		bool bKnown = false;
+
+		// Waiting in the pending list or traced and not back yet
+		bool bQueued = false;
+	};
+
+	void IssueTraces();
+	void EvictUnusedEntries(double Now);
+	void OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	TMap<FVisibilityKey, FVisibilityEntry> Entries;
+	TArray<FVisibilityKey> PendingKeys;
+
+	// Async trace user data to the pair it was traced for
+	TMap<uint32, FVisibilityKey> InFlightTraces;
+	uint32 NextTraceId;
+
+	// Baked pre-filter, answers every pair as potentially visible on maps without a grid
+	UPROPERTY()
+	TObjectPtr<UGASVisibilityGridSubsystem> GridSubsystem;
+
+	FTraceDelegate TraceDelegate;
+	float TimeUntilEviction;
+};
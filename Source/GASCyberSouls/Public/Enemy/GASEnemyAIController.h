@@ -0,0 +1,77 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "GASEnemyAIController.generated.h"
+
+class UGASFlowFieldSubsystem;
+
+// How much crowd avoidance an enemy gets, from its distance to the nearest player
+UENUM()
+enum class EGASEnemySignificance : uint8
+{
+	// Out of chase range, other agents avoid it but it does not avoid them
+	Off,
+	Low,
+	Medium,
+	High
+};
+
+/**
+ * AI controller for enemies
+ * Chases the nearest player in sight along the target's shared flow field, and with DetourCrowd path following where the pawn is off
+ * the field. Path requests are not made here directly, they are queued on the enemy navigation subsystem, which runs a limited number
+ * per frame with engaged enemies first
+ */
+UCLASS()
+class GASCYBERSOULS_API AGASEnemyAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AGASEnemyAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	void SetChaseTarget(AActor* NewTarget);
+	AActor* GetChaseTarget() const { return ChaseTarget.Get(); }
+
+	// Crowd simulation and avoidance quality for the significance, only touches the crowd agent when it changes
+	void ApplySignificance(EGASEnemySignificance NewSignificance, float AvoidanceQueryRange);
+	EGASEnemySignificance GetSignificance() const { return Significance; }
+
+	// True when the target moved far enough from the last path goal, or no path is being followed, and the last request is old enough
+	bool WantsRepath(double Now, float RepathInterval, float RepathDistance) const;
+
+	// Path query and move towards the chase target, called by the navigation subsystem within its frame budget
+	void ExecuteChaseMove(double Now);
+
+	// Movement input along the chase target's flow field, false when there is no field here and the chase needs path queries instead
+	bool SteerAlongFlowField(UGASFlowFieldSubsystem* FlowFields);
+
+	// Set while a request waits in the navigation subsystem's queue, so an enemy is only queued once
+	bool bPathRequestQueued;
+
+	// Distance at which the chase move counts as arrived
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	float ChaseAcceptanceRadius;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	TWeakObjectPtr<AActor> ChaseTarget;
+
+	// Target location when the last path was requested
+	FVector LastGoalLocation;
+	double LastPathRequestTime;
+
+	EGASEnemySignificance Significance;
+
+	// Steering along a flow field instead of following a path
+	bool bOnFlowField;
+
+	// The crowd agent keeps its defaults until the first significance update
+	bool bSignificanceApplied;
+};
@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "Character/GASCharacterBase.h"
 #include "Character/GASTypes.h"
+#include "Net/GASSharedRepMovement.h"
 #include "GASEnemyCharacter.generated.h"
 
+class UGASHitZoneComponent;
+
 /**
  * Base enemy character class for GASCyberSouls
  */
@@ -21,6 +24,9 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
+	// Removes the enemy from the world's enemy registry
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 	
@@ -56,7 +62,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Enemy")
 	void SetTargetedBodyPart(EBodyPartType NewBodyPart);
 	
+	// Leave net dormancy on damage, effects and ability activation, also the hook for AI perception
+	void WakeNetDormancy();
+	
+	// World time of the last wake-up, net activity keeps the enemy in combat for a moment after it
+	float GetLastNetWakeTime() const { return LastNetWakeTime; }
+	
+	// Body part zones slashes and attacks resolve their hits against
+	UGASHitZoneComponent* GetHitZoneComponent() const { return HitZoneComponent; }
+	
+	// Locked on, hacking, blocking or dodging; engaged enemies keep full fidelity movement on the default replication path
+	bool IsEngaged() const;
+	
+	// Called by the replication graph's fast shared path, returns false to leave this enemy to the default path
+	bool UpdateSharedReplication();
+	
+	// Quantized movement for distant connections, serialized once and shared by every connection
+	UFUNCTION(NetMulticast, Unreliable)
+	void FastSharedReplication(const FGASSharedRepMovement& SharedMovement);
+	
 protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Enemy")
+	UGASHitZoneComponent* HitZoneComponent;
+	
 	// Currently targeted body part (when player is targeting this enemy)
 	UPROPERTY(ReplicatedUsing = OnRep_TargetedBodyPart)
 	EBodyPartType TargetedBodyPart;
@@ -93,4 +121,14 @@ protected:
 	
 	// Override initialization
 	virtual void InitializeAbilitySystem() override;
+	
+private:
+	// Last movement sent on the shared path, unchanged movement reuses the previous bunch
+	FGASSharedRepMovement LastSharedMovement;
+	
+	float LastNetWakeTime;
+	
+	void OnAbilityActivated(UGameplayAbility* Ability);
+	void OnEffectApplied(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void OnIntegrityChanged(const FOnAttributeChangeData& ChangeData);
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASEnemyNavigationSubsystem.generated.h"
+
+class AGASEnemyAIController;
+
+/**
+ * Server-side navigation budget for enemy AI controllers
+ * Picks each enemy's chase target and crowd avoidance significance at a fixed interval, steers chasing enemies along their target's
+ * flow field every frame, and for enemies off the field runs queued path requests highest priority first (engaged, then close,
+ * then the rest) until the per-frame count or time budget is spent
+ * Usage: CyberSouls.AI.PathQueryTest [Count] [Seconds] spawns chasing enemies around the player on the current map and reports
+ * the path query time per frame, CyberSouls.AI.PathQueryReport reports the frames recorded so far
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASEnemyNavigationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASEnemyNavigationSubsystem();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterController(AGASEnemyAIController* Controller);
+	void UnregisterController(AGASEnemyAIController* Controller);
+
+	// Spawn enemies around the first player and log the path query report after the given time
+	void StartPathQueryTest(int32 Count, float Seconds);
+
+	// Average, 95th percentile and peak path query time per frame over the recorded frames
+	void LogPathQueryReport() const;
+
+	// Path requests run per frame at most
+	UPROPERTY(Config)
+	int32 MaxPathRequestsPerFrame;
+
+	// No new path request starts once this many milliseconds were spent in a frame
+	UPROPERTY(Config)
+	float MaxPathRequestMsPerFrame;
+
+	// Seconds between two path requests of the same enemy
+	UPROPERTY(Config)
+	float RepathInterval;
+
+	// Target movement that makes an enemy ask for a new path
+	UPROPERTY(Config)
+	float RepathDistance;
+
+	// Seconds between two significance updates
+	UPROPERTY(Config)
+	float SignificanceInterval;
+
+	// Enemies chase the nearest player within this radius, beyond it they stand and only act as crowd obstacles
+	UPROPERTY(Config)
+	float ChaseRadius;
+
+	// Player distance up to which an enemy has high and medium significance, low beyond up to the chase radius
+	UPROPERTY(Config)
+	float HighSignificanceRadius;
+
+	UPROPERTY(Config)
+	float MediumSignificanceRadius;
+
+	// Crowd neighbour query range per significance, a shorter range means fewer avoided neighbours
+	UPROPERTY(Config)
+	float HighAvoidanceQueryRange;
+
+	UPROPERTY(Config)
+	float MediumAvoidanceQueryRange;
+
+	UPROPERTY(Config)
+	float LowAvoidanceQueryRange;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPathRequest
+	{
+		TWeakObjectPtr<AGASEnemyAIController> Controller;
+
+		// Higher runs first, same priority runs in queue order
+		int32 Priority = 0;
+	};
+
+	void UpdateSignificance();
+	void SteerAlongFlowFields();
+	void QueuePathRequests(double Now);
+	void RunPathRequests(double Now);
+
+	TArray<TWeakObjectPtr<AGASEnemyAIController>> Controllers;
+	TArray<FPathRequest> PendingRequests;
+
+	// Path query time per frame, most recent frames only
+	TArray<float> PathQueryMs;
+	int32 NextPathQuerySample;
+	int32 MaxPendingRequests;
+
+	float TimeUntilSignificanceUpdate;
+
+	FTimerHandle TestTimerHandle;
+};
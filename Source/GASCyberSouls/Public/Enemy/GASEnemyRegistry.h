@@ -0,0 +1,35 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASEnemyRegistry.generated.h"
+
+class AGASEnemyCharacter;
+
+/**
+ * Flat list of the live enemies in a world
+ * Enemies add themselves on BeginPlay and remove themselves on EndPlay, so per-frame systems never need an actor iterator
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASEnemyRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGASEnemyRegistry* Get(const UObject* WorldContextObject);
+
+	void RegisterEnemy(AGASEnemyCharacter* Enemy);
+	void UnregisterEnemy(AGASEnemyCharacter* Enemy);
+
+	// Unordered, removal swaps the last enemy into the freed slot
+	const TArray<TObjectPtr<AGASEnemyCharacter>>& GetEnemies() const { return Enemies; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AGASEnemyCharacter>> Enemies;
+};
@@ -0,0 +1,114 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "GASFlowFieldSubsystem.generated.h"
+
+class ANavigationData;
+
+// Chase directions on a square grid of cells around one target, immutable once built so lookups never race the worker
+struct GASCYBERSOULS_API FGASFlowField
+{
+	// World cell of the grid corner, cells are CellSize squares aligned to the world origin
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint TargetCell = FIntPoint::ZeroValue;
+	FVector TargetLocation = FVector::ZeroVector;
+	int32 Size = 0;
+	float CellSize = 100.0f;
+
+	// The grid covers the target's floor, locations further above or below it are not on the field
+	float VerticalExtent = 250.0f;
+
+	// Neighbour towards the target per cell, InvalidDirection where the target cannot be reached
+	TArray<uint8> Directions;
+
+	// Worker time spent building this field
+	double BuildSeconds = 0.0;
+
+	static constexpr uint8 InvalidDirection = 0xFF;
+
+	// False outside the grid, off the target's floor or on a cell the target cannot be reached from
+	bool GetDirection(const FVector& Location, FVector& OutDirection) const;
+};
+
+/**
+ * Shared chase navigation for enemy crowds
+ * Builds one integration field per chased target over a navmesh-derived grid on a worker thread, so any number of enemies chasing
+ * the same target costs one field build plus a lookup each instead of a path query each. Only targets asked for within the last
+ * RequestTimeout seconds have a field, rebuilt when the target enters another cell. The navmesh is sampled on the game thread within
+ * MaxNavSamplesPerUpdate and cached per cell and height band, so a moving target only samples the newly covered strip and floors
+ * stacked over the same cells are kept apart. The worker only sees the sampled cells
+ * Usage: GetChaseDirection(Player, EnemyLocation, Direction) and fall back to a path query or a straight line when it returns false,
+ * the first request for a target only starts its field
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASFlowFieldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASFlowFieldSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// Direction along the flow field of Target at Location, O(1), and keeps the field of Target up to date
+	bool GetChaseDirection(const AActor* Target, const FVector& Location, FVector& OutDirection);
+
+	// Builds since begin play and the worker time they took
+	int32 GetNumBuilds() const { return NumBuilds; }
+	double GetTotalBuildSeconds() const { return TotalBuildSeconds; }
+
+	// Edge length of a grid cell
+	UPROPERTY(Config)
+	float CellSize;
+
+	// Cells from the target to the grid edge, the field covers (2 * HalfExtentCells + 1) squared cells
+	UPROPERTY(Config)
+	int32 HalfExtentCells;
+
+	// Height above and below the target searched for navmesh under a cell
+	UPROPERTY(Config)
+	float VerticalExtent;
+
+	// Seconds between two checks of the targets
+	UPROPERTY(Config)
+	float UpdateInterval;
+
+	// Seconds without a GetChaseDirection call after which a target's field and its cached samples are dropped
+	UPROPERTY(Config)
+	float RequestTimeout;
+
+	// Navmesh samples per update across all targets, the rest of a grid is sampled in the following updates
+	UPROPERTY(Config)
+	int32 MaxNavSamplesPerUpdate;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FTargetField
+	{
+		TSharedPtr<const FGASFlowField> Field;
+
+		// Navmesh walkability per world cell and height band, game thread only
+		TMap<FIntVector, bool> WalkableCells;
+
+		UE::Tasks::TTask<TSharedPtr<const FGASFlowField>> BuildTask;
+		bool bBuilding = false;
+
+		double LastRequestTime = 0.0;
+	};
+
+	void UpdateFields();
+	void UpdateTarget(const AActor* Target, FTargetField& TargetField, const ANavigationData* NavData, int32& SampleBudget);
+
+	TMap<TWeakObjectPtr<const AActor>, FTargetField> TargetFields;
+
+	int32 NumBuilds;
+	double TotalBuildSeconds;
+
+	FTimerHandle UpdateTimerHandle;
+};
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "Profiling/GASCombatEventLog.h"
+#include "Profiling/GASCombatTrace.h"
 #include "GASGameplayAbility.generated.h"
 
 /**
@@ -27,4 +29,20 @@ public:
 
 	// Called when the ability is activated
 	virtual void OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
-};
\ No newline at end of file
+
+	// Records the activation in the combat event log and Insights trace
+	virtual void PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate, const FGameplayEventData* TriggerEventData = nullptr) override;
+
+	// Traces the commit for Insights
+	virtual bool CommitAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) override;
+
+	// Records the end in the combat event log
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+
+protected:
+	// Identifies this ability in the combat event log
+	EGASCombatAbility CombatEventAbility;
+
+	// Record a combat event from this ability's avatar
+	void RecordCombatEvent(EGASCombatOutcome Outcome, const AActor* Target = nullptr, EBodyPartType BodyPart = EBodyPartType::None, float Magnitude = 0.0f) const;
+};
@@ -5,14 +5,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
 #include "Character/GASTypes.h"
+#include "Game/GASEnemyOverlay.h"
+#include "Game/GASFloatingCombatText.h"
 #include "GASCyberSoulsHUD.generated.h"
 
 class AGASCharacterBase;
+class UGASHUDWidget;
 class UTexture2D;
 
 /**
  * Pure C++ HUD for GASCyberSouls
- * No widget blueprints required
+ * No widget blueprints required, elements live in an invalidated UGASHUDWidget and only update on change
  */
 UCLASS()
 class GASCYBERSOULS_API AGASCyberSoulsHUD : public AHUD
@@ -22,7 +25,15 @@ class GASCYBERSOULS_API AGASCyberSoulsHUD : public AHUD
 public:
 	AGASCyberSoulsHUD();
 	
-	// Called every frame to draw the HUD
+	// Creates the widget layer, registers with the owning local player and starts building the fallback textures
+	virtual void BeginPlay() override;
+	
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+	// Only ticks while a target is locked, to keep the reticle on it
+	virtual void Tick(float DeltaSeconds) override;
+	
+	// Widget elements are not drawn here, only canvas overlays such as enemy status bars and combat text
 	virtual void DrawHUD() override;
 	
 	// Update the targeting reticle
@@ -43,10 +54,14 @@ public:
 	// Show a QuickHack notification
 	void ShowQuickHackNotification(EQuickHackType QuickHackType, float Duration = 3.0f);
 	
-	// Get the instance of the HUD
-	static AGASCyberSoulsHUD* GetInstance(UWorld* World);
+	// Floating combat text on network clients, fed by replicated attribute changes since combat events are only recorded on the server
+	static void AddReplicatedCombatText(const AActor* Target, EGASCombatOutcome Outcome, float Magnitude);
 
 protected:
+	// Widget class for the HUD layer
+	UPROPERTY(EditDefaultsOnly, Category = "GAS|HUD")
+	TSubclassOf<UGASHUDWidget> HUDWidgetClass;
+	
 	// Textures for the HUD elements
 	UPROPERTY(EditDefaultsOnly, Category = "GAS|HUD|Textures")
 	UTexture2D* ReticleTexture;
@@ -63,16 +78,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "GAS|HUD|Textures")
 	UTexture2D* RightLegTexture;
 	
-	// Default textures for fallback
+	// Default textures for fallback, built once in the background
+	UPROPERTY(Transient)
 	UTexture2D* DefaultReticleTexture;
+	
+	UPROPERTY(Transient)
 	UTexture2D* DefaultBodyPartTexture;
 	
+	// The widget layer
+	UPROPERTY(Transient)
+	UGASHUDWidget* HUDWidget;
+	
 	// Current state
 	bool bTargetingReticleVisible;
 	bool bHackProgressVisible;
-	bool bQuickHackNotificationVisible;
 	
-	AGASCharacterBase* CurrentTarget;
+	TWeakObjectPtr<AGASCharacterBase> CurrentTarget;
 	EBodyPartType CurrentTargetedBodyPart;
 	
 	float HackProgressValue;
@@ -81,29 +102,31 @@ protected:
 	float IntegrityValue;
 	float MaxIntegrityValue;
 	
-	FString QuickHackNotificationText;
 	FLinearColor QuickHackNotificationColor;
 	
+	// Batched status bars over nearby enemies
+	FGASEnemyOverlay EnemyOverlay;
+	
+	// Pooled floating numbers for combat events involving the owning player
+	FGASFloatingCombatText FloatingCombatText;
+	FDelegateHandle CombatEventHandle;
+	
 	// Timer handle for notifications
 	FTimerHandle QuickHackNotificationTimer;
 	
 	// Hide the notification
 	void HideQuickHackNotification();
 	
-	// Helper functions to draw HUD elements
-	void DrawTargetingReticle();
-	void DrawBodyPartIndicators();
-	void DrawHackProgressBar();
-	void DrawIntegrityBar();
-	void DrawQuickHackNotification();
+	// Keep the reticle over the current target
+	void UpdateReticlePosition();
 	
-	// Helper to draw a progress bar
-	void DrawProgressBar(float X, float Y, float Width, float Height, float Progress, 
-	                     const FLinearColor& Color, const FString& Text);
+	// Feed combat events that involve the owning pawn to the floating combat text, standalone and listen servers only
+	void OnCombatEventRecorded(const FGASCombatEvent& Event, const AActor* Source, const AActor* Target);
 	
-	// Helper to create default textures if needed
-	void EnsureDefaultTextures();
+	// Generate the fallback pixels on a worker thread, textures are created back on the game thread
+	void BuildDefaultTexturesAsync();
+	void OnDefaultTexturesBuilt(TArray<uint8>&& ReticlePixels, TArray<uint8>&& BodyPartPixels);
 	
-	// Static instance for easy access
-	static AGASCyberSoulsHUD* Instance;
+	// Push the configured or fallback textures to the widget
+	void ApplyTextures();
 };
\ No newline at end of file
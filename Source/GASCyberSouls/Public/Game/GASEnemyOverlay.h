@@ -0,0 +1,54 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CanvasItem.h"
+
+class AActor;
+class AGASEnemyCharacter;
+class UCanvas;
+class UWorld;
+
+/**
+ * World-space status bars over nearby enemies, drawn by the HUD
+ * All enemies are projected with one view-projection matrix, culled, ranked and emitted as a single triangle batch
+ */
+class GASCYBERSOULS_API FGASEnemyOverlay
+{
+public:
+	FGASEnemyOverlay();
+
+	// Draw the overlay into the canvas' view, the locked target is always ranked first
+	void Draw(UCanvas* Canvas, const UWorld* World, const AActor* LockedTarget);
+
+private:
+	// One enemy that survived culling this frame
+	struct FVisibleEnemy
+	{
+		FVector2D ScreenPosition;
+		float SortKey;
+		float Alpha;
+		float IntegrityFraction;
+		uint8 BlockCharges;
+		uint8 MaxBlockCharges;
+		uint8 DodgeCharges;
+		uint8 MaxDodgeCharges;
+		bool bHacking;
+	};
+
+	// Fill VisibleEnemies from the enemy registry
+	void GatherVisibleEnemies(const UCanvas* Canvas, const UWorld* World, const AActor* LockedTarget);
+
+	// Append the quads of one status bar to the batch
+	void AddStatusBar(const FVisibleEnemy& Enemy);
+
+	// Append a solid quad to the batch
+	void AddQuad(const FVector2D& Min, const FVector2D& Max, const FLinearColor& Color);
+
+	// Scratch buffers, reused every frame so drawing does not allocate once they have grown
+	TArray<FVisibleEnemy> VisibleEnemies;
+
+	// Every bar of the frame goes into this one item, drawn with a single DrawItem call
+	FCanvasTriangleItem Batch;
+};
@@ -0,0 +1,61 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CanvasItem.h"
+#include "Profiling/GASCombatEventLog.h"
+
+class UCanvas;
+
+/**
+ * Floating combat text for hits, blocks, dodges and hack ticks, drawn by the HUD
+ * Entries live in a fixed ring that overwrites the oldest one, rapid repeats on the same target merge into one number,
+ * and every entry is drawn through the same text item so the canvas keeps them in one font batch
+ */
+class GASCYBERSOULS_API FGASFloatingCombatText
+{
+public:
+	static constexpr int32 Capacity = 64;
+
+	FGASFloatingCombatText();
+
+	// Spawn or merge an entry for the event, events without a visible outcome are ignored
+	void AddEvent(const FGASCombatEvent& Event, const AActor* Target, float Now);
+
+	// Draw every live entry into the canvas' view
+	void Draw(UCanvas* Canvas, float Now);
+
+	// Drop every live entry
+	void Clear();
+
+private:
+	struct FEntry
+	{
+		FVector WorldPosition = FVector::ZeroVector;
+		float SpawnTime = 0.0f;
+		float Value = 0.0f;
+		uint32 TargetId = 0;
+		float HorizontalOffset = 0.0f;
+		EGASCombatOutcome Outcome = EGASCombatOutcome::None;
+		bool bActive = false;
+	};
+
+	// Live entry for the same target and outcome spawned within the merge window, if any
+	FEntry* FindMergeCandidate(uint32 TargetId, EGASCombatOutcome Outcome, float Now);
+
+	// Text for a displayed number, built once per distinct value
+	const FText& GetNumberText(int32 Value);
+
+	FEntry Entries[Capacity];
+
+	// Next ring slot to hand out, wraps and overwrites the oldest entry
+	int32 NextEntry;
+
+	TMap<int32, FText> NumberTexts;
+	FText BlockedText;
+	FText DodgedText;
+
+	// Shared by every entry, only position, text and color change between draws
+	FCanvasTextItem TextItem;
+};
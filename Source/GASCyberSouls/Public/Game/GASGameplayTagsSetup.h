@@ -28,6 +28,9 @@ UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_State_FirewallBarrier);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_State_PreventHackProgress);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_State_ImmuneToQuickHacks);
 
+// Events
+UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Event_Melee_Hit);
+
 // Cooldowns
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Ability_Attack_Cooldown);
 UE_DECLARE_GAMEPLAY_TAG_EXTERN(TAG_Ability_Block_Cooldown);
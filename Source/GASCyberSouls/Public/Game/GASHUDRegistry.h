@@ -0,0 +1,35 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "GASHUDRegistry.generated.h"
+
+class AGASCyberSoulsHUD;
+
+/**
+ * Per-local-player slot for the active AGASCyberSoulsHUD
+ * Lives as long as the local player, so it survives world travel while the HUD it points at does not
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASHUDRegistry : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// HUD of the local player controlling Actor, or of the controller/pawn Actor belongs to; null for AI and remote players
+	static AGASCyberSoulsHUD* FindHUDForActor(const AActor* Actor);
+
+	// Called by the HUD on BeginPlay and EndPlay
+	void RegisterHUD(AGASCyberSoulsHUD* HUD);
+	void UnregisterHUD(AGASCyberSoulsHUD* HUD);
+
+	AGASCyberSoulsHUD* GetHUD() const { return ActiveHUD.Get(); }
+
+	virtual void Deinitialize() override;
+
+private:
+	// Weak so a HUD torn down with its world without reaching EndPlay is never returned
+	TWeakObjectPtr<AGASCyberSoulsHUD> ActiveHUD;
+};
@@ -0,0 +1,111 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Character/GASTypes.h"
+#include "GASHUDWidget.generated.h"
+
+class UCanvasPanel;
+class UImage;
+class UInvalidationBox;
+class UProgressBar;
+class UTextBlock;
+class UTexture2D;
+
+/**
+ * Widget layer of the GASCyberSouls HUD, built in C++ so no widget blueprint is required
+ * Every element sits in its own invalidation box and is only touched when its value actually changes
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASHUDWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	// Integrity bar, only repainted when the displayed percentage changes
+	void SetIntegrity(float CurrentIntegrity, float MaxIntegrity);
+
+	// Hack progress bar, only repainted when the displayed percentage changes
+	void SetHackProgress(float CurrentProgress, float MaxProgress);
+	void SetHackProgressVisible(bool bVisible);
+
+	// Targeting reticle and body part indicator
+	void SetTargetingReticleVisible(bool bVisible);
+	void SetTargetedBodyPart(EBodyPartType BodyPart);
+	void SetReticlePosition(const FVector2D& WidgetPosition);
+
+	// QuickHack notification text
+	void ShowQuickHackNotification(const FText& Text, const FLinearColor& Color);
+	void HideQuickHackNotification();
+
+	// Textures used by the reticle and body part indicators
+	void SetTextures(UTexture2D* Reticle, UTexture2D* UpperBody, UTexture2D* LowerBody, UTexture2D* LeftLeg, UTexture2D* RightLeg);
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+	// Build the widget tree the first time the widget is taken
+	void BuildWidgetTree();
+
+	// Create a bar with a centered label inside its own invalidation box
+	UInvalidationBox* CreateBar(UCanvasPanel* Root, const FVector2D& Anchor, const FVector2D& Position, TObjectPtr<UProgressBar>& OutBar, TObjectPtr<UTextBlock>& OutLabel);
+
+	// Apply the texture matching the targeted body part
+	void UpdateBodyPartImage();
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInvalidationBox> IntegrityBox;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UProgressBar> IntegrityBar;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTextBlock> IntegrityLabel;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInvalidationBox> HackBox;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UProgressBar> HackBar;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTextBlock> HackLabel;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInvalidationBox> ReticleBox;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UImage> ReticleImage;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UImage> BodyPartImage;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInvalidationBox> NotificationBox;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTextBlock> NotificationLabel;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> ReticleTexture;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> UpperBodyTexture;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> LowerBodyTexture;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> LeftLegTexture;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> RightLegTexture;
+
+	// Last displayed values, used to skip updates that would not change anything on screen
+	int32 DisplayedIntegrityPercent = INDEX_NONE;
+	int32 DisplayedHackPercent = INDEX_NONE;
+	EBodyPartType DisplayedBodyPart = EBodyPartType::None;
+	FVector2D DisplayedReticlePosition = FVector2D(-1.0f, -1.0f);
+};
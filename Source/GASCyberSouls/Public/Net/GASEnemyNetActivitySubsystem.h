@@ -0,0 +1,86 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASEnemyNetActivitySubsystem.generated.h"
+
+class AGASEnemyCharacter;
+
+// How much an enemy takes part in combat, decides its net update frequency
+UENUM()
+enum class EGASEnemyNetActivity : uint8
+{
+	// No abilities, effects or movement and no player nearby, net dormant
+	Idle,
+	// Moving or alive but away from every player
+	Background,
+	// Running abilities or effects, or close to a player
+	Combat,
+	// Locked on by a player or hacking
+	Engaged
+};
+
+/**
+ * Server-side net activity of enemies
+ * Re-evaluates every enemy at a fixed interval: idle enemies go net dormant, the rest get a net update frequency
+ * that scales with how involved in combat they are. Enemies wake themselves on ability activation, effects and damage
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASEnemyNetActivitySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASEnemyNetActivitySubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Classify the enemy and apply its dormancy and net update frequency right away
+	void UpdateEnemy(AGASEnemyCharacter* Enemy);
+
+	// Seconds between two evaluations of every enemy
+	UPROPERTY(Config)
+	float EvaluationInterval;
+
+	// A player this close keeps an idle enemy awake
+	UPROPERTY(Config)
+	float PerceptionRadius;
+
+	// A player this close counts as combat
+	UPROPERTY(Config)
+	float CombatRadius;
+
+	// Squared speed under which an enemy counts as standing still
+	UPROPERTY(Config)
+	float IdleSpeedSquared;
+
+	// Seconds an enemy stays in combat after waking from damage, an effect or an ability
+	UPROPERTY(Config)
+	float WakeLingerTime;
+
+	// Net update frequency per activity, idle enemies are net dormant instead
+	// Under the replication graph background enemies follow the grid's distance-scaled rate, so BackgroundFrequency only applies without it
+	UPROPERTY(Config)
+	float BackgroundFrequency;
+
+	UPROPERTY(Config)
+	float CombatFrequency;
+
+	UPROPERTY(Config)
+	float EngagedFrequency;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void UpdateAllEnemies();
+
+	EGASEnemyNetActivity ClassifyEnemy(const AGASEnemyCharacter* Enemy, float NearestPlayerDistanceSquared) const;
+
+	// Player pawn locations, gathered once per evaluation
+	TArray<FVector> PlayerLocations;
+
+	FTimerHandle EvaluationTimerHandle;
+};
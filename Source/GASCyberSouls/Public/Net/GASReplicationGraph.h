@@ -0,0 +1,144 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "GASReplicationGraph.generated.h"
+
+class UNetConnection;
+class UNetDriver;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_GridSpatialization2D;
+
+// How a replicated class is routed into the graph
+UENUM()
+enum class EGASRepNodeMapping : uint8
+{
+	// Not routed, never replicated through the graph
+	NotRouted,
+	// Only relevant to the owner, replicated through the owning connection's node
+	RelevantToOwner,
+	// Replicated to every connection
+	AlwaysRelevant,
+	// Grid cell lookup, never moves
+	Spatialize_Static,
+	// Grid cell lookup, re-bucketed every frame
+	Spatialize_Dynamic,
+	// Grid cell lookup, static while net dormant and dynamic while awake
+	Spatialize_Dormancy
+};
+
+/**
+ * Per-connection node for actors only the owner needs
+ * The viewer's controller, pawn, player state and the pawn's lock-on target are gathered every frame,
+ * owner-only actors routed to this connection stay in the node until they are removed
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASReplicationGraphNode_OwnerRelevant : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	// The gathered list is rebuilt every frame, routed actors are kept apart from it
+	FActorRepListRefView OwnedActors;
+};
+
+/**
+ * Project replication graph
+ * Enemies are bucketed in a 2D grid (dormant ones in the grid's static lists), players and game state are always relevant,
+ * and owner-only actors go through a per-connection node instead of being tested against every connection
+ * Moving actors replicate at a distance-scaled rate, with distant enemy movement sent quantized on the fast shared path,
+ * engaged and combat enemies leave the grid for a fixed-rate node so their tiered replication frequency applies
+ */
+UCLASS(Transient, Config = Engine)
+class GASCYBERSOULS_API UGASReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UGASReplicationGraph();
+
+	// Bound to UReplicationDriver::CreateReplicationDriverDelegate by the module, returns null to keep the default net driver path
+	static UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World);
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	// Runtime NetUpdateFrequency changes are not picked up by the graph on their own, this updates the actor and every connection's copy
+	void SetActorReplicationFrequency(AActor* Actor, float Frequency);
+
+	// Moves an awake enemy between the grid's distance-scaled node and the fixed-rate node that honours its replication frequency
+	void SetEnemyFixedRate(AActor* Enemy, bool bFixedRate);
+
+	// Grid cell size in world units
+	UPROPERTY(Config)
+	float GridCellSize;
+
+	// Lowest world X/Y the grid expects, actors below it fall into the edge cells
+	UPROPERTY(Config)
+	float SpatialBiasX;
+
+	UPROPERTY(Config)
+	float SpatialBiasY;
+
+	// Net cull distance for enemies, overrides the class default when positive
+	UPROPERTY(Config)
+	float EnemyCullDistance;
+
+	// Fraction of the cull distance beyond which enemy movement may go through the fast shared path
+	UPROPERTY(Config)
+	float FastSharedPathDistancePct;
+
+	// Fast shared path budget per connection
+	UPROPERTY(Config)
+	float FastSharedPathKBytesPerSecond;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	// Engaged and combat enemies, still culled by distance per connection but replicated at their own rate
+	UPROPERTY(Transient)
+	TObjectPtr<UReplicationGraphNode_ActorList> FixedRateEnemyNode;
+
+private:
+	EGASRepNodeMapping GetMappingPolicy(const UClass* Class);
+
+	// Owner node of the actor's connection, null until the actor has an owning connection
+	UGASReplicationGraphNode_OwnerRelevant* FindOwnerNode(const AActor* Actor) const;
+
+	// Route owner-only actors that had no connection yet, owners are usually set after the actor is added
+	void RouteOwnerOnlyActors();
+
+
+	// Routing policy of the class before any explicit override
+	EGASRepNodeMapping GetDefaultMappingPolicy(const UClass* Class) const;
+
+	// Set the class replication info from the class defaults
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool bSpatialize) const;
+
+	TClassMap<EGASRepNodeMapping> ClassRepNodePolicies;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UNetConnection>, TObjectPtr<UGASReplicationGraphNode_OwnerRelevant>> OwnerNodes;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> OwnerOnlyActorsWithoutConnection;
+
+	// Enemies currently in FixedRateEnemyNode instead of the grid
+	UPROPERTY(Transient)
+	TSet<TObjectPtr<AActor>> FixedRateEnemies;
+};
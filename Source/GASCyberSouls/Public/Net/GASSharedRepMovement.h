@@ -0,0 +1,54 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GASSharedRepMovement.generated.h"
+
+class ACharacter;
+
+/**
+ * Reduced-fidelity character movement for distant connections
+ * Whole-unit location and velocity, yaw only, serialized once and shared by every connection it is sent to
+ */
+USTRUCT()
+struct GASCYBERSOULS_API FGASSharedRepMovement
+{
+	GENERATED_BODY()
+
+	FGASSharedRepMovement();
+
+	// Capture the character's current movement, returns false when it cannot be sent on the shared path
+	bool FillForCharacter(const ACharacter* Character);
+
+	// Equal after quantization, so sub-unit jitter does not produce a new bunch
+	bool Equals(const FGASSharedRepMovement& Other) const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	UPROPERTY(Transient)
+	FVector Location;
+
+	UPROPERTY(Transient)
+	FVector Velocity;
+
+	UPROPERTY(Transient)
+	float Yaw;
+
+	UPROPERTY(Transient)
+	uint8 MovementMode;
+
+	// Server time of the move, drives linear smoothing on simulated proxies
+	UPROPERTY(Transient)
+	float TimeStamp;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGASSharedRepMovement> : public TStructOpsTypeTraitsBase2<FGASSharedRepMovement>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true
+	};
+};
@@ -0,0 +1,60 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include <atomic>
+
+/**
+ * GMalloc proxy that counts heap allocations and forwards everything to the wrapped allocator
+ * Only installed for perf runs, normal runs never pay for the extra indirection
+ */
+class GASCYBERSOULS_API FGASCountingMalloc : public FMalloc
+{
+public:
+	explicit FGASCountingMalloc(FMalloc* InInnerMalloc);
+
+	// FMalloc interface
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override;
+	virtual void Trim(bool bTrimThreadCaches) override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void MarkTLSCachesAsUsedOnCurrentThread() override;
+	virtual void MarkTLSCachesAsUnusedOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void InitializeStatsMetadata() override;
+	virtual void UpdateStats() override;
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual bool ValidateHeap() override;
+	virtual const TCHAR* GetDescriptiveName() override;
+
+	uint64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+private:
+	FMalloc* InnerMalloc;
+	std::atomic<uint64> NumAllocations;
+};
+
+/**
+ * Process-wide heap allocation counter used by the perf gauntlet and per-frame allocation reports
+ * The proxy is only installed once, on module startup, when -CyberSoulsCountAllocs or -CyberSoulsGauntlet is on the command
+ * line. It is never swapped in later in a session, while worker threads are busy allocating
+ */
+struct GASCYBERSOULS_API FGASAllocationCounter
+{
+	// Wrap GMalloc with the counting proxy when the command line asks for it, called once from StartupModule
+	static void InstallFromCommandLine();
+
+	static bool IsInstalled();
+
+	// Total allocations (Malloc and Realloc of a null pointer) since Install, 0 when not installed
+	static uint64 GetNumAllocations();
+};
@@ -0,0 +1,192 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Character/GASTypes.h"
+#include <atomic>
+
+class AActor;
+class FEvent;
+class FRunnableThread;
+class IFileHandle;
+
+// Legacy per-event UE_LOG lines on combat hot paths are stripped unless the Build.cs switch turns them back on
+#ifndef CYBERSOULS_VERBOSE_COMBAT_LOG
+#define CYBERSOULS_VERBOSE_COMBAT_LOG 0
+#endif
+
+#if CYBERSOULS_VERBOSE_COMBAT_LOG
+#define CYBERSOULS_COMBAT_LOG(Format, ...) UE_LOG(LogTemp, Display, Format, ##__VA_ARGS__)
+#else
+#define CYBERSOULS_COMBAT_LOG(Format, ...)
+#endif
+
+// Which ability produced a combat event
+enum class EGASCombatAbility : uint8
+{
+	None,
+	Attack,
+	Slash,
+	Block,
+	Dodge,
+	Hack,
+	InterruptProtocol,
+	SystemFreeze,
+	FirewallBarrier
+};
+
+// What happened in a combat event
+enum class EGASCombatOutcome : uint8
+{
+	None,
+	Activated,
+	Ended,
+	Cancelled,
+	Hit,
+	Blocked,
+	Dodged,
+	OutOfRange,
+	NoTarget,
+	HackTick,
+	HackPrevented,
+	QuickHackApplied,
+	Missed
+};
+
+/**
+ * Compact binary combat event, written as-is to the combat log file
+ */
+struct FGASCombatEvent
+{
+	// Seconds since engine start (FPlatformTime::Seconds() - GStartTime)
+	double Timestamp = 0.0;
+
+	// UObject unique ids of the source and target actors (0 when none)
+	uint32 SourceId = 0;
+	uint32 TargetId = 0;
+
+	// Damage, charge or progress amount, depending on the outcome
+	float Magnitude = 0.0f;
+
+	EGASCombatAbility Ability = EGASCombatAbility::None;
+	EBodyPartType BodyPart = EBodyPartType::None;
+	EGASCombatOutcome Outcome = EGASCombatOutcome::None;
+	uint8 Reserved = 0;
+};
+
+static_assert(sizeof(FGASCombatEvent) == 24, "FGASCombatEvent is part of the combat log file format");
+
+// Header at the start of every combat log file
+struct FGASCombatLogFileHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x4C435343; // "CSCL"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint16 Version = CurrentVersion;
+	uint16 RecordSize = sizeof(FGASCombatEvent);
+};
+
+static_assert(sizeof(FGASCombatLogFileHeader) == 8, "FGASCombatLogFileHeader is part of the combat log file format");
+
+/**
+ * Fixed-size lock-free ring of combat events
+ * Any thread may push; only the writer thread pops
+ */
+class GASCYBERSOULS_API FGASCombatEventRing
+{
+public:
+	static constexpr uint32 Capacity = 16384;
+
+	FGASCombatEventRing();
+
+	// Returns false when the ring is full and the event was dropped
+	bool TryPush(const FGASCombatEvent& Event);
+
+	// Single consumer only
+	bool TryPop(FGASCombatEvent& OutEvent);
+
+private:
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static constexpr uint32 IndexMask = Capacity - 1;
+
+	struct FSlot
+	{
+		std::atomic<uint32> Sequence;
+		FGASCombatEvent Event;
+	};
+
+	FSlot Slots[Capacity];
+
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> EnqueuePos;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> DequeuePos;
+};
+
+// Game thread listeners, e.g. floating combat text; Source and Target may be null
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FGASOnCombatEventRecorded, const FGASCombatEvent& /*Event*/, const AActor* /*Source*/, const AActor* /*Target*/);
+
+/**
+ * Binary combat event log
+ * Game code records events into the ring without formatting strings;
+ * a background thread drains them into rotating files under Saved/CombatLogs
+ */
+class GASCYBERSOULS_API FGASCombatEventLog : public FRunnable
+{
+public:
+	static FGASCombatEventLog& Get();
+
+	// Record a combat event; cheap enough for hot paths
+	static void Record(EGASCombatAbility Ability, EGASCombatOutcome Outcome, const AActor* Source, const AActor* Target,
+	                   EBodyPartType BodyPart = EBodyPartType::None, float Magnitude = 0.0f);
+
+	// Start and stop the writer thread (called by the module)
+	void StartWriter();
+	void StopWriter();
+
+	// Broadcast for every event recorded on the game thread, whether or not the file log is enabled
+	FGASOnCombatEventRecorded& OnEventRecorded() { return EventRecordedDelegate; }
+
+	// Number of events dropped because the ring was full
+	uint64 GetNumDroppedEvents() const { return NumDroppedEvents.load(std::memory_order_relaxed); }
+
+	// Directory the rotating log files are written to
+	static FString GetLogDirectory();
+
+	// Readable names used by the CSV converter
+	static const TCHAR* LexAbility(EGASCombatAbility Ability);
+	static const TCHAR* LexOutcome(EGASCombatOutcome Outcome);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	FGASCombatEventLog();
+	virtual ~FGASCombatEventLog();
+
+	// Write everything currently in the ring to disk
+	void Drain();
+
+	// Open a new log file and delete the oldest ones past the retention count
+	bool OpenNextFile();
+	void CloseFile();
+
+	FGASCombatEventRing Ring;
+
+	FGASOnCombatEventRecorded EventRecordedDelegate;
+
+	std::atomic<uint64> NumDroppedEvents;
+	std::atomic<bool> bStopRequested;
+
+	FRunnableThread* Thread;
+	FEvent* WakeEvent;
+
+	// Writer thread state
+	IFileHandle* FileHandle;
+	int64 CurrentFileBytes;
+	int32 FileSequence;
+	FString SessionStamp;
+	TArray<FGASCombatEvent> WriteBuffer;
+};
@@ -0,0 +1,26 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASCombatLogToCsvCommandlet.generated.h"
+
+/**
+ * Converts binary combat log files (Saved/CombatLogs/<name>.cslog) to CSV
+ * Usage: -run=GASCombatLogToCsv [-Input=<file or directory>] [-Output=<csv file>]
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASCombatLogToCsvCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASCombatLogToCsvCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Append the records of one log file to the CSV; returns the number of records converted or INDEX_NONE on error
+	int32 ConvertFile(const FString& InputFile, FString& OutCsv) const;
+};
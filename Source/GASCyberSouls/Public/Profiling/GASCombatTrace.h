@@ -0,0 +1,37 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+class UGameplayAbility;
+
+// Insights channel for the ability lifecycle, enable with -trace=default,CyberSoulsCombat
+UE_TRACE_CHANNEL_EXTERN(CyberSoulsCombatChannel, GASCYBERSOULS_API)
+
+// Ability lifecycle phases emitted on the CyberSoulsCombat channel
+enum class EGASAbilityTracePhase : uint8
+{
+	Activate,
+	Commit,
+	CastStart,
+	CastComplete,
+	CastInterrupt,
+	EffectApplied,
+	Cooldown,
+	End
+};
+
+/**
+ * Emits ability lifecycle events and timing regions for Unreal Insights
+ * Activate/End, cast and cooldown windows show up as regions named after the ability and its owner
+ */
+struct GASCYBERSOULS_API FGASCombatTrace
+{
+	// Emit a phase event for the ability's current spec and avatar
+	static void AbilityPhase(const UGameplayAbility* Ability, EGASAbilityTracePhase Phase, float Magnitude = 0.0f);
+
+	// Emit a cooldown event and a region lasting for the cooldown duration
+	static void Cooldown(const UGameplayAbility* Ability, float Duration);
+};
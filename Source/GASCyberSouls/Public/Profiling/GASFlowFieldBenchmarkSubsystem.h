@@ -0,0 +1,119 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASFlowFieldBenchmarkSubsystem.generated.h"
+
+class AGASEnemyCharacter;
+
+// How the benchmark steers its chasing enemies
+UENUM()
+enum class EGASChaseMode : uint8
+{
+	// One direction lookup per enemy in the player's flow field
+	FlowField,
+	// One synchronous navmesh path query per enemy every RepathInterval, the cost the flow field replaces
+	PathQuery
+};
+
+/**
+ * Headless chase navigation benchmark
+ * Spawns growing crowds of enemies that all chase the player while the player circles the spawn point, and records the game
+ * thread time spent steering them per frame, first with the flow field then with per-enemy path queries, plus the flow field
+ * build time on the worker. The map needs a navmesh around the first player start
+ * Usage: UnrealEditor GASCyberSouls.uproject <Map> -game -nullrhi -unattended -nosound -CyberSoulsFlowFieldBench [-csvCategories=CyberSouls]
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASFlowFieldBenchmarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASFlowFieldBenchmarkSubsystem();
+
+	// Only created for game worlds when -CyberSoulsFlowFieldBench is on the command line
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Crowd sizes, measured in this order, each stage adds enemies to the previous one
+	UPROPERTY(Config)
+	TArray<int32> EnemyCounts;
+
+	// Also measure per-enemy path queries at every crowd size
+	UPROPERTY(Config)
+	bool bComparePathQueries;
+
+	// Seconds between two path queries of the same enemy, queries are spread evenly over the crowd
+	UPROPERTY(Config)
+	float RepathInterval;
+
+	// Enemies spawn on a ring of this radius around the first player start
+	UPROPERTY(Config)
+	float SpawnRadius;
+
+	// The player walks a circle of this radius around the first player start
+	UPROPERTY(Config)
+	float TargetOrbitRadius;
+
+	UPROPERTY(Config)
+	float StageWarmupTime;
+
+	UPROPERTY(Config)
+	float StageMeasureTime;
+
+	// The run fails when the average flow field steering time per frame at any crowd size is above this, 0 disables the check
+	UPROPERTY(Config)
+	float MaxAverageFlowFieldMs;
+
+private:
+	struct FStageResult
+	{
+		int32 NumEnemies = 0;
+		EGASChaseMode Mode = EGASChaseMode::FlowField;
+		TArray<float> SteeringMs;
+		int32 NumPathQueries = 0;
+		int32 NumFieldBuilds = 0;
+		double FieldBuildSeconds = 0.0;
+	};
+
+	void StartNextStage();
+	void StartMeasuring();
+	void FinishStage();
+
+	// Write the per-stage results to Saved/FlowFieldBenchmark and return false when a budget is exceeded
+	bool ReportResults() const;
+
+	void SpawnEnemies(int32 Count);
+
+	// Steers every enemy towards the player before actors tick, timed as the pathing cost of the frame
+	void OnWorldPreActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void SteerWithFlowField(const APawn* Target);
+	void SteerWithPathQueries(const APawn* Target);
+
+	UPROPERTY()
+	TArray<TObjectPtr<AGASEnemyCharacter>> SpawnedEnemies;
+
+	// Last queried path and the next point on it per enemy, indices match SpawnedEnemies
+	TArray<TArray<FVector>> EnemyPaths;
+	TArray<int32> EnemyPathPoints;
+	int32 NextRepathEnemy;
+	float PathQueryBudget;
+
+	TArray<FStageResult> Results;
+	int32 StageIndex;
+	bool bMeasuring;
+	FRandomStream Random;
+	FVector SpawnOrigin;
+	float OrbitAngle;
+	int32 BuildsAtStageStart;
+	double BuildSecondsAtStageStart;
+
+	FTimerHandle StageTimerHandle;
+	FDelegateHandle PreActorTickHandle;
+};
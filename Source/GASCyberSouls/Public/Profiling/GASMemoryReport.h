@@ -0,0 +1,51 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+class UWorld;
+
+// Low Level Memory tracker tags, nested under CyberSouls in -llm captures and Insights memory traces
+LLM_DECLARE_TAG_API(CyberSouls, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_Abilities, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_Effects, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_Attributes, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_Targeting, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_HUD, GASCYBERSOULS_API);
+LLM_DECLARE_TAG_API(CyberSouls_Enemies, GASCYBERSOULS_API);
+
+// Objects of one archetype within a report category
+struct FGASMemoryReportRow
+{
+	FString Category;
+	FString Archetype;
+	int32 NumObjects = 0;
+	int64 NumBytes = 0;
+
+	int64 GetAverageBytes() const { return NumObjects > 0 ? NumBytes / NumObjects : 0; }
+};
+
+/**
+ * UObject counts and memory footprint of the module's objects in a world, by category and archetype
+ * Enemies are reported per enemy type including everything they own: components, ability instances, attribute sets and an
+ * estimate for their active gameplay effects. Sizes are the serialized memory count of obj list's Max column plus the exclusive
+ * resource size
+ * Usage: CyberSouls.Memory.Report [Csv] logs the report and optionally writes it to Saved/MemoryReports, works in -nullrhi
+ * and dedicated server runs through -ExecCmds. Run with -llm -llmcsv for the CyberSouls LLM tag totals
+ */
+struct GASCYBERSOULS_API FGASMemoryReport
+{
+	static FGASMemoryReport Gather(const UWorld* World);
+
+	void Log() const;
+
+	// Write the rows to Saved/MemoryReports and return the file path
+	FString SaveCsv() const;
+
+	// Largest average footprint of one enemy type, in bytes
+	int64 GetMaxEnemyFootprint() const;
+
+	TArray<FGASMemoryReportRow> Rows;
+};
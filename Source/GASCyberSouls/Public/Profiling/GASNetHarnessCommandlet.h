@@ -0,0 +1,32 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASNetHarnessCommandlet.generated.h"
+
+/**
+ * Local multi-client network harness
+ * Launches a headless dedicated server running the replication benchmark, waits until it reports ready, launches N headless
+ * clients on this machine, waits for the server to finish and prints its bandwidth report. Returns the server's exit code
+ * (1 when over budget), or 2 when the server never got ready or a client dropped out
+ * Usage: -run=GASNetHarness -Map=<map> [-Clients=8] [-Port=7777] [-Timeout=600] [-ServerStartTimeout=300] [-Executable=<server/client binary>] [-ServerArgs="..."] [-ClientArgs="..."]
+ */
+UCLASS()
+class GASCYBERSOULS_API UGASNetHarnessCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASNetHarnessCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Launch a hidden child process of the harness executable
+	static FProcHandle Launch(const FString& Executable, const FString& Args);
+
+	// Stop and release every client that is still running
+	static void StopClients(TArray<FProcHandle>& Clients);
+};
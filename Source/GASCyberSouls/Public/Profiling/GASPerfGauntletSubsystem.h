@@ -0,0 +1,134 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Character/GASTypes.h"
+#include "GASPerfGauntletSubsystem.generated.h"
+
+class AGASEnemyCharacter;
+class AGASPlayerCharacter;
+class UGameplayAbility;
+
+// One scripted player action in the gauntlet sequence
+UENUM()
+enum class EGASGauntletStep : uint8
+{
+	LockOn,
+	Attack,
+	Slash,
+	Dodge,
+	CycleTarget,
+	InterruptProtocol,
+	SystemFreeze,
+	FirewallBarrier,
+	EnemyRound
+};
+
+/**
+ * Headless scripted-fight performance gauntlet
+ * Spawns a fixed enemy mix, drives the player through a scripted combat sequence and fails the run when budgets are exceeded
+ * Usage: UnrealEditor GASCyberSouls.uproject <Map> -game -nullrhi -unattended -nosound -CyberSoulsGauntlet [-csvCategories=CyberSouls]
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASPerfGauntletSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASPerfGauntletSubsystem();
+
+	// Only created for game worlds when -CyberSoulsGauntlet is on the command line
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// Number of enemies spawned per archetype
+	UPROPERTY(Config)
+	TMap<EEnemyType, int32> EnemyMix;
+
+	// Enemy class to spawn, defaults to AGASEnemyCharacter
+	UPROPERTY(Config)
+	TSoftClassPtr<AGASEnemyCharacter> EnemyClass;
+
+	// Scripted player sequence, repeated Iterations times
+	UPROPERTY(Config)
+	TArray<EGASGauntletStep> Sequence;
+
+	UPROPERTY(Config)
+	int32 Iterations;
+
+	// Seconds between two steps of the sequence
+	UPROPERTY(Config)
+	float StepInterval;
+
+	// Seconds after spawning before measuring starts
+	UPROPERTY(Config)
+	float WarmupTime;
+
+	// Budgets, the run fails when any of them is exceeded
+	UPROPERTY(Config)
+	float MaxAverageGameThreadMs;
+
+	UPROPERTY(Config)
+	float MaxPeakGameThreadMs;
+
+	UPROPERTY(Config)
+	float MaxGCMs;
+
+	UPROPERTY(Config)
+	float MaxAverageAllocationsPerFrame;
+
+	// Average memory footprint of one enemy of any type, from the memory report taken at the end of the run
+	UPROPERTY(Config)
+	float MaxEnemyFootprintKB;
+
+private:
+	// Spawn the enemy mix in a cone in front of the player so lock-on always finds targets
+	void SpawnEnemies();
+
+	// Grant the abilities the sequence uses when the pawn blueprints did not
+	void GrantMissingAbilities(AGASPlayerCharacter* Player) const;
+	void GrantEnemyAbilities(AGASEnemyCharacter* Enemy) const;
+
+	void StartMeasuring();
+	void RunNextStep();
+	void ExecuteStep(EGASGauntletStep Step);
+	void FinishRun();
+
+	// Write the per-frame samples to Saved/PerfGauntlet and return false when a budget is exceeded
+	bool ReportResults() const;
+
+	void OnBeginFrame();
+	void OnEndFrame();
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	// Activate abilities on an actor's ASC by tag name
+	static bool ActivateByTag(AActor* Actor, const FName& TagName);
+
+	UPROPERTY()
+	TArray<TObjectPtr<AGASEnemyCharacter>> SpawnedEnemies;
+
+	bool bMeasuring;
+	int32 StepIndex;
+	FTimerHandle StepTimerHandle;
+
+	// Per-frame samples
+	TArray<float> GameThreadMs;
+	TArray<uint32> AllocationsPerFrame;
+
+	double FrameStartTime;
+	uint64 AllocationsAtFrameStart;
+
+	double GCStartTime;
+	TArray<float> GCMs;
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+};
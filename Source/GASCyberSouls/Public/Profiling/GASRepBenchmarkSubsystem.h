@@ -0,0 +1,120 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASRepBenchmarkSubsystem.generated.h"
+
+class AGASEnemyCharacter;
+
+/**
+ * Headless server replication benchmark
+ * Spawns a large enemy crowd, waits for the expected clients, then records how long the server spends replicating and how many bytes it sends each frame
+ * Server: UnrealEditor GASCyberSouls.uproject <Map> -server -unattended -CyberSoulsRepBench [-NoCyberSoulsRepGraph] [-csvCategories=CyberSouls]
+ * Clients: UnrealEditor GASCyberSouls.uproject 127.0.0.1 -game -nullrhi -unattended -nosound (one process per client)
+ * -run=GASNetHarness launches the server and the clients in one go and prints the report
+ * Compare push model against polling by adding -ini:Engine:[SystemSettings]:net.IsPushModelEnabled=0 to the server
+ */
+UCLASS(Config = Game)
+class GASCYBERSOULS_API UGASRepBenchmarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGASRepBenchmarkSubsystem();
+
+	// Only created for game worlds when -CyberSoulsRepBench is on the command line
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	UPROPERTY(Config)
+	int32 EnemyCount;
+
+	// Measuring starts once this many clients are connected
+	UPROPERTY(Config)
+	int32 ExpectedClients;
+
+	// Seconds to wait for the clients before giving up
+	UPROPERTY(Config)
+	float ConnectTimeout;
+
+	// Enemies are laid out on a square grid of this half extent around the first player start
+	UPROPERTY(Config)
+	float SpawnHalfExtent;
+
+	// Fraction of the enemies that keep walking, the rest stand idle
+	UPROPERTY(Config)
+	float MovingFraction;
+
+	// Fraction of the enemies whose targeted body part changes every second, mimics sparse gameplay state changes
+	UPROPERTY(Config)
+	float ChangingFraction;
+
+	UPROPERTY(Config)
+	float WarmupTime;
+
+	UPROPERTY(Config)
+	float MeasureTime;
+
+	// The run fails when the average replication time per frame is above this, 0 disables the check
+	UPROPERTY(Config)
+	float MaxAverageReplicationMs;
+
+	// The run fails when the bytes sent per enemy per client per second are above this, 0 disables the check
+	UPROPERTY(Config)
+	float MaxBytesPerEnemyPerSecond;
+
+private:
+	void SpawnEnemies();
+	void WaitForClients();
+	void StartMeasuring();
+	void FinishRun();
+
+	// Cycle the targeted body part and advance the hack progress of the next batch of enemies
+	void ChangeEnemyState();
+
+	// Write the per-frame samples and the report to Saved/RepBenchmark and return false when a budget is exceeded
+	bool ReportResults() const;
+
+	int32 GetNumClients() const;
+
+	// Walking enemies get their input before actors tick
+	void OnWorldPreActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* TickWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnPostTickFlush(float DeltaSeconds);
+
+	UPROPERTY()
+	TArray<TObjectPtr<AGASEnemyCharacter>> SpawnedEnemies;
+
+	// Walking direction per moving enemy, indices match the front of SpawnedEnemies
+	TArray<FVector> MoveDirections;
+	FRandomStream Random;
+	FVector SpawnOrigin;
+	int32 NextChangingEnemy;
+
+	bool bMeasuring;
+	double WaitStartTime;
+	double FlushStartTime;
+	double MeasureStartTime;
+	double MeasureEndTime;
+
+	// Per-frame samples: time from the end of actor ticks to the end of the net flush, which is dominated by ServerReplicateActors
+	TArray<float> ReplicationMs;
+	TArray<int32> NumConnectionsPerFrame;
+
+	// Net driver totals sent per frame, sampled after the net flush
+	TArray<uint32> OutBytesPerFrame;
+	TArray<uint32> OutPacketsPerFrame;
+	uint32 LastOutTotalBytes;
+	uint32 LastOutTotalPackets;
+
+	FTimerHandle WaitTimerHandle;
+	FTimerHandle ChangeTimerHandle;
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle PostTickFlushHandle;
+};
@@ -0,0 +1,63 @@
+// copyright GASCyberSouls
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// "stat CyberSouls" in game, CyberSouls category in CSV captures (-csvCategories=CyberSouls)
+DECLARE_STATS_GROUP(TEXT("CyberSouls"), STATGROUP_CyberSouls, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GASCYBERSOULS_API, CyberSouls);
+
+// Targeting
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Targets In Range"), STAT_CyberSouls_FindTargetsInRange, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Best Target"), STAT_CyberSouls_FindBestTarget, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// Abilities and attributes
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability End"), STAT_CyberSouls_AbilityEnd, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Post Gameplay Effect Execute"), STAT_CyberSouls_PostGameplayEffectExecute, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee Hit Window"), STAT_CyberSouls_MeleeHitWindow, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee Hit Resolve"), STAT_CyberSouls_MeleeHitResolve, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Zone Update"), STAT_CyberSouls_HitZoneUpdate, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Visibility Traces"), STAT_CyberSouls_VisibilityTraces, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// Networking
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Server Replicate Actors"), STAT_CyberSouls_ServerReplicateActors, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Net Activity"), STAT_CyberSouls_EnemyNetActivity, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// Navigation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flow Field Update"), STAT_CyberSouls_FlowFieldUpdate, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flow Field Build"), STAT_CyberSouls_FlowFieldBuild, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Path Requests"), STAT_CyberSouls_EnemyPathRequests, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// HUD
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Draw HUD"), STAT_CyberSouls_DrawHUD, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Overlay"), STAT_CyberSouls_EnemyOverlay, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Floating Combat Text"), STAT_CyberSouls_FloatingCombatText, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GE Applications"), STAT_CyberSouls_GEApplications, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Targets Scanned"), STAT_CyberSouls_TargetsScanned, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Abilities Activated"), STAT_CyberSouls_AbilitiesActivated, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Enemy Overlay Bars"), STAT_CyberSouls_EnemyOverlayBars, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Floating Combat Texts"), STAT_CyberSouls_FloatingCombatTexts, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Dormant Enemies"), STAT_CyberSouls_NetDormantEnemies, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement Corrections"), STAT_CyberSouls_MovementCorrections, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Requests Run"), STAT_CyberSouls_PathRequestsRun, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Melee Sweeps"), STAT_CyberSouls_MeleeSweeps, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Visibility Traces Issued"), STAT_CyberSouls_VisibilityTracesIssued, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Visibility Grid Rejects"), STAT_CyberSouls_VisibilityGridRejects, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Combat Scratch Bytes"), STAT_CyberSouls_CombatScratchBytes, STATGROUP_CyberSouls, GASCYBERSOULS_API);
+
+// Time a scope in both the stats system and the CyberSouls CSV category
+#define CYBERSOULS_SCOPED_STAT(StatName) \
+	SCOPE_CYCLE_COUNTER(STAT_CyberSouls_##StatName); \
+	CSV_SCOPED_TIMING_STAT(CyberSouls, StatName)
+
+// Add to a per-frame counter in both the stats system and the CyberSouls CSV category
+#define CYBERSOULS_INC_COUNTER(StatName, Amount) \
+	INC_DWORD_STAT_BY(STAT_CyberSouls_##StatName, Amount); \
+	CSV_CUSTOM_STAT(CyberSouls, StatName, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class GASCyberSoulsServerTarget : TargetRules
+{
+	public GASCyberSoulsServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
+		ExtraModuleNames.Add("GASCyberSouls");
+
+		// Attributes and enemy state replicate through the push model
+		bWithPushModel = true;
+
+		// HUD and debug draw are compiled out with UE_SERVER in the game module, montages still play for their hit windows
+	}
+}